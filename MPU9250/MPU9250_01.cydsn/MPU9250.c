@@ -11,7 +11,12 @@
 /* ========= Includes ========= */
 #include "MPU9250.h"
 #include "MPU9250_RegMap.h"
-#include "MPU9250_I2C.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_Shadow.h"
+#include "MPU9250_Stats.h"
+#include "MPU9250_Aux.h"
+#include "MPU9250_Mount.h"
+#include "CyLib.h"
 #include "math.h"
 #include "stdio.h"
 
@@ -28,188 +33,421 @@
     #define MPU9250_SLEEP_MASK 0x40
 #endif
 
-#ifndef MPU9250_G
-    #define MPU9250_G 9.807f
+#ifndef MPU9250_RESET_MASK
+    #define MPU9250_RESET_MASK 0x80
 #endif
 
-/* ========= VARIABLES ========= */
-float acc_scale = 0;    // Accelerometer scaling factor
-float gyro_scale = 0;   // Gyroscope scaling factor
+#ifndef MPU9250_MAG_BIT_16
+    #define MPU9250_MAG_BIT_16 0x10          // 16 bit output bit of AK8963 CNTL1
+#endif
+
+#ifndef MPU9250_MAG_DRDY
+    #define MPU9250_MAG_DRDY 0x01            // Data ready bit of AK8963 ST1
+#endif
+
+#ifndef MPU9250_MAG_HOFL
+    #define MPU9250_MAG_HOFL 0x08            // Magnetic sensor overflow bit of AK8963 ST2
+#endif
 
-void MPU9250_Start(void) {
+/* ========= VARIABLES ========= */
+// Magnetometer sensitivity adjustment (Q15) and uT (Q16.16) per LSB, for each axis
+static uint16_t mag_adj_q15[3] = {32768, 32768, 32768};
+static int32_t mag_scale_q16[3] = {
+    (32768L * MPU9250_MAG_NT_PER_LSB * 2 + 500) / 1000,
+    (32768L * MPU9250_MAG_NT_PER_LSB * 2 + 500) / 1000,
+    (32768L * MPU9250_MAG_NT_PER_LSB * 2 + 500) / 1000
+};
+
+uint8_t MPU9250_Start(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_START);
     // This function starts the MPU9250.
     
-    // Check if the I2C component has already been started,
-    // otherwise start it.
-    if (!I2C_MPU9250_Master_initVar) {
-        I2C_MPU9250_Master_Start();
-        CyDelay(10);
-    }
-    
-    // Wake up MPU9250
-    MPU9250_WakeUp();
+    // Start the bus component, if not already started
+    MPU9250_Bus_Start();
     
-    // Set up default accelerometer full scale range
-    MPU9250_SetAccFS(MPU9250_Acc_FS_2g);
+    // Check that the MPU9250 is on the bus
+    uint8_t err = MPU9250_IsConnected();
+    if (err != MPU9250_OK)
+        return err;
     
-    // Set up defaul gyroscope full scale range
-    MPU9250_SetGyroFS(MPU9250_Gyro_FS_250);
+    // Wake up MPU9250
+    err = MPU9250_WakeUp();
+    if (err != MPU9250_OK)
+        return err;
+    
+    // Apply default configuration
+    MPU9250_Config config;
+    MPU9250_GetDefaultConfig(&config);
+    err = MPU9250_ApplyConfig(&config, NULL);
+    if (err != MPU9250_OK)
+        return err;
+    
+    // Read the magnetometer sensitivity adjustment. The magnetometer is not
+    // reachable from every bus (e.g. SPI): the adjustment is then left to 1.
+    err = MPU9250_Mag_ReadAdjustment();
+    return (err == MPU9250_DEV_NOT_FOUND_ERR) ? MPU9250_OK : err;
+}
+
+void MPU9250_GetDefaultConfig(MPU9250_Config* config) {
+    config->sample_rate_divider = 4; // From 1kHz to 200 Hz sampling
+    config->gyro_dlpf = 0x03;
+    config->acc_dlpf = 0x03;
+    config->acc_fs = MPU9250_Acc_FS_2g;
+    config->gyro_fs = MPU9250_Gyro_FS_250;
+    config->int_active_low = 0;
+    config->int_open_drain = 0;
+    config->int_latch = 1;
+    config->int_clear_any_read = 0;
+    config->int_enable = MPU9250_INT_RAW_DATA;
+    config->i2c_bypass = 1;
+    config->fifo_sources = 0x00;
+}
+
+uint8_t MPU9250_ApplyConfig(const MPU9250_Config* config, uint8_t* transactions) {
+    MPU9250_STATS_API(MPU9250_STATS_API_APPLY_CONFIG);
+    // Registers are grouped in contiguous blocks, each written with a single burst.
+    // Blocks whose shadow copy already holds the new values are skipped.
+    uint8_t count = 0;
+    uint8_t err = MPU9250_OK;
+    
+    if (transactions != NULL) {
+        *transactions = 0;
+    }
     
-    // Set up sample rate divider
-    MPU9250_SetSampleRateDivider(4); // From 1kHz to 200 Hz sampling
+    // SMPLRT_DIV, CONFIG, GYRO_CONFIG, ACCEL_CONFIG, ACCEL_CONFIG_2
+    uint8_t rate[5];
+    rate[0] = config->sample_rate_divider;
+    rate[1] = config->gyro_dlpf & 0x07;
+    rate[2] = (config->gyro_fs << 3) & MPU9250_GYRO_FS_MASK;
+    rate[3] = (config->acc_fs << 3) & MPU9250_ACC_FS_MASK;
+    rate[4] = config->acc_dlpf & 0x07;
+    if (!MPU9250_Shadow_Matches(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, rate, 5)) {
+        err = MPU9250_Shadow_WriteMulti(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, rate, 5);
+        count++;
+        if (err != MPU9250_OK)
+            goto done;
+    }
     
-    // Set up gyroscope, temperature digital low pass filter
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_CONFIG_REG, 0x03);
+    // INT_PIN_CFG, INT_ENABLE
+    uint8_t interrupt[2];
+    interrupt[0] = (config->int_active_low ? 0x80 : 0x00) |
+                   (config->int_open_drain ? 0x40 : 0x00) |
+                   (config->int_latch ? 0x20 : 0x00) |
+                   (config->int_clear_any_read ? 0x10 : 0x00) |
+                   (config->i2c_bypass ? 0x02 : 0x00);
+    interrupt[1] = config->int_enable;
+    if (!MPU9250_Shadow_Matches(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, interrupt, 2)) {
+        err = MPU9250_Shadow_WriteMulti(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, interrupt, 2);
+        count++;
+        if (err != MPU9250_OK)
+            goto done;
+    }
     
-    // Set up accelerometer digital low pass filter
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_2_REG, 0x03);
+    // FIFO_EN
+    if (!MPU9250_Shadow_Matches(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, &config->fifo_sources, 1)) {
+        err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, config->fifo_sources);
+        count++;
+        if (err != MPU9250_OK)
+            goto done;
+    }
     
-    // Configure interrupt
-    MPU9250_SetInterruptActiveHigh();
-    MPU9250_SetInterruptPushPull();
-    MPU9250_HeldInterruptPin();
-    MPU9250_ClearInterruptStatusReg();
-    MPU9250_EnableI2CBypass();
+    // USER_CTRL: FIFO enable, I2C master enable (disabled in bypass mode)
+    // and the bits required by the bus interface
+    uint8_t user_ctrl = (config->fifo_sources ? 0x40 : 0x00) |
+                        (config->i2c_bypass ? 0x00 : 0x20) |
+                        MPU9250_Bus_GetBackend()->user_ctrl;
+    if (!MPU9250_Shadow_Matches(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, &user_ctrl, 1)) {
+        err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, user_ctrl);
+        count++;
+    }
     
-    MPU9250_EnableRawDataInterrupt();
-    MPU9250_DisableFifoOverflowInterrupt();
-    MPU9250_DisableWomInterrupt();
-    MPU9250_DisableFsyncInterrupt();    
+done:
+    if (transactions != NULL) {
+        *transactions = count;
+    }
+    return err;
 }
 
-void MPU9250_Sleep(void) {
+uint8_t MPU9250_Sleep(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_POWER);
     // This function sleeps the MPU9250 by entering sleep mode.
     
     // Set sleep bit in power management 1 register.
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG,  
-        ( MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG) | MPU9250_SLEEP_MASK));
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG, 
+        MPU9250_SLEEP_MASK, MPU9250_SLEEP_MASK);
 }
 
-void MPU9250_WakeUp(void) {
+uint8_t MPU9250_WakeUp(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_POWER);
     // This function wakes up the MPU9250 exiting sleep mode.
     
     // Clear sleep bit in power management 1 register.
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG,  
-        ( MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG) & ~MPU9250_SLEEP_MASK));
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG, 
+        MPU9250_SLEEP_MASK, 0x00);
+}
+
+uint8_t MPU9250_Reset(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_POWER);
+    // This function resets all the registers of the MPU9250.
+    
+    // Set reset bit in power management 1 register. This also
+    // invalidates the shadow copy of the registers.
+    uint8_t err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_PWR_MGMT_1_REG, MPU9250_RESET_MASK);
+    if (err != MPU9250_OK)
+        return err;
+    
+    // Wait for the device to come out of reset
+    CyDelay(100);
+    return MPU9250_OK;
 }
 
 uint8_t MPU9250_IsConnected(void) {
-    // Checks if the MPU9250 is present on the I2C bus
-    uint8_t err = I2C_MPU9250_Master_MasterSendStart(MPU9250_I2C_ADDRESS, 0);
-    I2C_MPU9250_Master_MasterSendStop();
-    if (err > 0)
-        return 0;
-    // Then also check if the value contained in the who am i register is the expected one
-    return MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG) == MPU9250_WHO_AM_I;
+    MPU9250_STATS_API(MPU9250_STATS_API_IS_CONNECTED);
+    // Checks if the MPU9250 is present on the bus: the value contained in the
+    // who am i register must be the expected one. On the I2C bus, a missing
+    // device does not acknowledge its address and the read fails.
+    uint8_t who_am_i;
+    uint8_t err = MPU9250_ReadWhoAmI(&who_am_i);
+    if (err != MPU9250_OK)
+        return err;
+    return (who_am_i == MPU9250_WHO_AM_I) ? MPU9250_OK : MPU9250_DEV_NOT_FOUND_ERR;
 }
 
-uint8_t MPU9250_ReadWhoAmI(void) {
-    // Reads the who am i register and return the value
-    return MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG);   
+uint8_t MPU9250_ReadWhoAmI(uint8_t* data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_WHO_AM_I);
+    // Reads the who am i register
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, data, 1);   
 }
 
-uint8_t MPU9250_ReadMagWhoAmI(void) {
+uint8_t MPU9250_ReadMagWhoAmI(uint8_t* data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_WHO_AM_I);
     // Reads the who am i register of the magnetometer
-    return MPU9250_I2C_Read(AK8963_I2C_ADDRESS, 0x00);
+    return MPU9250_Bus_ReadBurst(AK8963_I2C_ADDRESS, 0x00, data, 1);
 }
 
-void MPU9250_ReadAcc(int16_t* acc) {
+uint8_t MPU9250_ReadAcc(int16_t* acc) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ACC);
     // We can read 6 consecutive bytes since the accelerometer registers are in order
     
     uint8_t temp[6];  // Temp variable to store the data
     
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, temp, 6);
-    acc[0] = (temp[0] << 8) | (temp[1] & 0xFF);
-    acc[1] = (temp[2] << 8) | (temp[3] & 0xFF);
-    acc[2] = (temp[4] << 8) | (temp[5] & 0xFF);
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, temp, 6);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_MOUNT_DECODE(acc, temp);
+    return MPU9250_OK;
 }
 
-void MPU9250_ReadAccRaw(uint8_t* acc) {
+uint8_t MPU9250_ReadAccRaw(uint8_t* acc) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ACC);
     // We can read 6 consecutive bytes since the accelerometer registers are in order
     
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, acc, 6);
+    // Read data from the bus
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, acc, 6);
 }
 
-void MPU9250_ReadGyro(int16_t* gyro) {
+uint8_t MPU9250_ReadGyro(int16_t* gyro) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_GYRO);
     // We can read 6 consecutive bytes since the gyroscope registers are in order
     
     uint8_t temp[6];  // Temp variable to store the data
     
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, temp, 6);
-    gyro[0] = (temp[0] << 8) | (temp[1] & 0xFF);
-    gyro[1] = (temp[2] << 8) | (temp[3] & 0xFF);
-    gyro[2] = (temp[4] << 8) | (temp[5] & 0xFF);
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, temp, 6);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_MOUNT_DECODE(gyro, temp);
+    return MPU9250_OK;
 }
 
-void MPU9250_ReadGyroRaw(uint8_t* gyro) {
+uint8_t MPU9250_ReadGyroRaw(uint8_t* gyro) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_GYRO);
     // We can read 6 consecutive bytes since the gyroscope registers are in order
     
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, gyro, 6);
+    // Read data from the bus
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, gyro, 6);
 }
 
-void MPU9250_ReadAccGyro(int16_t* acc, int16_t* gyro) {
+uint8_t MPU9250_ReadAccGyro(int16_t* acc, int16_t* gyro) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ACC_GYRO);
     // We can read 14 consecutive bytes since the accelerometer and
     // gyroscope registers are in order
     
     uint8_t temp[14];  // Temp variable to store the data
     
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, temp, 14);
-    acc[0]  = (temp[0] << 8) | (temp[1] & 0xFF);
-    acc[1]  = (temp[2] << 8) | (temp[3] & 0xFF);
-    acc[2]  = (temp[4] << 8) | (temp[5] & 0xFF);
-    gyro[0] = (temp[8] << 8) | (temp[9] & 0xFF);
-    gyro[1] = (temp[10] << 8) | (temp[11] & 0xFF);
-    gyro[2] = (temp[12] << 8) | (temp[13] & 0xFF);
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, temp, 14);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_MOUNT_DECODE(acc, &temp[0]);
+    MPU9250_MOUNT_DECODE(gyro, &temp[8]);
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_ReadTemp(int16_t* temp) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_TEMP);
+    
+    uint8_t data[2];  // Temp variable to store the data
+    
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_TEMP_OUT_H_REG, data, 2);
+    if (err != MPU9250_OK)
+        return err;
+    *temp = (data[0] << 8) | (data[1] & 0xFF);
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_ReadAccTempGyro(int16_t* acc, int16_t* temp, int16_t* gyro) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ACC_GYRO);
+    // The temperature registers are between the accelerometer
+    // and the gyroscope ones, read with the same burst
+    
+    uint8_t data[14];  // Temp variable to store the data
+    
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, data, 14);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_MOUNT_DECODE(acc, &data[0]);
+    *temp = (data[6] << 8) | (data[7] & 0xFF);
+    MPU9250_MOUNT_DECODE(gyro, &data[8]);
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_ReadAccGyroRaw(uint8_t* accRaw, uint8_t* gyroRaw) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ACC_GYRO);
+
+    // Read data from the bus
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, accRaw, 6);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, gyroRaw, 6);
 }
 
-void MPU9250_ReadAccGyroRaw(uint8_t* data) {
+static uint8_t MPU9250_Mag_CheckStatus(uint8_t st1, uint8_t st2) {
+    // Only new samples that did not overflow are valid
+    if (!(st1 & MPU9250_MAG_DRDY))
+        return MPU9250_MAG_NOT_READY_ERR;
+    if (st2 & MPU9250_MAG_HOFL)
+        return MPU9250_MAG_OVERFLOW_ERR;
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_ReadAll(int16_t* acc, int16_t* temp, int16_t* gyro, int16_t* mag, uint8_t* mag_status) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ALL);
+    
+    uint8_t data[MPU9250_READ_ALL_SIZE];
+    // Get RAW data
+    uint8_t err = MPU9250_ReadAllRaw(data);
+    if (err != MPU9250_OK)
+        return err;
+    
+    MPU9250_MOUNT_DECODE(acc, &data[0]);
+    *temp = (data[6] << 8) | (data[7] & 0xFF);
+    MPU9250_MOUNT_DECODE(gyro, &data[8]);
+    // EXT_SENS_DATA_00 is ST1, EXT_SENS_DATA_07 is ST2. A magnetometer
+    // sample that is not valid does not invalidate the other sensors.
+    *mag_status = MPU9250_Mag_CheckStatus(data[14], data[21]);
+    if (*mag_status == MPU9250_OK) {
+        // The AK8963 data registers are little-endian
+        mag[0]  = (data[16] << 8) | (data[15] & 0xFF);
+        mag[1]  = (data[18] << 8) | (data[17] & 0xFF);
+        mag[2]  = (data[20] << 8) | (data[19] & 0xFF);
+    }
+    return MPU9250_OK;
+}
 
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, data, 6);
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_GYRO_XOUT_H_REG, data + 6, 6);
+uint8_t MPU9250_ReadAllRaw(uint8_t* data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_ALL);
+    // ACCEL_XOUT_H to EXT_SENS_DATA_07 are in order: a single burst
+    // reads the MPU9250 data and the AK8963 data mirrored by slave 0
+    
+    // Read data from the bus
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_XOUT_H_REG, data, MPU9250_READ_ALL_SIZE);
 }
 
-void MPU9250_ReadMag(int16_t* mag) {
+uint8_t MPU9250_ReadMag(int16_t* mag) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_MAG);
     
     uint8_t temp[6];
     // Get RAW data
-   MPU9250_ReadMagRaw(temp);
+    uint8_t err = MPU9250_ReadMagRaw(temp);
+    if (err != MPU9250_OK)
+        return err;
     
-    mag[0] = (temp[0] << 8) | (temp[1] & 0xFF);
-    mag[1] = (temp[2] << 8) | (temp[3] & 0xFF);
-    mag[2] = (temp[4] << 8) | (temp[5] & 0xFF);
+    // The AK8963 data registers are little-endian
+    mag[0] = (temp[1] << 8) | (temp[0] & 0xFF);
+    mag[1] = (temp[3] << 8) | (temp[2] & 0xFF);
+    mag[2] = (temp[5] << 8) | (temp[4] & 0xFF);
+    return MPU9250_OK;
 }
 
-void MPU9250_ReadMagRaw(uint8_t* mag) {
-       
-    // Read data via I2C
-    MPU9250_I2C_ReadMulti(AK8963_I2C_ADDRESS, MPU9250_MAG_XOUT_H_REG, mag, 6);
+uint8_t MPU9250_ReadMagMicroTesla(int32_t* mag) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_MAG);
+    uint8_t temp[6];
+    // Get RAW data
+    uint8_t err = MPU9250_ReadMagRaw(temp);
+    if (err != MPU9250_OK)
+        return err;
+    
+    MPU9250_Mag_Decode(temp, mag);
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_ReadMagRaw(uint8_t* mag) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_MAG);
+    
+    uint8_t st1;
+    uint8_t temp[7];
+    // Check ST1 first: no data is read if there is no new sample
+    uint8_t err = MPU9250_Bus_ReadBurst(AK8963_I2C_ADDRESS, MPU9250_MAG_ST1, &st1, 1);
+    if (err != MPU9250_OK)
+        return err;
+    if (!(st1 & MPU9250_MAG_DRDY))
+        return MPU9250_MAG_NOT_READY_ERR;
+    
+    // Read data up to ST2, which releases the data registers for the next sample
+    err = MPU9250_Bus_ReadBurst(AK8963_I2C_ADDRESS, MPU9250_MAG_XOUT_H_REG, temp, 7);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Mag_CheckStatus(st1, temp[6]);
+    if (err != MPU9250_OK)
+        return err;
+    for (uint8_t i = 0; i < 6; i++) {
+        mag[i] = temp[i];
+    }
+    return MPU9250_OK;
 }
 
-void MPU9250_ReadSelfTestGyro(int16_t* self_test_gyro) {
+uint8_t MPU9250_ReadSelfTestGyro(int16_t* self_test_gyro) {
+    MPU9250_STATS_API(MPU9250_STATS_API_SELF_TEST);
     uint8_t temp[6];
     
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_SELF_TEST_X_GYRO_REG, temp, 6);
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_SELF_TEST_X_GYRO_REG, temp, 6);
+    if (err != MPU9250_OK)
+        return err;
     self_test_gyro[0] = ( temp[0] << 8) | ( temp[1] & 0xFF);
     self_test_gyro[1] = ( temp[1] << 8) | ( temp[3] & 0xFF);
     self_test_gyro[2] = ( temp[2] << 8) | ( temp[5] & 0xFF);
+    return MPU9250_OK;
 }
 
-void MPU9250_ReadSelfTestAcc(int16_t* self_test_acc) {
+uint8_t MPU9250_ReadSelfTestAcc(int16_t* self_test_acc) {
+    MPU9250_STATS_API(MPU9250_STATS_API_SELF_TEST);
     uint8_t temp[6];
     
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_SELF_TEST_X_ACCEL_REG, temp, 6);
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_SELF_TEST_X_ACCEL_REG, temp, 6);
+    if (err != MPU9250_OK)
+        return err;
     self_test_acc[0] = ( temp[0] << 8) | ( temp[1] & 0xFF);
     self_test_acc[1] = ( temp[1] << 8) | ( temp[3] & 0xFF);
     self_test_acc[2] = ( temp[2] << 8) | ( temp[5] & 0xFF);
+    return MPU9250_OK;
 }
 
-void MPU9250_SelfTest(float* deviation) {
+uint8_t MPU9250_SelfTest(float* deviation) {
+    MPU9250_STATS_API(MPU9250_STATS_API_SELF_TEST);
     // Perform self test of accelerometer and gyroscope according to the
     // procedure described in the application note MPU-9250 Accelerometer, Gyroscope and
     // Compass Self-Test Implementation.
@@ -221,39 +459,58 @@ void MPU9250_SelfTest(float* deviation) {
     int16_t ST_Gyro[3] = {0,0,0}; // Gyroscope values with self test enabled
     int16_t Gyro[3] = {0,0,0};    // Gyroscope values without self test enabled
     int16_t ST_Response[6];       // Self test response on acc and gyro 3 axis
+    uint8_t err;
     
     // Get current accelerometer full scale range
-    Old_Acc_FS = MPU9250_GetAccFS();
+    err = MPU9250_GetAccFS(&Old_Acc_FS);
+    if (err != MPU9250_OK)
+        return err;
     // Get current gyroscope full scale range
-    Old_Gyro_FS = MPU9250_GetGyroFS();
+    err = MPU9250_GetGyroFS(&Old_Gyro_FS);
+    if (err != MPU9250_OK)
+        return err;
     
     // Set gyroscope full scale range to 250dps
-    MPU9250_SetGyroFS(MPU9250_Gyro_FS_250);
+    err = MPU9250_SetGyroFS(MPU9250_Gyro_FS_250);
+    if (err != MPU9250_OK)
+        return err;
     // Set accelerometer full scale range to 2g
-    MPU9250_SetAccFS(MPU9250_Acc_FS_2g);
+    err = MPU9250_SetAccFS(MPU9250_Acc_FS_2g);
+    if (err != MPU9250_OK)
+        return err;
     
     // Write 0 to sample rate divider register -- no additional divider
-    MPU9250_SetSampleRateDivider(0x00);
+    err = MPU9250_SetSampleRateDivider(0x00);
+    if (err != MPU9250_OK)
+        return err;
     
     // Set gyroscope and accelerometer DLPF configuration to 1kHz Fs, 92 Hz bandwidth
     // First set up configuration register so that DLPF CFG is set to 2
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_CONFIG_REG, 0x02);
-    // Then write 00 in FChoice_b of GYRO config register
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG);
-    temp &= ~ 0x02; // Clear bits [1:0]
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, temp);
+    err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_CONFIG_REG, 0x02);
+    if (err != MPU9250_OK)
+        return err;
+    // Then write 00 in FChoice_b of GYRO config register (clear bits [1:0])
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, 0x03, 0x00);
+    if (err != MPU9250_OK)
+        return err;
     // Set accelerometer DLPF configuration
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, 0x02);
+    err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, 0x02);
+    if (err != MPU9250_OK)
+        return err;
     // Get 200 readings 
     int16_t Acc_Temp[3];
     int16_t Gyro_Temp[3];
     
     for (int reading = 0; reading < 200; reading++) {
-        MPU9250_ReadAcc(Acc_Temp);
+        err = MPU9250_ReadAcc(Acc_Temp);
+        if (err != MPU9250_OK)
+            return err;
         Acc[0] += Acc_Temp[0];
         Acc[1] += Acc_Temp[1];
         Acc[2] += Acc_Temp[2];
-        MPU9250_ReadGyro(Gyro_Temp);
+        err = MPU9250_ReadGyro(Gyro_Temp);
+        if (err != MPU9250_OK)
+            return err;
         Gyro[0] += Gyro_Temp[0];
         Gyro[1] += Gyro_Temp[1];
         Gyro[2] += Gyro_Temp[2];
@@ -263,26 +520,28 @@ void MPU9250_SelfTest(float* deviation) {
         Acc[i]  /= 200;
         Gyro[i] /= 200;
     }
-    // Enable self test gyroscope
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG);
-    // Then, set bits [7,6,5]
-    temp |= 0b11100000;
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, temp);
-    // Enable self test accelerometer
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG);
-    // Then, set bits [7,6,5]
-    temp |= 0b11100000;
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, temp);
+    // Enable self test gyroscope -- set bits [7,6,5]
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, 0b11100000, 0b11100000);
+    if (err != MPU9250_OK)
+        return err;
+    // Enable self test accelerometer -- set bits [7,6,5]
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, 0b11100000, 0b11100000);
+    if (err != MPU9250_OK)
+        return err;
     
     // Wait 20 ms so that everything is stable
     CyDelay(20);
     
     for (int reading = 0; reading < 200; reading++) {
-        MPU9250_ReadAcc(Acc_Temp);
+        err = MPU9250_ReadAcc(Acc_Temp);
+        if (err != MPU9250_OK)
+            return err;
         ST_Acc[0] += Acc_Temp[0];
         ST_Acc[1] += Acc_Temp[1];
         ST_Acc[2] += Acc_Temp[2];
-        MPU9250_ReadGyro(Gyro_Temp);
+        err = MPU9250_ReadGyro(Gyro_Temp);
+        if (err != MPU9250_OK)
+            return err;
         ST_Gyro[0] += Gyro_Temp[0];
         ST_Gyro[1] += Gyro_Temp[1];
         ST_Gyro[2] += Gyro_Temp[2];
@@ -292,25 +551,25 @@ void MPU9250_SelfTest(float* deviation) {
         ST_Acc[i]  /= 200;
         ST_Gyro[i] /= 200;
     }
-    // Disable self test gyroscope -- Read config register
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG);
-    // Clear bits [7,6,5]
-    temp &= ~0b11100000;
-    // Write new value to the register
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, temp);
-    // Disbale self test accelerometer -- Read config register
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG);
-    // Clear bits [7,6,5]
-    temp &= ~0b11100000;
-    // Write new vale to the register
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, temp);
+    // Disable self test gyroscope -- clear bits [7,6,5]
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, 0b11100000, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+    // Disable self test accelerometer -- clear bits [7,6,5]
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, 0b11100000, 0x00);
+    if (err != MPU9250_OK)
+        return err;
     
     // Wait 20 ms so that everything is stable
     CyDelay(20);
     
     // Restore full scale range values
-    MPU9250_SetAccFS(Old_Acc_FS);
-    MPU9250_SetGyroFS(Old_Gyro_FS);
+    err = MPU9250_SetAccFS(Old_Acc_FS);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_SetGyroFS(Old_Gyro_FS);
+    if (err != MPU9250_OK)
+        return err;
     
     // Compute self test responses
     ST_Response[0] = ST_Acc[0] - Acc[0];
@@ -324,8 +583,12 @@ void MPU9250_SelfTest(float* deviation) {
     int16_t ST_AccStored[3];
     int16_t ST_GyroStored[3];
     
-    MPU9250_ReadSelfTestAcc(ST_AccStored);
-    MPU9250_ReadSelfTestGyro(ST_GyroStored);
+    err = MPU9250_ReadSelfTestAcc(ST_AccStored);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_ReadSelfTestGyro(ST_GyroStored);
+    if (err != MPU9250_OK)
+        return err;
     
     // Compute factory trim
     float Factory_Trim[6];
@@ -341,302 +604,313 @@ void MPU9250_SelfTest(float* deviation) {
         deviation[i] = 100.0 * ((float) (ST_Response[i] - Acc[i])) / Factory_Trim[i] - 100;
         deviation[i+3] = 100.0 * ((float) (ST_Response[i] - Gyro[i+3])) / Factory_Trim[i] - 100;
     }
+    return MPU9250_OK;
 }
 
-void MPU9250_SetAccFS(MPU9250_Acc_FS fs) {
+uint8_t MPU9250_SetAccFS(MPU9250_Acc_FS fs) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Write the new full scale value in the acc conf register
    
-    // We need to first read the current bits of the register
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG);
-    // Then, we clear bits [4:3]
-    temp &= ~MPU9250_ACC_FS_MASK;
-    // Lastly, we write the new byte to the register
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, temp | ( fs << 3));
-    
-    // We also need to update the scaling factor
-    switch(fs) {
-    case MPU9250_Acc_FS_2g:
-        acc_scale = MPU9250_G * 2.0f/pow(2,16)/2;
-        break;
-    case MPU9250_Acc_FS_4g:
-        acc_scale = MPU9250_G * 4.0f/pow(2,16)/2;
-        break;
-    case MPU9250_Acc_FS_8g:
-        acc_scale = MPU9250_G * 8.0f/pow(2,16)/2;
-        break;
-    case MPU9250_Acc_FS_16g:
-        acc_scale = MPU9250_G * 16.0f/pow(2,16)/2;
-        break;
-        
-    }
+    // Update bits [4:3], the other bits are taken from the shadow register
+    // Conversion to physical units takes the full scale range (see MPU9250_Units.h)
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, 
+        MPU9250_ACC_FS_MASK, fs << 3);
 }
 
-MPU9250_Acc_FS MPU9250_GetAccFS(void) {
+uint8_t MPU9250_GetAccFS(MPU9250_Acc_FS* acc_fs) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Get the current full scale range of the accelerometer
     
-    // First, get all the register bits
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG);
+    // First, get all the register bits (no bus access if shadow is valid)
+    uint8_t temp;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_ACCEL_CONFIG_REG, &temp);
+    if (err != MPU9250_OK)
+        return err;
     // Mask all bits expect [4:3]
     temp &= MPU9250_ACC_FS_MASK;
     // Shift them by 3
-    temp = temp >> 3;
-    return temp;
+    *acc_fs = temp >> 3;
+    return MPU9250_OK;
 }
 
-void MPU9250_SetGyroFS(MPU9250_Gyro_FS fs) {
+uint8_t MPU9250_SetGyroFS(MPU9250_Gyro_FS fs) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Write the new full scale value in the gyro conf register
     
-    // We need to first read the current bits of the register
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG);
-    // Then, we clear bits [4:3]
-    temp &= ~MPU9250_GYRO_FS_MASK;
-    // Lastly, we write the new byte to the register
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, temp | ( fs << 3));
+    // Update bits [4:3], the other bits are taken from the shadow register
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, 
+        MPU9250_GYRO_FS_MASK, fs << 3);
 }
 
-MPU9250_Gyro_FS MPU9250_GetGyroFS(void) {
-    // Get the current full scale range of the accelerometer
+uint8_t MPU9250_GetGyroFS(MPU9250_Gyro_FS* gyro_fs) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Get the current full scale range of the gyroscope
     
-    // First, get all the register bits
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG);
+    // First, get all the register bits (no bus access if shadow is valid)
+    uint8_t temp;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, &temp);
+    if (err != MPU9250_OK)
+        return err;
     // Mask all bits expect [4:3]
     temp &= MPU9250_GYRO_FS_MASK;
     // Shift them by 3
-    temp = temp >> 3;
-    return temp;
+    *gyro_fs = temp >> 3;
+    return MPU9250_OK;
 }
 
-void MPU9250_SetSampleRateDivider(uint8_t smplrt) {
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, smplrt);
+uint8_t MPU9250_SetSampleRateDivider(uint8_t smplrt) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    return MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, smplrt);
 }
 
-void MPU9250_ReadAccelerometerOffset(int16_t *acc_offset) {
+uint8_t MPU9250_ReadAccelerometerOffset(int16_t *acc_offset) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Get the accelerometer offset values
     uint8_t temp[6] = {'\0'};
-    MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_XA_OFFSET_H_REG, temp, 6);
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_XA_OFFSET_H_REG, temp, 6);
+    if (err != MPU9250_OK)
+        return err;
     acc_offset[0] = (temp[0] << 8) | (temp[1] & 0xFF);
-    acc_offset[0] = (temp[2] << 8) | (temp[3] & 0xFF);
-    acc_offset[0] = (temp[4] << 8) | (temp[5] & 0xFF);
-}
-
-void MPU9250_EnableRawDataInterrupt(void) {
-    // Set bit [0] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Set bit[0]
-    temp |= 0x01;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_DisableRawDataInterrupt(void) {
-    // Clear bit [0] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[0]
-    temp &= ~0x01;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_EnableFsyncInterrupt(void) {
-    // Set bit [3] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Set bit[3]
-    temp |= 0x08;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_DisableFsyncInterrupt(void) {
-    // Clear bit [3] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[3]
-    temp &= ~0x08;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_EnableFifoOverflowInterrupt(void) {
-    // Set bit [4] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Set bit[4]
-    temp |= 0x10;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_DisableFifoOverflowInterrupt(void) {
-    // Clear bit [4] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[4]
-    temp &= ~0x10;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_EnableWomInterrupt(void) {
-    // Set bit [6] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Set bit[6]
-    temp |= 0x40;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-void MPU9250_DisableWomInterrupt(void) {
-    // Clear bit [6] of MPU9250_INT_EN_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[6]
-    temp &= ~0x40;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
-}
-
-uint8_t MPU9250_ReadInterruptStatus(void) {
-    return MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_STATUS_REG);
-}
-
-void MPU9250_SetInterruptActiveHigh(void) {
+    acc_offset[1] = (temp[2] << 8) | (temp[3] & 0xFF);
+    acc_offset[2] = (temp[4] << 8) | (temp[5] & 0xFF);
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_EnableRawDataInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [0] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x01, 0x01);
+}
+
+uint8_t MPU9250_DisableRawDataInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Clear bit [0] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x01, 0x00);
+}
+
+uint8_t MPU9250_EnableFsyncInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [3] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x08, 0x08);
+}
+
+uint8_t MPU9250_DisableFsyncInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Clear bit [3] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x08, 0x00);
+}
+
+uint8_t MPU9250_EnableFifoOverflowInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [4] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x10, 0x10);
+}
+
+uint8_t MPU9250_DisableFifoOverflowInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Clear bit [4] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x10, 0x00);
+}
+
+uint8_t MPU9250_EnableWomInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [6] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x40, 0x40);
+}
+
+uint8_t MPU9250_DisableWomInterrupt(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Clear bit [6] of MPU9250_INT_ENABLE_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, 0x40, 0x00);
+}
+
+uint8_t MPU9250_ReadInterruptStatus(uint8_t* status) {
+    MPU9250_STATS_API(MPU9250_STATS_API_READ_INT_STATUS);
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_INT_STATUS_REG, status, 1);
+}
+
+uint8_t MPU9250_SetInterruptActiveHigh(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Clear bit [7] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[7]
-    temp &= ~0x80;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x80, 0x00);
 }
 
-void MPU9250_SetInterruptActiveLow(void) {
+uint8_t MPU9250_SetInterruptActiveLow(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Set bit [7] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG);
-    // Set bit[7]
-    temp |= 0x40;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, temp);
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x80, 0x80);
 }
 
-void MPU9250_SetInterruptOpenDrain(void) {
-    // Clear bit [6] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[6]
-    temp &= ~0x40;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
+uint8_t MPU9250_SetInterruptOpenDrain(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [6] of MPU9250_INT_PIN_CFG_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x40, 0x40);
 }
 
-void MPU9250_SetInterruptPushPull(void) {
-    // Set bit [6] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG);
-    // Set bit[6]
-    temp |= 0x40;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, temp);
+uint8_t MPU9250_SetInterruptPushPull(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Clear bit [6] of MPU9250_INT_PIN_CFG_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x40, 0x00);
 }
 
-void MPU9250_HeldInterruptPin(void) {
-    // Set bit[5] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG);
-    // Set bit[5]
-    temp |= 0x20;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, temp);
+uint8_t MPU9250_HeldInterruptPin(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [5] of MPU9250_INT_PIN_CFG_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x20, 0x20);
 }
     
-void MPU9250_InterruptPinPulse(void) {
+uint8_t MPU9250_InterruptPinPulse(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Clear bit [5] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[5]
-    temp &= ~0x20;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);   
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x20, 0x00);
 }
 
-void MPU9250_ClearInterruptAny(void) {
-    // Set bit[4] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG);
-    // Set bit[4]
-    temp |= 0x10;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, temp);   
+uint8_t MPU9250_ClearInterruptAny(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [4] of MPU9250_INT_PIN_CFG_REG
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x10, 0x10);
 }
 
-void MPU9250_ClearInterruptStatusReg(void) {
+uint8_t MPU9250_ClearInterruptStatusReg(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Clear bit [4] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[4]
-    temp &= ~0x10;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);      
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x10, 0x00);
 }
 
-void MPU9250_EnableI2CBypass(void) {
+uint8_t MPU9250_EnableI2CBypass(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
     // Clear bit [5] of MPU9250_USER_CTRL_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG);
-    // Clear bit [5]
-    temp &= ~0x20;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, temp);   
-    
+    uint8_t err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, 0x20, 0x00);
+    if (err != MPU9250_OK)
+        return err;
     
     // Set bit [1] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG);
-    // Set bit[1]
-    temp |= 0x02;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, temp);
-}
-
-void MPU9250_DisableI2CBypass(void) {
-    // Set bit [5] of MPU9250_INT_ENABLE_REG
-    // Read current value
-    uint8_t temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG);
-    // Set bit [5]
-    temp |= 0x20;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, temp); 
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x02, 0x02);
+}
+
+uint8_t MPU9250_DisableI2CBypass(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_CONFIG);
+    // Set bit [5] of MPU9250_USER_CTRL_REG
+    uint8_t err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG, 0x20, 0x20);
+    if (err != MPU9250_OK)
+        return err;
     
     // Clear bit [1] of MPU9250_INT_PIN_CFG_REG
-    // Read current value
-    temp = MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG);
-    // Clear bit[1]
-    temp &= ~0x02;
-    // Write new value
-    MPU9250_I2C_Write(MPU9250_I2C_ADDRESS, MPU9250_INT_ENABLE_REG, temp);
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG, 0x02, 0x00);
 }
 
-void MPU9250_MAG_Enable(void) {
-    
-    // 0x00 = MAG off (default)
-    // 0x01 = MAG on (14-bit output)
-    // 0x02 = Continuous mode 1
-    // 0x11 = MAG on AND 16-bit output
-    MPU9250_I2C_Write(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, 0x11);
+uint8_t MPU9250_Mag_Enable(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
+    // Continuous measurements, so that new samples are latched
+    // without writing CNTL1 again
+    uint8_t err = MPU9250_Mag_SetMode(MPU9250_Mag_Mode_Cont_100Hz);
+    if (err != MPU9250_OK)
+        return err;
     
     CyDelay(10);
-    
+    return MPU9250_OK;
 }
 
-void MPU9250_MAG_Disable(void) {
+uint8_t MPU9250_Mag_Disable(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
     
-    MPU9250_I2C_Write(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, 0x00);
+    uint8_t err = MPU9250_Shadow_Write(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, 0x00);
+    if (err != MPU9250_OK)
+        return err;
     
     CyDelay(10);
-    
+    return MPU9250_OK;
+}
+
+static uint8_t MPU9250_Mag_WriteMode(MPU9250_Mag_Mode mode,
+                                     uint8_t (*write)(uint8_t address, uint8_t reg, uint8_t data)) {
+    // Mode change with either the bus (MPU9250_Shadow_Write) or the internal
+    // I2C master (MPU9250_Aux_WriteByte): both keep the shadow copy of CNTL1
+    uint8_t cntl1 = MPU9250_MAG_BIT_16 | mode;
+    if (MPU9250_Shadow_Matches(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, &cntl1, 1))
+        return MPU9250_OK;
+    
+    // Go through power down mode, then wait at least 100 us
+    uint8_t err = write(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, MPU9250_Mag_Mode_PowerDown);
+    if (err != MPU9250_OK)
+        return err;
+    if (mode == MPU9250_Mag_Mode_PowerDown)
+        return MPU9250_OK;
+    CyDelayUs(100);
+    return write(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, cntl1);
+}
+
+uint8_t MPU9250_Mag_StartMirror(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
+    uint8_t err = MPU9250_Aux_Start();
+    if (err != MPU9250_OK)
+        return err;
+
+    // Continuous measurements, so that each read gets the latest sample
+    err = MPU9250_Mag_WriteMode(MPU9250_Mag_Mode_Cont_100Hz, MPU9250_Aux_WriteByte);
+    if (err != MPU9250_OK)
+        return err;
+
+    // Slave 0 reads ST1 to ST2 at each sample. Reading ST2 also
+    // releases the data registers for the next measurement.
+    MPU9250_Aux_Read read;
+    read.address = AK8963_I2C_ADDRESS;
+    read.reg = MPU9250_MAG_ST1;
+    read.length = MPU9250_MAG_MIRROR_SIZE;
+    read.decimation = 1;
+    read.fifo = 1;
+    return MPU9250_Aux_AddRead(0, &read);
+}
+
+uint8_t MPU9250_Mag_StopMirror(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
+    // Stop slave 0 and power down the AK8963
+    uint8_t err = MPU9250_Aux_RemoveRead(0);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Mag_WriteMode(MPU9250_Mag_Mode_PowerDown, MPU9250_Aux_WriteByte);
+}
+
+uint8_t MPU9250_Mag_SetMode(MPU9250_Mag_Mode mode) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
+    return MPU9250_Mag_WriteMode(mode, MPU9250_Shadow_Write);
+}
+
+uint8_t MPU9250_Mag_ReadAdjustment(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_MAG_CONFIG);
+    uint8_t asa[3];
+    
+    // Fuse ROM access mode, then back to power down
+    uint8_t err = MPU9250_Mag_SetMode(MPU9250_Mag_Mode_FuseRom);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Bus_ReadBurst(AK8963_I2C_ADDRESS, MPU9250_MAG_ASAX_REG, asa, 3);
+    uint8_t err_mode = MPU9250_Mag_SetMode(MPU9250_Mag_Mode_PowerDown);
+    if (err != MPU9250_OK)
+        return err;
+    if (err_mode != MPU9250_OK)
+        return err_mode;
+    
+    for (uint8_t i = 0; i < 3; i++) {
+        // ((ASA - 128) / 256 + 1) in Q15 is (ASA + 128) * 128
+        mag_adj_q15[i] = (asa[i] + 128) << 7;
+        // uT per LSB in Q16.16: adjustment * 0.15 uT * 2^16 / 2^15
+        mag_scale_q16[i] = ((int32_t) mag_adj_q15[i] * MPU9250_MAG_NT_PER_LSB * 2 + 500) / 1000;
+    }
+    return MPU9250_OK;
+}
+
+void MPU9250_Mag_GetAdjustment(uint16_t* adj_q15) {
+    adj_q15[0] = mag_adj_q15[0];
+    adj_q15[1] = mag_adj_q15[1];
+    adj_q15[2] = mag_adj_q15[2];
+}
+
+void MPU9250_Mag_Decode(const uint8_t* raw, int32_t* mag) {
+    for (uint8_t i = 0; i < 3; i++) {
+        // Little-endian, at most 32760 * 14708: no overflow
+        int16_t value = (raw[2 * i + 1] << 8) | raw[2 * i];
+        mag[i] = value * mag_scale_q16[i];
+    }
 }
 /* [] END OF FILE */
@@ -13,7 +13,7 @@
     #define __MPU9250__H
     
     #include <cytypes.h>
-    #include <I2C_MPU9250_Master.h>
+    #include "MPU9250_Defs.h"
     
     
     /* ========= MACROS ========= */
@@ -51,6 +51,91 @@
     */
     #define AK8963_I2C_ADDRESS_WRITE ((AK8963_I2C_ADDRESS<<1) | 0)
     
+    /**
+    * @brief Number of AK8963 bytes mirrored in the external sensor data.
+    *
+    * AK8963 registers from ST1 to ST2: ST1, HXL, HXH, HYL, HYH, HZL, HZH, ST2.
+    * See #MPU9250_Mag_StartMirror.
+    */
+    #define MPU9250_MAG_MIRROR_SIZE 8
+    
+    /**
+    * @brief Number of bytes read by #MPU9250_ReadAllRaw.
+    *
+    * From #MPU9250_ACCEL_XOUT_H_REG to #MPU9250_EXT_SENS_DATA_07_REG.
+    */
+    #define MPU9250_READ_ALL_SIZE (14 + MPU9250_MAG_MIRROR_SIZE)
+    
+    /**
+    * @brief Magnetometer sensitivity in 16 bit output mode, in nT/LSB.
+    */
+    #define MPU9250_MAG_NT_PER_LSB 150
+    
+    /**
+    * @brief Raw sensor data ready interrupt. See #MPU9250_INT_ENABLE_REG.
+    */
+    #define MPU9250_INT_RAW_DATA 0x01
+    
+    /**
+    * @brief Fsync interrupt. See #MPU9250_INT_ENABLE_REG.
+    */
+    #define MPU9250_INT_FSYNC 0x08
+    
+    /**
+    * @brief FIFO overflow interrupt. See #MPU9250_INT_ENABLE_REG.
+    */
+    #define MPU9250_INT_FIFO_OVERFLOW 0x10
+    
+    /**
+    * @brief Wake on motion interrupt. See #MPU9250_INT_ENABLE_REG.
+    */
+    #define MPU9250_INT_WOM 0x40
+    
+    /**
+    * @brief Temperature FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_TEMP 0x80
+    
+    /**
+    * @brief Gyroscope x axis FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_GYRO_X 0x40
+    
+    /**
+    * @brief Gyroscope y axis FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_GYRO_Y 0x20
+    
+    /**
+    * @brief Gyroscope z axis FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_GYRO_Z 0x10
+    
+    /**
+    * @brief Gyroscope FIFO sources (all the axis).
+    */
+    #define MPU9250_FIFO_GYRO (MPU9250_FIFO_GYRO_X | MPU9250_FIFO_GYRO_Y | MPU9250_FIFO_GYRO_Z)
+    
+    /**
+    * @brief Accelerometer FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_ACCEL 0x08
+    
+    /**
+    * @brief External sensor data of slave 2 FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_SLV2 0x04
+    
+    /**
+    * @brief External sensor data of slave 1 FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_SLV1 0x02
+    
+    /**
+    * @brief External sensor data of slave 0 FIFO source. See #MPU9250_FIFO_EN_REG.
+    */
+    #define MPU9250_FIFO_SLV0 0x01
+    
     /* ========= TYPE DEFS ========= */
     
     /** 
@@ -81,6 +166,58 @@
         MPU9250_Gyro_FS_2000
     } MPU9250_Gyro_FS;
     
+    /** 
+     * @brief Operation modes of the magnetometer.
+     *
+     * Values of the MODE bits of #MPU9250_MAG_CNTL1_REG. The output is always 16 bit.
+    **/
+    typedef enum {
+        /** Power down **/
+        MPU9250_Mag_Mode_PowerDown = 0x00,
+        /** Single measurement, then power down **/
+        MPU9250_Mag_Mode_Single = 0x01,
+        /** Continuous measurement mode 1, 8 Hz **/
+        MPU9250_Mag_Mode_Cont_8Hz = 0x02,
+        /** Continuous measurement mode 2, 100 Hz **/
+        MPU9250_Mag_Mode_Cont_100Hz = 0x06,
+        /** Fuse ROM access **/
+        MPU9250_Mag_Mode_FuseRom = 0x0F
+    } MPU9250_Mag_Mode;
+    
+    /** 
+     * @brief Configuration of the MPU9250.
+     *
+     * This structure describes the whole configuration of the sensor. It is
+     * committed with #MPU9250_ApplyConfig, that writes the registers with the
+     * fewest possible burst writes.
+    **/
+    typedef struct {
+        /** Sample rate divider, see #MPU9250_SMPLRT_DIV_REG **/
+        uint8_t sample_rate_divider;
+        /** Gyroscope and temperature DLPF configuration (0 - 7), see #MPU9250_CONFIG_REG **/
+        uint8_t gyro_dlpf;
+        /** Accelerometer DLPF configuration (0 - 7), see #MPU9250_ACCEL_CONFIG_2_REG **/
+        uint8_t acc_dlpf;
+        /** Accelerometer full scale range **/
+        MPU9250_Acc_FS acc_fs;
+        /** Gyroscope full scale range **/
+        MPU9250_Gyro_FS gyro_fs;
+        /** Interrupt pin active low (1) or active high (0) **/
+        uint8_t int_active_low;
+        /** Interrupt pin open drain (1) or push pull (0) **/
+        uint8_t int_open_drain;
+        /** Interrupt pin held until cleared (1) or 50 us pulse (0) **/
+        uint8_t int_latch;
+        /** Interrupt status cleared on any read (1) or only on status read (0) **/
+        uint8_t int_clear_any_read;
+        /** Enabled interrupts, e.g. #MPU9250_INT_RAW_DATA **/
+        uint8_t int_enable;
+        /** I2C bypass enabled (1) or internal I2C master enabled (0) **/
+        uint8_t i2c_bypass;
+        /** FIFO sources, e.g. #MPU9250_FIFO_ACCEL. The FIFO is enabled if not 0 **/
+        uint8_t fifo_sources;
+    } MPU9250_Config;
+    
     /* ========= FUNCTIONS DECLARATIONS ========= */
     
     /**
@@ -95,6 +232,33 @@
     */
     uint8_t MPU9250_Start(void);
     
+    /**
+    * @brief Get the default configuration of the MPU9250.
+    *
+    * This function fills the configuration structure with the configuration
+    * used by #MPU9250_Start: 200 Hz sampling, DLPF set to 3, ±2g and 250 dps
+    * full scale ranges, active high push pull held interrupt pin, raw data
+    * interrupt, I2C bypass enabled and FIFO disabled.
+    * @param[out] config: default configuration.
+    */
+    void MPU9250_GetDefaultConfig(MPU9250_Config* config);
+    
+    /**
+    * @brief Apply a configuration to the MPU9250.
+    *
+    * This function writes the configuration to the MPU9250. Contiguous registers
+    * (#MPU9250_SMPLRT_DIV_REG to #MPU9250_ACCEL_CONFIG_2_REG and
+    * #MPU9250_INT_PIN_CFG_REG to #MPU9250_INT_ENABLE_REG) are written with a 
+    * single burst, and bursts that would not change the registers (according
+    * to their shadow copy) are skipped.
+    * @param[in] config: configuration to be applied.
+    * @param[out] transactions: number of I2C transactions used, can be NULL.
+    * @retval #MPU9250_OK if everything correct
+    * @retval #MPU9250_I2C_ERR if error in I2C communication
+    * @retval #MPU9250_TIMEOUT_ERR if an I2C transaction did not complete in time
+    */
+    uint8_t MPU9250_ApplyConfig(const MPU9250_Config* config, uint8_t* transactions);
+    
     /**
     * @brief Put MPU9250 in sleep mode.
     *
@@ -117,13 +281,23 @@
     */
     uint8_t MPU9250_WakeUp(void);
     
+    /**
+    * @brief Reset the MPU9250.
+    *
+    * This function resets all the internal registers of the MPU9250 to their
+    * default values, and invalidates the shadow copy of the registers.
+    * See register #MPU9250_PWR_MGMT_1_REG.
+    * @retval #MPU9250_OK if everything correct
+    * @retval #MPU9250_I2C_ERR if error in I2C communication
+    * @retval #MPU9250_UNKNOWN_ERR if unknown error occurred
+    */
+    uint8_t MPU9250_Reset(void);
+    
     /**
     * @brief Check I2C connection with MPU9250.
     *
-    * This function checks if the MPU9250 is connected on the I2C bus.
-    * @return Connection status:
-    *            - 0: Device is not connected
-    *            - > 0: Device is connected
+    * This function checks if the MPU9250 is connected on the I2C bus
+    * and if its #MPU9250_WHO_AM_I_REG register holds the expected value.
     * @retval #MPU9250_OK if device found
     * @retval #MPU9250_DEV_NOT_FOUND_ERR if device not found on the bus
     * @retval #MPU9250_I2C_ERR if error in I2C communication
@@ -154,13 +328,13 @@
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
     * @retval #MPU9250_UNKNOWN_ERR if unknown error occurred.
     */
-    uint8_t MPU9250_ReadMagWhoAmI(void);
+    uint8_t MPU9250_ReadMagWhoAmI(uint8_t* data);
     
     /**
     * @brief Read accelerometer values.
     *
     * This function reads the accelerometer values on the three
-    * axis (x, y, and z). 
+    * axis (x, y, and z), in the body axes (see MPU9250_Mount.h).
     * @param[out] acc: accelerometer values (x, y, and z).
     * @retval #MPU9250_OK if everything correct.
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
@@ -184,7 +358,7 @@
     * @brief Read gyroscope values.
     *
     * This function reads the gyroscope values on the three
-    * axis (x, y, and z). 
+    * axis (x, y, and z), in the body axes (see MPU9250_Mount.h).
     * @param[out] gyro: gyroscope values (x, y, and z).
     * @retval #MPU9250_OK if everything correct.
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
@@ -206,14 +380,17 @@
     uint8_t MPU9250_ReadGyroRaw(uint8_t* gyro);
     
     /**
-    * @brief Read magnetometer raw values.
+    * @brief Read magnetometer values.
     *
     * This function reads the magnetometer values on the three
-    * axis (x, y, and z) and returns the raw values. 
-    * @param[out] mag: magnetometer raw values (xH, xL, yH, yL, zH, zL).
+    * axis (x, y, and z), only if a new sample is ready (ST1 DRDY bit).
+    * The read always ends with ST2, so that the AK8963 can latch the
+    * next sample.
+    * @param[out] mag: magnetometer values (x, y, and z), written only with #MPU9250_OK.
     * @retval #MPU9250_OK if everything correct.
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
-    * @retval #MPU9250_UNKNOWN_ERR if unknown error occurred.
+    * @retval #MPU9250_MAG_NOT_READY_ERR if no new sample is ready.
+    * @retval #MPU9250_MAG_OVERFLOW_ERR if the sample overflowed.
     *
     */
     uint8_t MPU9250_ReadMag(int16_t* mag);
@@ -222,14 +399,29 @@
     * @brief Read magnetometer raw values.
     *
     * This function reads the magnetometer values on the three
-    * axis (x, y, and z) and returns the raw values. 
-    * @param[out] mag: magnetometer raw values (xH, xL, yH, yL, zH, zL).
+    * axis (x, y, and z) and returns the raw values, only if a new
+    * sample is ready. See #MPU9250_ReadMag.
+    * @param[out] mag: magnetometer raw values (xL, xH, yL, yH, zL, zH).
     * @retval #MPU9250_OK if everything correct.
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
-    * @retval #MPU9250_UNKNOWN_ERR if unknown error occurred.
+    * @retval #MPU9250_MAG_NOT_READY_ERR if no new sample is ready.
+    * @retval #MPU9250_MAG_OVERFLOW_ERR if the sample overflowed.
     */
     uint8_t MPU9250_ReadMagRaw(uint8_t* mag);
     
+    /**
+    * @brief Read calibrated magnetometer values.
+    *
+    * This function reads the magnetometer as #MPU9250_ReadMagRaw and
+    * decodes the values with #MPU9250_Mag_Decode.
+    * @param[out] mag: magnetic field (x, y, and z), in uT (Q16.16).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_MAG_NOT_READY_ERR if no new sample is ready.
+    * @retval #MPU9250_MAG_OVERFLOW_ERR if the sample overflowed.
+    */
+    uint8_t MPU9250_ReadMagMicroTesla(int32_t* mag);
+    
     /**
     * @brief Read temperature.
     *
@@ -241,12 +433,24 @@
     */
     uint8_t MPU9250_ReadTemp(int16_t* temp);
     
+    /**
+    * @brief Read accelerometer, temperature and gyroscope values.
+    *
+    * This function reads the three sensors with the same 14 bytes burst
+    * of #MPU9250_ReadAccGyro, so the temperature comes at no extra cost.
+    * @param[out] acc: accelerometer values (x, y, and z).
+    * @param[out] temp: temperature value.
+    * @param[out] gyro: gyroscope values (x, y, and z).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_ReadAccTempGyro(int16_t* acc, int16_t* temp, int16_t* gyro);
     
     /**
     * @brief Read accelerometer and gyroscope values.
     *
     * This function reads the accelerometer and gyroscope values on the three
-    * axis (x, y, and z). 
+    * axis (x, y, and z), in the body axes (see MPU9250_Mount.h).
     * @param[out] acc: accelerometer values (x, y, and z).
     * @param[out] gyro: gyroscope values (x, y, and z).
     * @retval #MPU9250_OK if everything correct.
@@ -268,6 +472,40 @@
     */
     uint8_t MPU9250_ReadAccGyroRaw(uint8_t* accRaw, uint8_t* gyroRaw);
     
+    /**
+    * @brief Read accelerometer, temperature, gyroscope and magnetometer values.
+    *
+    * This function reads all the sensors with a single burst of
+    * #MPU9250_READ_ALL_SIZE bytes. The magnetometer values are the ones
+    * mirrored by the internal I2C master, see #MPU9250_Mag_StartMirror.
+    * They are written only if they are a new sample, with no overflow: their
+    * status is reported in mag_status, apart from the result of the read.
+    * @param[out] acc: accelerometer values (x, y, and z).
+    * @param[out] temp: temperature value.
+    * @param[out] gyro: gyroscope values (x, y, and z).
+    * @param[out] mag: magnetometer values (x, y, and z), written only if
+    *             mag_status is #MPU9250_OK.
+    * @param[out] mag_status: #MPU9250_OK if the magnetometer values were written,
+    *             #MPU9250_MAG_NOT_READY_ERR if the sample is not new or
+    *             #MPU9250_MAG_OVERFLOW_ERR if the sample overflowed.
+    * @retval #MPU9250_OK if everything correct (accelerometer, temperature
+    *         and gyroscope values are valid).
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_ReadAll(int16_t* acc, int16_t* temp, int16_t* gyro, int16_t* mag, uint8_t* mag_status);
+    
+    /**
+    * @brief Read accelerometer, temperature, gyroscope and magnetometer raw values.
+    *
+    * This function reads #MPU9250_READ_ALL_SIZE bytes starting from
+    * #MPU9250_ACCEL_XOUT_H_REG: accelerometer, temperature and gyroscope
+    * (big-endian), followed by the AK8963 ST1, HXL to HZH (little-endian) and ST2.
+    * @param[out] data: raw values, #MPU9250_READ_ALL_SIZE bytes.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_ReadAllRaw(uint8_t* data);
+    
     /**
     * @brief Read content of accelerometer self test register.
     *
@@ -682,7 +920,8 @@
     /**
     * @brief Enable the 3-axis magnetometer
     *
-    * This function enables the built-in 3-axis magnetometer.
+    * This function enables the built-in 3-axis magnetometer in
+    * continuous measurement mode 2 (100 Hz), 16 bit output.
     *
     * @retval #MPU9250_OK if everything correct.
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
@@ -699,7 +938,77 @@
     * @retval #MPU9250_I2C_ERR if error in I2C communication.
     * @retval #MPU9250_UNKNOWN_ERR if unknown error occurred.
     */
-    void MPU9250_Mag_Disable(void);
+    uint8_t MPU9250_Mag_Disable(void);
+    
+    /**
+    * @brief Set the operation mode of the magnetometer.
+    *
+    * The magnetometer goes through power down mode before entering the new
+    * mode, as required by the AK8963. Nothing is written if the mode is
+    * already set.
+    * @param[in] mode: operation mode.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Mag_SetMode(MPU9250_Mag_Mode mode);
+    
+    /**
+    * @brief Read the sensitivity adjustment values of the magnetometer.
+    *
+    * This function reads ASAX, ASAY and ASAZ in fuse ROM access mode, then
+    * powers down the magnetometer. The adjustment (ASA - 128) / 256 + 1 of
+    * each axis is stored as a Q15 multiplier, used by #MPU9250_Mag_Decode.
+    * It is called by #MPU9250_Start; until then the adjustment is 1.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the magnetometer is not reachable from the bus.
+    */
+    uint8_t MPU9250_Mag_ReadAdjustment(void);
+    
+    /**
+    * @brief Get the sensitivity adjustment multipliers of the magnetometer.
+    *
+    * @param[out] adj_q15: multipliers of x, y and z axis (Q15, 32768 is 1).
+    */
+    void MPU9250_Mag_GetAdjustment(uint16_t* adj_q15);
+    
+    /**
+    * @brief Decode raw magnetometer values into calibrated values.
+    *
+    * This function uses integer math only: each axis is multiplied by a
+    * factor precomputed from its sensitivity adjustment and from
+    * #MPU9250_MAG_NT_PER_LSB.
+    * @param[in] raw: raw values (xL, xH, yL, yH, zL, zH).
+    * @param[out] mag: magnetic field (x, y, and z), in uT (Q16.16).
+    */
+    void MPU9250_Mag_Decode(const uint8_t* raw, int32_t* mag);
+    
+    /**
+    * @brief Mirror the magnetometer in the external sensor data registers.
+    *
+    * This function disables the I2C bypass and enables the internal I2C master,
+    * puts the AK8963 in 16 bit, 100 Hz continuous measurement mode, through
+    * power down mode as #MPU9250_Mag_SetMode, and sets
+    * slave 0 to read its ST1 to ST2 registers at each sample into
+    * #MPU9250_EXT_SENS_DATA_00_REG and the following ones. While mirrored, the
+    * AK8963 is not reachable from the bus (e.g. with #MPU9250_ReadMag).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the AK8963 does not answer the internal I2C master.
+    * @retval #MPU9250_TIMEOUT_ERR if the internal I2C master does not complete the write.
+    */
+    uint8_t MPU9250_Mag_StartMirror(void);
+    
+    /**
+    * @brief Stop mirroring the magnetometer.
+    *
+    * This function stops slave 0 and powers down the AK8963.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the AK8963 does not answer the internal I2C master.
+    * @retval #MPU9250_TIMEOUT_ERR if the internal I2C master does not complete the write.
+    */
+    uint8_t MPU9250_Mag_StopMirror(void);
     
 #endif
 
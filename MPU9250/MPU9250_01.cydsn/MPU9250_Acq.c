@@ -0,0 +1,155 @@
+/*
+ * @brief Function definitions for double-buffered acquisition.
+ *
+ * This file contains the definitions of the functions of the ping-pong
+ * acquisition path. Each frame is a non-blocking read request whose
+ * destination is the slot of the frame in the half being filled, so the
+ * bytes are moved by the I2C master component interrupt straight into
+ * the caller buffer.
+ *
+ * The slot of a frame is reserved within a critical section, and its
+ * request submitted out of it. A frame that cannot be requested is
+ * accounted as a failed one, so that its half is still handed over,
+ * with the error in its status.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Acq.h"
+#include "MPU9250.h"
+#include "MPU9250_I2C_Async.h"
+#include "CyLib.h"
+
+/* ========= VARIABLES ========= */
+static uint8_t* buffer = NULL;                   // Caller buffer
+static uint16_t frames = 0;                      // Frames of each half
+static MPU9250_Acq_Callback callback = NULL;     // Half buffer callback
+static void* context = NULL;                     // Context of the callback
+static volatile uint8_t running = 0;             // Acquisition running
+static volatile uint8_t fill_half = 0;           // Half being filled
+static volatile uint16_t fill_index = 0;         // Next frame of the half being filled
+static volatile uint16_t completed[2] = {0, 0};  // Frames read in each half
+static volatile uint8_t owned[2] = {0, 0};       // Halves owned by the application
+static volatile uint8_t status[2] = {MPU9250_OK, MPU9250_OK};  // Status of each half
+static volatile uint32_t overruns = 0;           // Dropped frames
+static volatile uint32_t errors = 0;             // Failed frames
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t* MPU9250_Acq_Half(uint8_t half) {
+    return buffer + (uint32_t) half * frames * MPU9250_ACQ_FRAME_SIZE;
+}
+
+static void MPU9250_Acq_Done(uint8_t err, void* half_context) {
+    // Completion of a frame, called from the I2C interrupt, or from
+    // MPU9250_Acq_Trigger when the frame could not be requested
+    uint8_t half = (uint8_t) (uintptr_t) half_context;
+    uint8_t full = 0;
+    uint8_t half_status;
+
+    uint8_t interruptState = CyEnterCriticalSection();
+    if (err != MPU9250_OK) {
+        errors++;
+        status[half] = err;
+    }
+    if (++completed[half] == frames) {
+        // Half full: hand it to the application
+        completed[half] = 0;
+        owned[half] = 1;
+        half_status = status[half];
+        status[half] = MPU9250_OK;
+        full = 1;
+    }
+    CyExitCriticalSection(interruptState);
+
+    if (full && (callback != NULL)) {
+        callback(MPU9250_Acq_Half(half), frames, half_status, context);
+    }
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Acq_Start(uint8_t* acq_buffer, uint16_t acq_frames, MPU9250_Acq_Callback acq_callback, void* acq_context) {
+    if (acq_buffer == NULL || acq_frames == 0)
+        return MPU9250_UNKNOWN_ERR;
+
+    uint8_t interruptState = CyEnterCriticalSection();
+    buffer = acq_buffer;
+    frames = acq_frames;
+    callback = acq_callback;
+    context = acq_context;
+    fill_half = 0;
+    fill_index = 0;
+    completed[0] = completed[1] = 0;
+    owned[0] = owned[1] = 0;
+    status[0] = status[1] = MPU9250_OK;
+    overruns = 0;
+    errors = 0;
+    running = 1;
+    CyExitCriticalSection(interruptState);
+    return MPU9250_OK;
+}
+
+void MPU9250_Acq_Stop(void) {
+    running = 0;
+}
+
+uint8_t MPU9250_Acq_Trigger(void) {
+    MPU9250_I2C_Request request;
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    if (!running) {
+        CyExitCriticalSection(interruptState);
+        return MPU9250_UNKNOWN_ERR;
+    }
+    if (owned[fill_half]) {
+        // The application is still processing this half
+        overruns++;
+        CyExitCriticalSection(interruptState);
+        return MPU9250_BUSY_ERR;
+    }
+
+    // Reserve the slot of the frame
+    request.data = MPU9250_Acq_Half(fill_half) + (uint32_t) fill_index * MPU9250_ACQ_FRAME_SIZE;
+    request.context = (void*) (uintptr_t) fill_half;
+    if (++fill_index == frames) {
+        // Swap halves
+        fill_index = 0;
+        fill_half ^= 1;
+    }
+    CyExitCriticalSection(interruptState);
+
+    request.address = MPU9250_I2C_ADDRESS;
+    request.reg = MPU9250_ACQ_FIRST_REG;
+    request.direction = MPU9250_I2C_ASYNC_READ;
+    request.count = MPU9250_ACQ_FRAME_SIZE;
+    request.callback = MPU9250_Acq_Done;
+
+    uint8_t err = MPU9250_I2C_Async_Submit(&request);
+    if (err != MPU9250_OK) {
+        // The slot is reserved: account it as a failed frame
+        interruptState = CyEnterCriticalSection();
+        overruns++;
+        CyExitCriticalSection(interruptState);
+        MPU9250_Acq_Done(err, request.context);
+    }
+    return err;
+}
+
+uint8_t MPU9250_Acq_Release(uint8_t* half) {
+    for (uint8_t i = 0; i < 2; i++) {
+        if ((buffer != NULL) && (half == MPU9250_Acq_Half(i))) {
+            owned[i] = 0;
+            return MPU9250_OK;
+        }
+    }
+    return MPU9250_UNKNOWN_ERR;
+}
+
+uint32_t MPU9250_Acq_GetOverruns(void) {
+    return overruns;
+}
+
+uint32_t MPU9250_Acq_GetErrors(void) {
+    return errors;
+}
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/** @file MPU9250_Acq.h
+ * @brief Header file for double-buffered acquisition.
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes of the ping-pong acquisition path. The caller owns a buffer
+ * split in two halves of the same number of raw frames. Each frame is
+ * read by the non-blocking I2C engine (MPU9250_I2C_Async.h) directly in
+ * its slot of the half being filled, with no intermediate copy. When a
+ * half is full, the callback is called from the completion context with
+ * the filled half and its status, and frames go to the other half. The
+ * application gives a half back with #MPU9250_Acq_Release once it is
+ * processed.
+ *
+ * A frame is the raw, big-endian content of #MPU9250_ACQ_FRAME_SIZE
+ * registers starting from #MPU9250_ACQ_FIRST_REG (accelerometer,
+ * temperature and gyroscope by default).
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_ACQ_H_
+
+    #define __MPU9250_ACQ_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief First register of a frame.
+    */
+    #ifndef MPU9250_ACQ_FIRST_REG
+        #define MPU9250_ACQ_FIRST_REG 0x3B  // MPU9250_ACCEL_XOUT_H_REG
+    #endif
+
+    /**
+    * @brief Number of bytes of a frame.
+    */
+    #ifndef MPU9250_ACQ_FRAME_SIZE
+        #define MPU9250_ACQ_FRAME_SIZE 14
+    #endif
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Half buffer callback.
+    *
+    * Function called, in interrupt context, when a half of the buffer is full.
+    * The parameters are the filled half, its number of frames, its status
+    * and the context passed to #MPU9250_Acq_Start. The status is #MPU9250_OK
+    * if all the frames were read, otherwise the error of the last failed
+    * frame (see #MPU9250_I2C_Callback, and #MPU9250_BUSY_ERR for a frame
+    * that could not be requested): the slots of failed frames keep their
+    * previous content.
+    */
+    typedef void (*MPU9250_Acq_Callback)(uint8_t* half, uint16_t frames, uint8_t status, void* context);
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Start the acquisition.
+    *
+    * @param[in] buffer: caller-owned buffer of 2 * frames * #MPU9250_ACQ_FRAME_SIZE bytes.
+    * @param[in] frames: number of frames of each half.
+    * @param[in] callback: function called when a half is full.
+    * @param[in] context: context passed to the callback.
+    * @retval #MPU9250_OK if the acquisition started.
+    * @retval #MPU9250_UNKNOWN_ERR if the parameters are not valid.
+    */
+    uint8_t MPU9250_Acq_Start(uint8_t* buffer, uint16_t frames, MPU9250_Acq_Callback callback, void* context);
+
+    /**
+    * @brief Stop the acquisition.
+    *
+    * Frames already requested are still written to the buffer.
+    */
+    void MPU9250_Acq_Stop(void);
+
+    /**
+    * @brief Request the next frame.
+    *
+    * This function is meant to be called from the data ready interrupt.
+    * Interrupts are disabled only while the slot of the frame is reserved.
+    * @retval #MPU9250_OK if the frame was requested.
+    * @retval #MPU9250_BUSY_ERR if the frame was dropped, because the half to
+    *         be filled is still owned by the application or the I2C queue is
+    *         full. In the latter case, the frame is accounted as failed.
+    * @retval #MPU9250_UNKNOWN_ERR if the acquisition is not running.
+    */
+    uint8_t MPU9250_Acq_Trigger(void);
+
+    /**
+    * @brief Give a half back to the acquisition.
+    *
+    * @param[in] half: half passed to the callback.
+    * @retval #MPU9250_OK if the half was given back.
+    * @retval #MPU9250_UNKNOWN_ERR if the pointer is not one of the two halves.
+    */
+    uint8_t MPU9250_Acq_Release(uint8_t* half);
+
+    /**
+    * @brief Get the number of dropped frames.
+    *
+    * @return Number of frames dropped since the acquisition started.
+    */
+    uint32_t MPU9250_Acq_GetOverruns(void);
+
+    /**
+    * @brief Get the number of frames whose read failed.
+    *
+    * The slots of these frames keep their previous content. Frames that
+    * could not be requested are included.
+    * @return Number of failed frames since the acquisition started.
+    */
+    uint32_t MPU9250_Acq_GetErrors(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,344 @@
+/*
+ * @brief Function definitions for orientation estimation (AHRS).
+ *
+ * This file contains the definitions of the functions of the fixed point
+ * Madgwick and Mahony filters, selected by #MPU9250_AHRS_ENGINE. Unit
+ * vectors and the quaternion are in Q2.30 format; products are computed
+ * on 64 bits and shifted back to Q2.30.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Ahrs.h"
+#include "MPU9250_Mount.h"
+#include "CyLib.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_AHRS_PI
+    #define MPU9250_AHRS_PI 3.14159265358979
+#endif
+
+// Half rotation angle per LSB at 250 dps and per us, rad (Q52).
+// Constant expression, folded by the compiler.
+#define MPU9250_AHRS_GYRO_K ((uint32_t) (250.0 * MPU9250_AHRS_PI / 180.0 / 32768.0 * 0.5 * 1e-6 * 4503599627370496.0 + 0.5))
+
+// Gain per us (Q46), from a gain in 1/s
+#define MPU9250_AHRS_GAIN_PER_US(gain) ((uint32_t) ((gain) * 70368744177664.0 * 1e-6 + 0.5))
+
+// Bias change per us and per unit of error at 250 dps, LSB (Q16) with 16 more
+// fractional bits, from an integral gain in 1/s^2
+#define MPU9250_AHRS_BIAS_PER_US(gain) \
+    ((uint32_t) ((gain) * 2e-6 * 32768.0 * 4294967296.0 / (250.0 * MPU9250_AHRS_PI / 180.0) + 0.5))
+
+// Gyroscope bias limit (Q16 LSB)
+#define MPU9250_AHRS_MAX_BIAS ((int32_t) MPU9250_AHRS_MAX_BIAS_LSB << 16)
+
+// Product of two Q2.30 values
+#define MPU9250_AHRS_MUL(a, b) ((int32_t) (((int64_t) (a) * (b)) >> 30))
+
+/* ========= VARIABLES ========= */
+
+// 2^46 / sqrt(a) at the center of [i * 2^26, (i + 1) * 2^26), i = 16 to 63
+static const uint32_t rsqrt_table[48] = {
+    2114695713, 2053387115, 1997119227, 1945237133, 1897199172, 1852552937,
+    1810917218, 1771968208, 1735428857, 1701060526, 1668656406, 1638036256,
+    1609042172, 1581535151, 1555392273, 1530504391, 1506774204, 1484114654,
+    1462447584, 1441702596, 1421816090, 1402730445, 1384393311, 1366757007,
+    1349778000, 1333416450, 1317635818, 1302402522, 1287685637, 1273456629,
+    1259689126, 1246358707, 1233442724, 1220920139, 1208771378, 1196978204,
+    1185523604, 1174391680, 1163567563, 1153037323, 1142787899, 1132807028,
+    1123083182, 1113605518, 1104363818, 1095348453, 1086550331, 1077960865
+};
+
+/* ========= STATIC FUNCTIONS ========= */
+static inline uint8_t MPU9250_Ahrs_Bits(uint64_t x) {
+    // Number of significant bits
+    uint32_t hi = (uint32_t) (x >> 32);
+    if (hi != 0)
+        return 64 - __CLZ(hi);
+    return 32 - __CLZ((uint32_t) x);
+}
+
+static uint32_t MPU9250_Ahrs_InvSqrt(uint32_t a) {
+    // 2^46 / sqrt(a), a in [2^30, 2^32): table estimate within 1.6%,
+    // two Newton iterations w = w * (3 - u * w^2) / 2 bring it below 1e-6
+    uint32_t z = rsqrt_table[(a >> 26) - 16];
+    for (uint8_t k = 0; k < 2; k++) {
+        uint64_t z2 = ((uint64_t) z * z) >> 30;
+        uint64_t uz2 = (a * z2) >> 32;
+        z = (uint32_t) (((uint64_t) z * ((3ULL << 30) - uz2)) >> 31);
+    }
+    return z;
+}
+
+static int32_t MPU9250_Ahrs_Sqrt(uint64_t x) {
+    // Square root of a Q4.60 value, in Q2.30
+    if (x < (1ULL << 30))
+        return 0;
+    uint8_t exp2 = (MPU9250_Ahrs_Bits(x) - 31) & ~1;
+    uint32_t a = (uint32_t) (x >> exp2);
+    return (int32_t) (((uint64_t) a * MPU9250_Ahrs_InvSqrt(a)) >> (46 - (exp2 >> 1)));
+}
+
+static uint8_t MPU9250_Ahrs_Normalize(int32_t* v, uint8_t n) {
+    uint32_t max = 0;
+    int32_t w[4];
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        uint32_t m = v[i] < 0 ? -(uint32_t) v[i] : (uint32_t) v[i];
+        if (m > max)
+            max = m;
+    }
+    if (max == 0)
+        return 0;
+
+    // Largest component in [2^29, 2^30): the sum of squares is in [2^58, 2^62)
+    int8_t shift = __CLZ(max) - 2;
+    uint64_t s = 0;
+    for (i = 0; i < n; i++) {
+        w[i] = shift >= 0 ? (int32_t) ((uint32_t) v[i] << shift) : v[i] >> -shift;
+        s += (uint64_t) ((int64_t) w[i] * w[i]);
+    }
+    // 2^60 / sqrt(s) from the mantissa a = s / 2^exp2, exp2 28 or 30
+    uint8_t exp2 = (MPU9250_Ahrs_Bits(s) - 31) & ~1;
+    uint32_t y = MPU9250_Ahrs_InvSqrt((uint32_t) (s >> exp2)) >> ((exp2 >> 1) - 14);
+    for (i = 0; i < n; i++) {
+        v[i] = (int32_t) (((int64_t) w[i] * y) >> 30);
+    }
+    return 1;
+}
+
+static void MPU9250_Ahrs_AlignMag(const MPU9250_Ahrs* ahrs, const int16_t* mag, int32_t* m) {
+    // AK8963 x and y are the MPU9250 y and x, z is opposite
+    int32_t s[3] = {
+        (int32_t) mag[1] * ahrs->mag_adj[1],
+        (int32_t) mag[0] * ahrs->mag_adj[0],
+        -(int32_t) mag[2] * ahrs->mag_adj[2]
+    };
+    m[0] = MPU9250_MOUNT_X_SIGN * s[MPU9250_MOUNT_X_AXIS];
+    m[1] = MPU9250_MOUNT_Y_SIGN * s[MPU9250_MOUNT_Y_AXIS];
+    m[2] = MPU9250_MOUNT_Z_SIGN * s[MPU9250_MOUNT_Z_AXIS];
+}
+
+static void MPU9250_Ahrs_Gravity(const int32_t* q, int32_t* v) {
+    // Half of the gravity direction in the body frame, Q30
+    v[0] = (int32_t) (((int64_t) q[1] * q[3] - (int64_t) q[0] * q[2]) >> 30);
+    v[1] = (int32_t) (((int64_t) q[0] * q[1] + (int64_t) q[2] * q[3]) >> 30);
+    v[2] = (int32_t) (((int64_t) q[0] * q[0] + (int64_t) q[3] * q[3]) >> 30) - MPU9250_AHRS_ONE / 2;
+}
+
+static void MPU9250_Ahrs_Field(const int32_t* q, const int32_t* m, int32_t* w, int32_t* b) {
+    int32_t q0q1 = MPU9250_AHRS_MUL(q[0], q[1]), q0q2 = MPU9250_AHRS_MUL(q[0], q[2]);
+    int32_t q0q3 = MPU9250_AHRS_MUL(q[0], q[3]), q1q1 = MPU9250_AHRS_MUL(q[1], q[1]);
+    int32_t q1q2 = MPU9250_AHRS_MUL(q[1], q[2]), q1q3 = MPU9250_AHRS_MUL(q[1], q[3]);
+    int32_t q2q2 = MPU9250_AHRS_MUL(q[2], q[2]), q2q3 = MPU9250_AHRS_MUL(q[2], q[3]);
+    int32_t q3q3 = MPU9250_AHRS_MUL(q[3], q[3]);
+    const int32_t half = MPU9250_AHRS_ONE / 2;
+
+    // Earth magnetic field h = q m q*, reference b = (bx, 0, bz)
+    int32_t hx = (int32_t) (((int64_t) m[0] * (half - q2q2 - q3q3) + (int64_t) m[1] * (q1q2 - q0q3) +
+                             (int64_t) m[2] * (q1q3 + q0q2)) >> 29);
+    int32_t hy = (int32_t) (((int64_t) m[0] * (q1q2 + q0q3) + (int64_t) m[1] * (half - q1q1 - q3q3) +
+                             (int64_t) m[2] * (q2q3 - q0q1)) >> 29);
+    b[1] = (int32_t) (((int64_t) m[0] * (q1q3 - q0q2) + (int64_t) m[1] * (q2q3 + q0q1) +
+                       (int64_t) m[2] * (half - q1q1 - q2q2)) >> 29);
+    b[0] = MPU9250_Ahrs_Sqrt((uint64_t) ((int64_t) hx * hx + (int64_t) hy * hy));
+
+    // Half of the reference direction in the body frame, Q30
+    w[0] = (int32_t) (((int64_t) b[0] * (half - q2q2 - q3q3) + (int64_t) b[1] * (q1q3 - q0q2)) >> 30);
+    w[1] = (int32_t) (((int64_t) b[0] * (q1q2 - q0q3) + (int64_t) b[1] * (q0q1 + q2q3)) >> 30);
+    w[2] = (int32_t) (((int64_t) b[0] * (q0q2 + q1q3) + (int64_t) b[1] * (half - q1q1 - q2q2)) >> 30);
+}
+
+static void MPU9250_Ahrs_Integrate(int32_t* q, const int32_t* h, const int32_t* correction) {
+    int32_t dq[4];
+    uint8_t i;
+
+    // Change in the sample period from the half rotation angles: q (0, h)
+    dq[0] = (int32_t) ((-(int64_t) q[1] * h[0] - (int64_t) q[2] * h[1] - (int64_t) q[3] * h[2]) >> 30);
+    dq[1] = (int32_t) (( (int64_t) q[0] * h[0] + (int64_t) q[2] * h[2] - (int64_t) q[3] * h[1]) >> 30);
+    dq[2] = (int32_t) (( (int64_t) q[0] * h[1] - (int64_t) q[1] * h[2] + (int64_t) q[3] * h[0]) >> 30);
+    dq[3] = (int32_t) (( (int64_t) q[0] * h[2] + (int64_t) q[1] * h[1] - (int64_t) q[2] * h[0]) >> 30);
+
+    for (i = 0; i < 4; i++) {
+        q[i] += dq[i];
+        if (correction != NULL)
+            q[i] -= correction[i];
+    }
+    MPU9250_Ahrs_Normalize(q, 4);
+}
+
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+
+static void MPU9250_Ahrs_Correct(MPU9250_Ahrs* ahrs, const int32_t* a, const int32_t* m, int32_t* h) {
+    int32_t v[3], w[3], b[2];
+    int64_t e[3];
+    uint8_t i;
+
+    // Half of the error between measured and estimated directions: a x v + m x w
+    MPU9250_Ahrs_Gravity(ahrs->q, v);
+    e[0] = (int64_t) a[1] * v[2] - (int64_t) a[2] * v[1];
+    e[1] = (int64_t) a[2] * v[0] - (int64_t) a[0] * v[2];
+    e[2] = (int64_t) a[0] * v[1] - (int64_t) a[1] * v[0];
+    if (m != NULL) {
+        MPU9250_Ahrs_Field(ahrs->q, m, w, b);
+        e[0] += (int64_t) m[1] * w[2] - (int64_t) m[2] * w[1];
+        e[1] += (int64_t) m[2] * w[0] - (int64_t) m[0] * w[2];
+        e[2] += (int64_t) m[0] * w[1] - (int64_t) m[1] * w[0];
+    }
+
+    for (i = 0; i < 3; i++) {
+        int32_t error = (int32_t) (e[i] >> 30);
+        // Integral term: gyroscope bias, saturated to the raw range
+        int32_t bias = ahrs->bias[i] + MPU9250_AHRS_MUL(ahrs->ki_k, error);
+        if (bias > MPU9250_AHRS_MAX_BIAS)
+            bias = MPU9250_AHRS_MAX_BIAS;
+        if (bias < -MPU9250_AHRS_MAX_BIAS)
+            bias = -MPU9250_AHRS_MAX_BIAS;
+        ahrs->bias[i] = bias;
+        // Proportional term
+        h[i] += MPU9250_AHRS_MUL(ahrs->kp_dt, error);
+    }
+}
+
+#else
+
+static uint8_t MPU9250_Ahrs_Gradient(const int32_t* q, const int32_t* a, const int32_t* m, int32_t* grad) {
+    int32_t v[3];
+    int64_t s[4];
+    uint8_t i;
+
+    // Half of the gravity error, Q29
+    MPU9250_Ahrs_Gravity(q, v);
+    int32_t f1 = (v[0] - a[0] / 2) >> 1;
+    int32_t f2 = (v[1] - a[1] / 2) >> 1;
+    int32_t f3 = (v[2] - a[2] / 2) >> 1;
+
+    // Transposed Jacobian times the error (halved), Q59
+    s[0] = -(int64_t) q[2] * f1 + (int64_t) q[1] * f2;
+    s[1] =  (int64_t) q[3] * f1 + (int64_t) q[0] * f2 - 2 * (int64_t) q[1] * f3;
+    s[2] = -(int64_t) q[0] * f1 + (int64_t) q[3] * f2 - 2 * (int64_t) q[2] * f3;
+    s[3] =  (int64_t) q[1] * f1 + (int64_t) q[2] * f2;
+
+    if (m != NULL) {
+        int32_t w[3], b[2];
+        int32_t bxq[4], bzq[4];
+        MPU9250_Ahrs_Field(q, m, w, b);
+        for (i = 0; i < 4; i++) {
+            bxq[i] = MPU9250_AHRS_MUL(b[0], q[i]);
+            bzq[i] = MPU9250_AHRS_MUL(b[1], q[i]);
+        }
+
+        // Half of the magnetic field error, Q29
+        int32_t b1 = (w[0] - m[0] / 2) >> 1;
+        int32_t b2 = (w[1] - m[1] / 2) >> 1;
+        int32_t b3 = (w[2] - m[2] / 2) >> 1;
+
+        // Coefficients up to 2 in magnitude: summed on 64 bits
+        s[0] += -(int64_t) bzq[2] * b1 + ((int64_t) bzq[1] - bxq[3]) * b2 + (int64_t) bxq[2] * b3;
+        s[1] +=  (int64_t) bzq[3] * b1 + ((int64_t) bxq[2] + bzq[0]) * b2 + ((int64_t) bxq[3] - 2 * (int64_t) bzq[1]) * b3;
+        s[2] += -(2 * (int64_t) bxq[2] + bzq[0]) * b1 + ((int64_t) bxq[1] + bzq[3]) * b2 +
+                 ((int64_t) bxq[0] - 2 * (int64_t) bzq[2]) * b3;
+        s[3] +=  ((int64_t) bzq[1] - 2 * (int64_t) bxq[3]) * b1 + ((int64_t) bzq[2] - bxq[0]) * b2 + (int64_t) bxq[1] * b3;
+    }
+
+    // Largest component in 30 bits, then normalized
+    uint64_t max = 0;
+    for (i = 0; i < 4; i++) {
+        uint64_t abs = s[i] < 0 ? -(uint64_t) s[i] : (uint64_t) s[i];
+        if (abs > max)
+            max = abs;
+    }
+    uint8_t bits = MPU9250_Ahrs_Bits(max);
+    uint8_t shift = bits > 30 ? bits - 30 : 0;
+    for (i = 0; i < 4; i++)
+        grad[i] = (int32_t) (s[i] >> shift);
+    return MPU9250_Ahrs_Normalize(grad, 4);
+}
+
+#endif
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Ahrs_Init(MPU9250_Ahrs* ahrs, MPU9250_Gyro_FS fs, uint32_t period_us) {
+    if ((period_us == 0) || (((uint64_t) period_us << (fs & 0x03)) > MPU9250_AHRS_MAX_PERIOD_US))
+        return MPU9250_UNKNOWN_ERR;
+
+    ahrs->gyro_k = (int32_t) ((((uint64_t) period_us * MPU9250_AHRS_GYRO_K) << (fs & 0x03)) >> 8);
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    ahrs->kp_dt = (int32_t) (((uint64_t) period_us * MPU9250_AHRS_GAIN_PER_US(MPU9250_AHRS_KP)) >> 16);
+    ahrs->ki_k = (int32_t) ((((uint64_t) period_us * MPU9250_AHRS_BIAS_PER_US(MPU9250_AHRS_KI)) >> (fs & 0x03)) >> 16);
+#else
+    ahrs->beta_dt = (int32_t) (((uint64_t) period_us * MPU9250_AHRS_GAIN_PER_US(MPU9250_AHRS_BETA)) >> 16);
+#endif
+    MPU9250_Mag_GetAdjustment(ahrs->mag_adj);
+    MPU9250_Ahrs_Reset(ahrs);
+    return MPU9250_OK;
+}
+
+void MPU9250_Ahrs_Reset(MPU9250_Ahrs* ahrs) {
+    ahrs->q[0] = MPU9250_AHRS_ONE;
+    ahrs->q[1] = 0;
+    ahrs->q[2] = 0;
+    ahrs->q[3] = 0;
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    ahrs->bias[0] = 0;
+    ahrs->bias[1] = 0;
+    ahrs->bias[2] = 0;
+#endif
+}
+
+void MPU9250_Ahrs_Update(MPU9250_Ahrs* ahrs, const int16_t* acc, const int16_t* gyro, const int16_t* mag) {
+    int32_t a[3] = {acc[0], acc[1], acc[2]};
+    int32_t m[3];
+    int32_t* mp = NULL;
+    int32_t h[3];
+    uint8_t i;
+
+    // Half rotation angles in the sample period, Q30
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    for (i = 0; i < 3; i++)
+        h[i] = (int32_t) (((((int64_t) gyro[i] << 16) + ahrs->bias[i]) * ahrs->gyro_k) >> 30);
+#else
+    for (i = 0; i < 3; i++)
+        h[i] = (int32_t) (((int64_t) gyro[i] * ahrs->gyro_k) >> 14);
+#endif
+
+    // Without a valid accelerometer vector the gyroscope is integrated as it is
+    if (!MPU9250_Ahrs_Normalize(a, 3)) {
+        MPU9250_Ahrs_Integrate(ahrs->q, h, NULL);
+        return;
+    }
+    if (mag != NULL) {
+        MPU9250_Ahrs_AlignMag(ahrs, mag, m);
+        if (MPU9250_Ahrs_Normalize(m, 3))
+            mp = m;
+    }
+
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    // Feedback on the rotation rate
+    MPU9250_Ahrs_Correct(ahrs, a, mp, h);
+    MPU9250_Ahrs_Integrate(ahrs->q, h, NULL);
+#else
+    // Step along the normalized gradient of the error
+    int32_t step[4];
+    if (MPU9250_Ahrs_Gradient(ahrs->q, a, mp, step)) {
+        for (i = 0; i < 4; i++)
+            step[i] = MPU9250_AHRS_MUL(ahrs->beta_dt, step[i]);
+        MPU9250_Ahrs_Integrate(ahrs->q, h, step);
+    } else {
+        MPU9250_Ahrs_Integrate(ahrs->q, h, NULL);
+    }
+#endif
+}
+
+void MPU9250_Ahrs_UpdateFifo(MPU9250_Ahrs* ahrs, const MPU9250_Fifo_Samples* samples,
+                             uint16_t frames, const int16_t* mag) {
+    for (uint16_t f = 0; f < frames; f++) {
+        int16_t acc[3] = {samples->acc[0][f], samples->acc[1][f], samples->acc[2][f]};
+        int16_t gyro[3] = {samples->gyro[0][f], samples->gyro[1][f], samples->gyro[2][f]};
+        MPU9250_Ahrs_Update(ahrs, acc, gyro, mag);
+    }
+}
+/* [] END OF FILE */
@@ -0,0 +1,170 @@
+/** @file MPU9250_Ahrs.h
+ * @brief Header file for orientation estimation (AHRS).
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes of the attitude and heading reference system. It consumes
+ * the raw values of the driver (#MPU9250_ReadAccGyro, #MPU9250_ReadMag or
+ * #MPU9250_Fifo_Decode) and keeps the orientation as a quaternion, with
+ * integer math only.
+ *
+ * The filter is selected at build time with #MPU9250_AHRS_ENGINE: the
+ * Madgwick gradient descent filter, or the cheaper Mahony complementary
+ * filter, whose integral term also estimates the gyroscope bias.
+ *
+ * The quaternion (w, x, y, z) rotates vectors from the body frame to the
+ * earth frame: z up and, with the magnetometer, x towards the magnetic north.
+ * The accelerometer and gyroscope values are in the body axes (see
+ * MPU9250_Mount.h); the magnetometer values are in the AK8963 axes and
+ * are aligned here. The hard iron offsets of the magnetometer are not
+ * compensated.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_AHRS_H_
+
+    #define __MPU9250_AHRS_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250.h"
+    #include "MPU9250_Fifo.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Madgwick gradient descent filter.
+    */
+    #define MPU9250_AHRS_MADGWICK 0
+
+    /**
+    * @brief Mahony complementary filter.
+    */
+    #define MPU9250_AHRS_MAHONY 1
+
+    /**
+    * @brief Filter used by the AHRS.
+    */
+    #ifndef MPU9250_AHRS_ENGINE
+        #define MPU9250_AHRS_ENGINE MPU9250_AHRS_MADGWICK
+    #endif
+
+    /**
+    * @brief Gain of the gradient descent step (Madgwick), in rad/s.
+    */
+    #ifndef MPU9250_AHRS_BETA
+        #define MPU9250_AHRS_BETA 0.1
+    #endif
+
+    /**
+    * @brief Proportional gain (Mahony), in 1/s.
+    */
+    #ifndef MPU9250_AHRS_KP
+        #define MPU9250_AHRS_KP 1.0
+    #endif
+
+    /**
+    * @brief Integral gain (Mahony), in 1/s^2. 0 disables the bias estimation.
+    */
+    #ifndef MPU9250_AHRS_KI
+        #define MPU9250_AHRS_KI 0.02
+    #endif
+
+    /**
+    * @brief Limit of the estimated gyroscope bias (Mahony), in LSB.
+    */
+    #ifndef MPU9250_AHRS_MAX_BIAS_LSB
+        #define MPU9250_AHRS_MAX_BIAS_LSB 2048
+    #endif
+
+    /**
+    * @brief Maximum sample period, in us, at 250 dps.
+    *
+    * It halves at each doubling of the gyroscope full scale range.
+    */
+    #define MPU9250_AHRS_MAX_PERIOD_US 1800000UL
+
+    /**
+    * @brief One in the Q2.30 format of the quaternion.
+    */
+    #define MPU9250_AHRS_ONE (1L << 30)
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief State of the AHRS.
+    */
+    typedef struct {
+        /** Orientation quaternion (w, x, y, z), Q2.30 **/
+        int32_t q[4];
+        /** Half rotation angle per gyroscope LSB in a sample period, rad (Q44) **/
+        int32_t gyro_k;
+    #if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+        /** Proportional gain in a sample period (Q2.30) **/
+        int32_t kp_dt;
+        /** Bias change per unit of error in a sample period, LSB (Q16) **/
+        int32_t ki_k;
+        /** Estimated gyroscope bias (x, y and z), to be added to the raw values, LSB (Q16) **/
+        int32_t bias[3];
+    #else
+        /** Gain of the correction in a sample period (Q2.30) **/
+        int32_t beta_dt;
+    #endif
+        /** Magnetometer sensitivity adjustment (Q15), see #MPU9250_Mag_GetAdjustment **/
+        uint16_t mag_adj[3];
+    } MPU9250_Ahrs;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Initialize the AHRS.
+    *
+    * The orientation is reset to the identity. The magnetometer sensitivity
+    * adjustment is read from the driver, so this function is called after
+    * #MPU9250_Start.
+    * @param[out] ahrs: AHRS to be initialized.
+    * @param[in] fs: gyroscope full scale range of the raw values.
+    * @param[in] period_us: sample period, in us.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_UNKNOWN_ERR if the period is 0 or too long for the full scale range.
+    */
+    uint8_t MPU9250_Ahrs_Init(MPU9250_Ahrs* ahrs, MPU9250_Gyro_FS fs, uint32_t period_us);
+
+    /**
+    * @brief Reset the orientation to the identity.
+    *
+    * The estimated gyroscope bias, if any, is reset too.
+    * @param[in,out] ahrs: AHRS to be reset.
+    */
+    void MPU9250_Ahrs_Reset(MPU9250_Ahrs* ahrs);
+
+    /**
+    * @brief Update the orientation with a sample.
+    *
+    * With the magnetometer (MARG update) the heading is corrected too,
+    * otherwise (IMU update) only the inclination. A null accelerometer
+    * or magnetometer vector is not used.
+    * @param[in,out] ahrs: AHRS to be updated.
+    * @param[in] acc: raw accelerometer values (x, y and z).
+    * @param[in] gyro: raw gyroscope values (x, y and z).
+    * @param[in] mag: raw magnetometer values (x, y and z), or NULL.
+    */
+    void MPU9250_Ahrs_Update(MPU9250_Ahrs* ahrs, const int16_t* acc, const int16_t* gyro, const int16_t* mag);
+
+    /**
+    * @brief Update the orientation with a batch of samples decoded from the FIFO.
+    *
+    * The magnetometer, slower than the FIFO, is the same for all the frames.
+    * @param[in,out] ahrs: AHRS to be updated.
+    * @param[in] samples: samples decoded by #MPU9250_Fifo_Decode, with all
+    *            the accelerometer and gyroscope axes.
+    * @param[in] frames: number of frames.
+    * @param[in] mag: raw magnetometer values (x, y and z), or NULL.
+    */
+    void MPU9250_Ahrs_UpdateFifo(MPU9250_Ahrs* ahrs, const MPU9250_Fifo_Samples* samples,
+                                 uint16_t frames, const int16_t* mag);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,253 @@
+/*
+ * @brief Function definitions for auxiliary sensors.
+ *
+ * This file contains the definitions of the functions that can be used
+ * to read sensors on the auxiliary I2C bus through the internal I2C
+ * master of the MPU9250.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Aux.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_Shadow.h"
+#include "MPU9250_Fifo.h"
+#include "MPU9250_Stats.h"
+#include "CyLib.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_USER_CTRL_I2C_MST_EN
+    #define MPU9250_USER_CTRL_I2C_MST_EN 0x20 // I2C master enable bit of USER_CTRL
+#endif
+
+#ifndef MPU9250_BYPASS_EN
+    #define MPU9250_BYPASS_EN 0x02           // I2C bypass enable bit of INT_PIN_CFG
+#endif
+
+#ifndef MPU9250_I2C_MST_CFG_MASK
+    #define MPU9250_I2C_MST_CFG_MASK 0x4F    // WAIT_FOR_ES and I2C_MST_CLK bits of I2C_MST_CTRL
+#endif
+
+#ifndef MPU9250_SLV3_FIFO_EN
+    #define MPU9250_SLV3_FIFO_EN 0x20        // Slave 3 FIFO enable bit of I2C_MST_CTRL
+#endif
+
+#ifndef MPU9250_DELAY_ES_SHADOW
+    #define MPU9250_DELAY_ES_SHADOW 0x80     // Shadow external data when all of them are read
+#endif
+
+#ifndef MPU9250_SLV_EN
+    #define MPU9250_SLV_EN 0x80              // Enable bit of I2C_SLVx_CTRL
+#endif
+
+#ifndef MPU9250_SLV_RNW
+    #define MPU9250_SLV_RNW 0x80             // Read bit of I2C_SLVx_ADDR
+#endif
+
+#ifndef MPU9250_SLV4_DONE
+    #define MPU9250_SLV4_DONE 0x40           // Slave 4 transfer done bit of I2C_MST_STATUS
+#endif
+
+#ifndef MPU9250_SLV4_NACK
+    #define MPU9250_SLV4_NACK 0x10           // Slave 4 NACK bit of I2C_MST_STATUS
+#endif
+
+#define MPU9250_AUX_SLV_REGS 3  // ADDR, REG and CTRL registers of each slave
+
+/* ========= VARIABLES ========= */
+static uint8_t length[MPU9250_AUX_SLAVES] = {0, 0, 0, 0};      // Bytes read by each slave, 0 if unused
+static uint8_t decimation[MPU9250_AUX_SLAVES] = {0, 0, 0, 0};  // Decimation of each slave
+static uint8_t fifo_sources = 0x00;                           // FIFO sources of slaves 0 to 2
+static uint8_t mst_dly = 0;                                   // I2C_MST_DLY of I2C_SLV4_CTRL
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t MPU9250_Aux_Transfer(uint8_t address, uint8_t reg, uint8_t data) {
+    // Run a single byte transfer on slave 4 and wait for its completion
+    uint8_t status;
+    uint32_t period_q8;
+    uint8_t slv4[3] = {address, reg, data};
+    uint8_t err = MPU9250_Shadow_WriteMulti(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_ADDR_REG, slv4, 3);
+    if (err != MPU9250_OK)
+        return err;
+
+    // Slave 4 runs once per sample: wait up to two sample periods, plus a margin
+    err = MPU9250_Fifo_GetFramePeriod(&period_q8);
+    if (err != MPU9250_OK)
+        return err;
+    uint16_t timeout_ms = (((period_q8 >> 7) + 999) / 1000) + MPU9250_AUX_SLV4_TIMEOUT_MS;
+
+    // Clear the status, then start the transfer. The enable bit is cleared
+    // by the device when the transfer is done, so the register is not cached.
+    // It also holds the decimation of the other slaves, which is preserved.
+    err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_STATUS_REG, &status, 1);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Bus_WriteSingle(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_CTRL_REG, MPU9250_SLV_EN | mst_dly);
+    if (err != MPU9250_OK)
+        return err;
+
+    for (uint16_t ms = 0; ms < timeout_ms; ms++) {
+        CyDelay(1);
+        err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_STATUS_REG, &status, 1);
+        if (err != MPU9250_OK)
+            return err;
+        if (status & MPU9250_SLV4_NACK)
+            return MPU9250_DEV_NOT_FOUND_ERR;
+        if (status & MPU9250_SLV4_DONE)
+            return MPU9250_OK;
+    }
+    return MPU9250_TIMEOUT_ERR;
+}
+
+static uint8_t MPU9250_Aux_UpdateDecimation(void) {
+    // Enable the delay of the decimated slaves, all with the same factor
+    uint8_t delay_ctrl = MPU9250_DELAY_ES_SHADOW;
+    uint8_t factor = 1;
+    for (uint8_t slave = 0; slave < MPU9250_AUX_SLAVES; slave++) {
+        if (length[slave] > 0 && decimation[slave] > 1) {
+            delay_ctrl |= (1 << slave);
+            factor = decimation[slave];
+        }
+    }
+    mst_dly = factor - 1;
+
+    uint8_t err = MPU9250_Bus_WriteSingle(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_CTRL_REG, mst_dly);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_DELAY_CTRL_REG, delay_ctrl);
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Aux_Start(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    // Disable the I2C bypass and enable the internal I2C master
+    uint8_t err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_INT_PIN_CFG_REG,
+        MPU9250_BYPASS_EN, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_CTRL_REG,
+        MPU9250_I2C_MST_CFG_MASK, MPU9250_AUX_MST_CTRL);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG,
+        MPU9250_USER_CTRL_I2C_MST_EN, MPU9250_USER_CTRL_I2C_MST_EN);
+}
+
+uint8_t MPU9250_Aux_AddRead(uint8_t slave, const MPU9250_Aux_Read* read) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    if (slave >= MPU9250_AUX_SLAVES || read->length == 0 || read->length > MPU9250_AUX_MAX_LENGTH ||
+        read->decimation == 0 || read->decimation > MPU9250_AUX_MAX_DECIMATION)
+        return MPU9250_UNKNOWN_ERR;
+
+    // The external sensor data are shared by all the slaves,
+    // and so is the decimation factor
+    uint8_t total = read->length;
+    for (uint8_t i = 0; i < MPU9250_AUX_SLAVES; i++) {
+        if (i == slave || length[i] == 0)
+            continue;
+        total += length[i];
+        if (read->decimation > 1 && decimation[i] > 1 && decimation[i] != read->decimation)
+            return MPU9250_UNKNOWN_ERR;
+    }
+    if (total > MPU9250_AUX_EXT_SENS_SIZE)
+        return MPU9250_UNKNOWN_ERR;
+
+    length[slave] = read->length;
+    decimation[slave] = read->decimation;
+    uint8_t err = MPU9250_Aux_UpdateDecimation();
+    if (err != MPU9250_OK)
+        return err;
+
+    // Slave 3 is enabled in the FIFO through I2C_MST_CTRL, the others through FIFO_EN
+    if (slave == 3) {
+        err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_CTRL_REG,
+            MPU9250_SLV3_FIFO_EN, read->fifo ? MPU9250_SLV3_FIFO_EN : 0x00);
+        if (err != MPU9250_OK)
+            return err;
+    } else {
+        fifo_sources &= ~(MPU9250_FIFO_SLV0 << slave);
+        fifo_sources |= read->fifo ? (MPU9250_FIFO_SLV0 << slave) : 0x00;
+    }
+
+    uint8_t slv[MPU9250_AUX_SLV_REGS] = {
+        MPU9250_SLV_RNW | read->address,
+        read->reg,
+        MPU9250_SLV_EN | read->length
+    };
+    return MPU9250_Shadow_WriteMulti(MPU9250_I2C_ADDRESS,
+        MPU9250_I2C_SLV0_ADDR_REG + MPU9250_AUX_SLV_REGS * slave, slv, MPU9250_AUX_SLV_REGS);
+}
+
+uint8_t MPU9250_Aux_RemoveRead(uint8_t slave) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    if (slave >= MPU9250_AUX_SLAVES)
+        return MPU9250_UNKNOWN_ERR;
+
+    uint8_t err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS,
+        MPU9250_I2C_SLV0_CTRL_REG + MPU9250_AUX_SLV_REGS * slave, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+
+    length[slave] = 0;
+    decimation[slave] = 0;
+    if (slave == 3) {
+        err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_CTRL_REG,
+            MPU9250_SLV3_FIFO_EN, 0x00);
+        if (err != MPU9250_OK)
+            return err;
+    } else {
+        fifo_sources &= ~(MPU9250_FIFO_SLV0 << slave);
+    }
+    return MPU9250_Aux_UpdateDecimation();
+}
+
+uint8_t MPU9250_Aux_GetOffset(uint8_t slave, uint8_t* offset) {
+    if (slave >= MPU9250_AUX_SLAVES || length[slave] == 0)
+        return MPU9250_UNKNOWN_ERR;
+
+    *offset = 0;
+    for (uint8_t i = 0; i < slave; i++) {
+        *offset += length[i];
+    }
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_Aux_GetFifoSources(void) {
+    return fifo_sources;
+}
+
+uint8_t MPU9250_Aux_ReadData(uint8_t slave, uint8_t* data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    uint8_t offset;
+    uint8_t err = MPU9250_Aux_GetOffset(slave, &offset);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_EXT_SENS_DATA_00_REG + offset,
+        data, length[slave]);
+}
+
+uint8_t MPU9250_Aux_WriteByte(uint8_t address, uint8_t reg, uint8_t data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    uint8_t err = MPU9250_Aux_Transfer(address, reg, data);
+
+    // The write does not go through the shadow copy (e.g. AK8963 CNTL1): keep
+    // it coherent. After an error the register could have been written anyway.
+    if (err == MPU9250_OK) {
+        MPU9250_Shadow_Record(address, reg, data);
+    } else {
+        MPU9250_Shadow_Forget(address, reg);
+    }
+    return err;
+}
+
+uint8_t MPU9250_Aux_ReadByte(uint8_t address, uint8_t reg, uint8_t* data) {
+    MPU9250_STATS_API(MPU9250_STATS_API_AUX);
+    uint8_t err = MPU9250_Aux_Transfer(MPU9250_SLV_RNW | address, reg, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_DI_REG, data, 1);
+}
+/* [] END OF FILE */
@@ -0,0 +1,187 @@
+/** @file MPU9250_Aux.h
+ * @brief Header file for auxiliary sensors.
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes to read sensors connected to the auxiliary I2C bus of the
+ * MPU9250 through its internal I2C master. Up to four reads can be
+ * registered on slaves 0 to 3: the MPU9250 runs them at each sample, in
+ * lock-step with its own sensors, and stores their data in the external
+ * sensor data registers (#MPU9250_EXT_SENS_DATA_00_REG and following) and,
+ * if requested, in the FIFO. The MCU reads them with the IMU data, with no
+ * separate transaction.
+ *
+ * A read can be decimated: it then runs once every N samples. The MPU9250
+ * has a single decimation factor (I2C_MST_DLY of #MPU9250_I2C_SLV4_CTRL_REG),
+ * enabled per slave in #MPU9250_I2C_MST_DELAY_CTRL_REG, so all the decimated
+ * reads share the same factor.
+ *
+ * Slave 4 performs single byte transfers, e.g. to configure the sensors.
+ * Slave 0 is used by the magnetometer mirror (#MPU9250_Mag_StartMirror).
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_AUX_H_
+
+    #define __MPU9250_AUX_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Number of slaves that can run periodic reads.
+    */
+    #define MPU9250_AUX_SLAVES 4
+
+    /**
+    * @brief Maximum number of bytes of a periodic read.
+    */
+    #define MPU9250_AUX_MAX_LENGTH 15
+
+    /**
+    * @brief Number of external sensor data registers.
+    */
+    #define MPU9250_AUX_EXT_SENS_SIZE 24
+
+    /**
+    * @brief Maximum decimation factor.
+    */
+    #define MPU9250_AUX_MAX_DECIMATION 32
+
+    /**
+    * @brief Configuration of I2C_MST_CTRL set by #MPU9250_Aux_Start.
+    *
+    * Data ready waits for the external sensor data, 400 kHz.
+    */
+    #ifndef MPU9250_AUX_MST_CTRL
+        #define MPU9250_AUX_MST_CTRL 0x4D
+    #endif
+
+    /**
+    * @brief Margin of the duration of a slave 4 transfer, in ms.
+    *
+    * Slave 4 runs once per sample: a transfer waits for two sample periods
+    * (see #MPU9250_Fifo_GetFramePeriod), plus this margin.
+    */
+    #ifndef MPU9250_AUX_SLV4_TIMEOUT_MS
+        #define MPU9250_AUX_SLV4_TIMEOUT_MS 10
+    #endif
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Periodic read of an auxiliary sensor.
+    */
+    typedef struct {
+        /** 7 bit I2C address of the sensor **/
+        uint8_t address;
+        /** First register to be read **/
+        uint8_t reg;
+        /** Number of bytes to be read (1 - #MPU9250_AUX_MAX_LENGTH) **/
+        uint8_t length;
+        /** Read once every decimation samples (1 - #MPU9250_AUX_MAX_DECIMATION) **/
+        uint8_t decimation;
+        /** Data written to the FIFO (1) or only to the external sensor data (0) **/
+        uint8_t fifo;
+    } MPU9250_Aux_Read;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Start the internal I2C master.
+    *
+    * This function disables the I2C bypass and enables the internal I2C master.
+    * Sensors on the auxiliary bus are then not reachable from the MCU bus.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Aux_Start(void);
+
+    /**
+    * @brief Register a periodic read.
+    *
+    * @param[in] slave: slave running the read (0 - 3).
+    * @param[in] read: read to be registered.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if the read is not valid, does not fit in the
+    *         external sensor data, or its decimation differs from the one of
+    *         the other decimated reads.
+    */
+    uint8_t MPU9250_Aux_AddRead(uint8_t slave, const MPU9250_Aux_Read* read);
+
+    /**
+    * @brief Remove a periodic read.
+    *
+    * The external sensor data of the following slaves move down.
+    * @param[in] slave: slave running the read (0 - 3).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Aux_RemoveRead(uint8_t slave);
+
+    /**
+    * @brief Get the position of the data of a read in the external sensor data.
+    *
+    * The reads fill the external sensor data in slave order.
+    * @param[in] slave: slave running the read (0 - 3).
+    * @param[out] offset: offset from #MPU9250_EXT_SENS_DATA_00_REG.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_UNKNOWN_ERR if no read is registered on the slave.
+    */
+    uint8_t MPU9250_Aux_GetOffset(uint8_t slave, uint8_t* offset);
+
+    /**
+    * @brief Get the FIFO sources of the reads written to the FIFO.
+    *
+    * Slave 3 is enabled in the FIFO by #MPU9250_Aux_AddRead. Slaves 0 to 2
+    * are enabled by passing these sources to #MPU9250_Fifo_Enable.
+    * @return OR of #MPU9250_FIFO_SLV0, #MPU9250_FIFO_SLV1 and #MPU9250_FIFO_SLV2.
+    */
+    uint8_t MPU9250_Aux_GetFifoSources(void);
+
+    /**
+    * @brief Read the latest data of a read from the external sensor data.
+    *
+    * @param[in] slave: slave running the read (0 - 3).
+    * @param[out] data: data of the read, length bytes.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if no read is registered on the slave.
+    */
+    uint8_t MPU9250_Aux_ReadData(uint8_t slave, uint8_t* data);
+
+    /**
+    * @brief Write a register of an auxiliary sensor through slave 4.
+    *
+    * The shadow copy of the register, if cached (AK8963), is updated.
+    * @param[in] address: 7 bit I2C address of the sensor.
+    * @param[in] reg: register to be written.
+    * @param[in] data: value to be written.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the sensor does not answer.
+    * @retval #MPU9250_TIMEOUT_ERR if the transfer does not complete.
+    */
+    uint8_t MPU9250_Aux_WriteByte(uint8_t address, uint8_t reg, uint8_t data);
+
+    /**
+    * @brief Read a register of an auxiliary sensor through slave 4.
+    *
+    * @param[in] address: 7 bit I2C address of the sensor.
+    * @param[in] reg: register to be read.
+    * @param[out] data: value read.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the sensor does not answer.
+    * @retval #MPU9250_TIMEOUT_ERR if the transfer does not complete.
+    */
+    uint8_t MPU9250_Aux_ReadByte(uint8_t address, uint8_t reg, uint8_t* data);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,63 @@
+/*
+ * @brief Function definitions for the register access backend.
+ *
+ * This file contains the definitions of the functions that forward
+ * register accesses to the selected backend, and the I2C backend.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Bus.h"
+#include "MPU9250_Shadow.h"
+#ifndef MPU9250_I2C_DISABLED
+    #include "MPU9250_I2C.h"
+#endif
+#ifdef MPU9250_SPI_ENABLED
+    #include "MPU9250_SPI.h"
+#endif
+
+/* ========= VARIABLES ========= */
+#ifndef MPU9250_I2C_DISABLED
+const MPU9250_Bus MPU9250_Bus_I2C = {
+    MPU9250_I2C_Start,
+    MPU9250_I2C_ReadMulti,
+    MPU9250_I2C_WriteMulti,
+    MPU9250_I2C_Write,
+    0x00
+};
+#endif
+
+#ifdef MPU9250_BUS_DEFAULT
+static const MPU9250_Bus* bus = &MPU9250_BUS_DEFAULT;  // Backend in use
+#else
+static const MPU9250_Bus* bus = NULL;                  // Backend in use, to be selected
+#endif
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_Bus_SetBackend(const MPU9250_Bus* backend) {
+    bus = backend;
+    // Registers will be read again through the new backend
+    MPU9250_Shadow_Invalidate();
+}
+
+const MPU9250_Bus* MPU9250_Bus_GetBackend(void) {
+    return bus;
+}
+
+void MPU9250_Bus_Start(void) {
+    bus->start();
+}
+
+uint8_t MPU9250_Bus_ReadBurst(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+    return bus->read_burst(address, reg, data, count);
+}
+
+uint8_t MPU9250_Bus_WriteBurst(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+    return bus->write_burst(address, reg, data, count);
+}
+
+uint8_t MPU9250_Bus_WriteSingle(uint8_t address, uint8_t reg, uint8_t data) {
+    return bus->write_single(address, reg, data);
+}
+/* [] END OF FILE */
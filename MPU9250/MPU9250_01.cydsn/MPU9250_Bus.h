@@ -0,0 +1,144 @@
+/** @file MPU9250_Bus.h
+ * @brief Header file for the register access backend.
+ *
+ * This header file contains the type definitions and function
+ * prototypes of the register access layer. All the accesses to the
+ * registers of the MPU9250 and of the AK8963 are done through these
+ * functions, that forward them to the selected backend:
+ *   - #MPU9250_Bus_I2C: I2C master component (see MPU9250_I2C.h),
+ *     not available when #MPU9250_I2C_DISABLED is defined
+ *   - #MPU9250_Bus_SPI: SPI master component (see MPU9250_SPI.h),
+ *     available when #MPU9250_SPI_ENABLED is defined
+ *
+ * Any other backend (e.g. a simulated device on a host) can be selected
+ * with #MPU9250_Bus_SetBackend.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_BUS_H_
+
+    #define __MPU9250_BUS_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Register access backend.
+    *
+    * Set of functions used to access the registers of a device. The
+    * address parameter is the 7 bit I2C address of the device, that
+    * backends use to select the device (e.g. the chip select line).
+    */
+    typedef struct {
+        /** Start the underlying component **/
+        void (*start)(void);
+        /** Read count consecutive registers, starting from reg **/
+        uint8_t (*read_burst)(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+        /** Write count consecutive registers, starting from reg **/
+        uint8_t (*write_burst)(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+        /** Write a single register **/
+        uint8_t (*write_single)(uint8_t address, uint8_t reg, uint8_t data);
+        /** Bits of #MPU9250_USER_CTRL_REG required by the interface **/
+        uint8_t user_ctrl;
+    } MPU9250_Bus;
+
+    /* ========= VARIABLES ========= */
+
+    #ifndef MPU9250_I2C_DISABLED
+        /**
+        * @brief I2C backend.
+        */
+        extern const MPU9250_Bus MPU9250_Bus_I2C;
+    #endif
+
+    #ifdef MPU9250_SPI_ENABLED
+        /**
+        * @brief SPI backend.
+        */
+        extern const MPU9250_Bus MPU9250_Bus_SPI;
+    #endif
+
+    /**
+    * @brief Backend used when none is selected.
+    *
+    * The SPI backend is the default one when #MPU9250_SPI_ENABLED
+    * is defined, otherwise the I2C backend is used. With neither of them,
+    * a backend must be selected before #MPU9250_Start.
+    */
+    #ifndef MPU9250_BUS_DEFAULT
+        #ifdef MPU9250_SPI_ENABLED
+            #define MPU9250_BUS_DEFAULT MPU9250_Bus_SPI
+        #elif !defined(MPU9250_I2C_DISABLED)
+            #define MPU9250_BUS_DEFAULT MPU9250_Bus_I2C
+        #endif
+    #endif
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Select the register access backend.
+    *
+    * This function must be called before #MPU9250_Start. It also
+    * invalidates the shadow copy of the registers.
+    * @param[in] bus: backend to be used.
+    */
+    void MPU9250_Bus_SetBackend(const MPU9250_Bus* bus);
+
+    /**
+    * @brief Get the register access backend in use.
+    *
+    * @return Backend in use.
+    */
+    const MPU9250_Bus* MPU9250_Bus_GetBackend(void);
+
+    /**
+    * @brief Start the component of the backend in use.
+    */
+    void MPU9250_Bus_Start(void);
+
+    /**
+    * @brief Read consecutive registers.
+    *
+    * @param[in] address: 7 bit I2C address of the device
+    * @param[in] reg: first register address to read from
+    * @param[out] *data: pointer to data array where data are stored
+    * @param[in] count: number of registers to be read
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+    *         if the bus access failed.
+    */
+    uint8_t MPU9250_Bus_ReadBurst(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+
+    /**
+    * @brief Write consecutive registers.
+    *
+    * @param[in] address: 7 bit I2C address of the device
+    * @param[in] reg: first register address to write to
+    * @param[in] *data: pointer to data array to be written
+    * @param[in] count: number of registers to be written
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+    *         if the bus access failed.
+    */
+    uint8_t MPU9250_Bus_WriteBurst(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+
+    /**
+    * @brief Write a single register.
+    *
+    * @param[in] address: 7 bit I2C address of the device
+    * @param[in] reg: register address to write to
+    * @param[in] data: data to be written
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+    *         if the bus access failed.
+    */
+    uint8_t MPU9250_Bus_WriteSingle(uint8_t address, uint8_t reg, uint8_t data);
+
+#endif
+/* [] END OF FILE */
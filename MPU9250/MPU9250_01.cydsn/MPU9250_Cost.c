@@ -0,0 +1,126 @@
+/*
+ * @brief Function definitions for the bus timing cost model.
+ *
+ * This file contains the definitions of the functions that price the
+ * bus transactions of the library. A transfer costs:
+ *   - START: hold time of the start condition
+ *   - for each segment: address byte and data bytes, 9 bits each (ACK
+ *     included), plus the gap between bytes
+ *   - repeated START between segments: setup and hold time
+ *   - STOP: setup time of the stop condition and bus free time
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Cost.h"
+#include "MPU9250.h"
+#include "MPU9250_Fifo.h"
+
+/* ========= TYPE DEFS ========= */
+typedef struct {
+    uint32_t bitrate;   // Maximum bit rate of the mode, in Hz
+    uint16_t hd_sta;    // Hold time of (repeated) START, in ns
+    uint16_t su_sta;    // Setup time of repeated START, in ns
+    uint16_t su_sto;    // Setup time of STOP, in ns
+    uint16_t buf;       // Bus free time between STOP and START, in ns
+} MPU9250_Cost_Mode;
+
+/* ========= VARIABLES ========= */
+// Minimum timings of the I2C specification (UM10204, table 10)
+static const MPU9250_Cost_Mode modes[] = {
+    {100000,  4000, 4700, 4000, 4700},  // Standard mode
+    {400000,   600,  600,  600, 1300},  // Fast mode
+    {1000000,  260,  260,  260,  500}   // Fast mode plus
+};
+
+static const uint32_t rates[MPU9250_COST_RATES] = {100000, 400000, 1000000};
+
+/* ========= STATIC FUNCTIONS ========= */
+static const MPU9250_Cost_Mode* MPU9250_Cost_GetMode(uint32_t bitrate) {
+    // Slowest mode that supports the bit rate
+    for (uint8_t i = 0; i < sizeof(modes) / sizeof(modes[0]) - 1; i++) {
+        if (bitrate <= modes[i].bitrate)
+            return &modes[i];
+    }
+    return &modes[sizeof(modes) / sizeof(modes[0]) - 1];
+}
+
+/* ========= FUNCTIONS ========= */
+uint32_t MPU9250_Cost_TransferNs(uint32_t bitrate, const MPU9250_I2C_Segment* segments, uint8_t n) {
+    const MPU9250_Cost_Mode* mode = MPU9250_Cost_GetMode(bitrate);
+    uint32_t byte_ns = 9 * (1000000000u / bitrate) + MPU9250_COST_BYTE_GAP_NS;
+    uint32_t ns = mode->hd_sta + mode->su_sto + mode->buf;
+
+    for (uint8_t i = 0; i < n; i++) {
+        if (i > 0) {
+            ns += mode->su_sta + mode->hd_sta;
+        }
+        // Address byte followed by the data bytes
+        ns += (1 + segments[i].count) * byte_ns;
+    }
+    return ns;
+}
+
+uint32_t MPU9250_Cost_ReadMultiNs(uint32_t bitrate, uint16_t count) {
+    // Same segments as MPU9250_I2C_ReadMulti
+    uint8_t reg = 0;
+    MPU9250_I2C_Segment segments[2] = {
+        {MPU9250_I2C_SEGMENT_WRITE, &reg, 1},
+        {MPU9250_I2C_SEGMENT_READ, NULL, count}
+    };
+    return MPU9250_Cost_TransferNs(bitrate, segments, 2);
+}
+
+uint32_t MPU9250_Cost_SampleNs(uint32_t bitrate, MPU9250_Cost_Strategy strategy,
+                               uint16_t frame_bytes, uint16_t batch) {
+    uint32_t ns = 0;
+
+    switch (strategy) {
+    case MPU9250_COST_ACC_THEN_GYRO:
+        // Two bursts of 6 bytes
+        return 2 * MPU9250_Cost_ReadMultiNs(bitrate, 6);
+    case MPU9250_COST_ACC_GYRO:
+        // A single burst of 14 bytes (accelerometer, temperature, gyroscope)
+        return MPU9250_Cost_ReadMultiNs(bitrate, 14);
+    case MPU9250_COST_FIFO:
+        if ((frame_bytes == 0) || (frame_bytes > MPU9250_FIFO_MAX_BURST) || (batch == 0))
+            return 0;
+        // Interrupt status and FIFO count reads (overflow check), then the frames
+        // are drained in bursts of at most MPU9250_FIFO_MAX_BURST bytes, each
+        // made of whole frames
+        ns = MPU9250_Cost_ReadMultiNs(bitrate, 1) + MPU9250_Cost_ReadMultiNs(bitrate, 2);
+        uint16_t per_burst = MPU9250_FIFO_MAX_BURST / frame_bytes;
+        for (uint16_t left = batch; left > 0; ) {
+            uint16_t frames = left < per_burst ? left : per_burst;
+            ns += MPU9250_Cost_ReadMultiNs(bitrate, frames * frame_bytes);
+            left -= frames;
+        }
+        return ns / batch;
+    case MPU9250_COST_READ_ALL:
+        // A single burst from the accelerometer to the mirrored magnetometer
+        return MPU9250_Cost_ReadMultiNs(bitrate, MPU9250_READ_ALL_SIZE);
+    case MPU9250_COST_MAG:
+        // ST1 (data ready), then the data and ST2 (overflow), when a sample is ready
+        return MPU9250_Cost_ReadMultiNs(bitrate, 1) + MPU9250_Cost_ReadMultiNs(bitrate, 7);
+    default:
+        return 0;
+    }
+}
+
+uint32_t MPU9250_Cost_MaxOdr(uint32_t bitrate, MPU9250_Cost_Strategy strategy,
+                             uint16_t frame_bytes, uint16_t batch) {
+    uint32_t ns = MPU9250_Cost_SampleNs(bitrate, strategy, frame_bytes, batch);
+    return (ns > 0) ? 1000000000u / ns : 0;
+}
+
+void MPU9250_Cost_GetReport(MPU9250_Cost_Report* report, uint16_t frame_bytes, uint16_t batch) {
+    for (uint8_t r = 0; r < MPU9250_COST_RATES; r++) {
+        report->bitrate[r] = rates[r];
+        for (uint8_t s = 0; s < MPU9250_COST_STRATEGIES; s++) {
+            report->sample_ns[r][s] = MPU9250_Cost_SampleNs(rates[r], s, frame_bytes, batch);
+            report->max_odr[r][s] = (report->sample_ns[r][s] > 0) ? 1000000000u / report->sample_ns[r][s] : 0;
+        }
+    }
+}
+/* [] END OF FILE */
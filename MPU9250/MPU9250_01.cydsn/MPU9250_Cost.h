@@ -0,0 +1,129 @@
+/** @file MPU9250_Cost.h
+ * @brief Header file for the bus timing cost model.
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes of the bus timing model. The model prices the sequence of
+ * segments emitted by #MPU9250_I2C_Transfer (START, address bytes, data
+ * bytes with their ACK bit, repeated STARTs and STOP) at a given bit rate,
+ * using the minimum timings of the I2C specification for standard mode
+ * (100 kHz), fast mode (400 kHz) and fast mode plus (1 MHz), and gives the
+ * maximum sample rate each read strategy can sustain. Each strategy is
+ * priced with the same transfers the library emits for it, as checked by
+ * the host tests against the traffic seen by the simulated bus.
+ *
+ * The functions do not access the bus, so they can be used to check a
+ * configuration before changing #MPU9250_SMPLRT_DIV_REG in the field.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_COST_H_
+
+    #define __MPU9250_COST_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_I2C_Segment.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Time between two bytes, in nanoseconds.
+    *
+    * SCL is stretched while the I2C master component interrupt serves each
+    * byte. The default value is a conservative estimate, it can be refined
+    * with the ticks measured by the bus accounting (MPU9250_Stats.h).
+    */
+    #ifndef MPU9250_COST_BYTE_GAP_NS
+        #define MPU9250_COST_BYTE_GAP_NS 2000
+    #endif
+
+    /**
+    * @brief Bit rates of the report.
+    */
+    #define MPU9250_COST_RATES 3
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Read strategies.
+    */
+    typedef enum {
+        MPU9250_COST_ACC_THEN_GYRO, /**< #MPU9250_ReadAcc followed by #MPU9250_ReadGyro **/
+        MPU9250_COST_ACC_GYRO,      /**< #MPU9250_ReadAccGyro **/
+        MPU9250_COST_FIFO,          /**< Interrupt status and FIFO count reads followed by a burst drain **/
+        MPU9250_COST_READ_ALL,      /**< #MPU9250_ReadAll, with the magnetometer mirrored by slave 0 **/
+        MPU9250_COST_MAG,           /**< #MPU9250_ReadMag through the bypass: ST1, then the data and ST2 **/
+        MPU9250_COST_STRATEGIES     /**< Number of strategies **/
+    } MPU9250_Cost_Strategy;
+
+    /**
+    * @brief Maximum sustainable sample rates.
+    */
+    typedef struct {
+        /** Bit rates, in Hz: 100 kHz, 400 kHz and 1 MHz **/
+        uint32_t bitrate[MPU9250_COST_RATES];
+        /** Bus time per sample, in ns, for each bit rate and strategy **/
+        uint32_t sample_ns[MPU9250_COST_RATES][MPU9250_COST_STRATEGIES];
+        /** Maximum sample rate, in Hz, for each bit rate and strategy **/
+        uint32_t max_odr[MPU9250_COST_RATES][MPU9250_COST_STRATEGIES];
+    } MPU9250_Cost_Report;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Bus time of a chained transfer.
+    *
+    * @param[in] bitrate: bit rate, in Hz.
+    * @param[in] segments: segments of the transfer, as passed to #MPU9250_I2C_Transfer.
+    * @param[in] n: number of segments.
+    * @return Bus time, in ns.
+    */
+    uint32_t MPU9250_Cost_TransferNs(uint32_t bitrate, const MPU9250_I2C_Segment* segments, uint8_t n);
+
+    /**
+    * @brief Bus time of a register burst read (#MPU9250_I2C_ReadMulti).
+    *
+    * @param[in] bitrate: bit rate, in Hz.
+    * @param[in] count: number of bytes read.
+    * @return Bus time, in ns.
+    */
+    uint32_t MPU9250_Cost_ReadMultiNs(uint32_t bitrate, uint16_t count);
+
+    /**
+    * @brief Bus time per sample of a read strategy.
+    *
+    * @param[in] bitrate: bit rate, in Hz.
+    * @param[in] strategy: read strategy.
+    * @param[in] frame_bytes: size of a FIFO frame (#MPU9250_COST_FIFO only).
+    * @param[in] batch: number of frames per FIFO drain (#MPU9250_COST_FIFO only).
+    * @return Bus time per sample, in ns.
+    */
+    uint32_t MPU9250_Cost_SampleNs(uint32_t bitrate, MPU9250_Cost_Strategy strategy,
+                                   uint16_t frame_bytes, uint16_t batch);
+
+    /**
+    * @brief Maximum sample rate a read strategy can sustain.
+    *
+    * @param[in] bitrate: bit rate, in Hz.
+    * @param[in] strategy: read strategy.
+    * @param[in] frame_bytes: size of a FIFO frame (#MPU9250_COST_FIFO only).
+    * @param[in] batch: number of frames per FIFO drain (#MPU9250_COST_FIFO only).
+    * @return Maximum sample rate, in Hz, with the bus fully busy.
+    */
+    uint32_t MPU9250_Cost_MaxOdr(uint32_t bitrate, MPU9250_Cost_Strategy strategy,
+                                 uint16_t frame_bytes, uint16_t batch);
+
+    /**
+    * @brief Fill the report of all the strategies at 100 kHz, 400 kHz and 1 MHz.
+    *
+    * @param[out] report: report to be filled.
+    * @param[in] frame_bytes: size of a FIFO frame.
+    * @param[in] batch: number of frames per FIFO drain.
+    */
+    void MPU9250_Cost_GetReport(MPU9250_Cost_Report* report, uint16_t frame_bytes, uint16_t batch);
+
+#endif
+/* [] END OF FILE */
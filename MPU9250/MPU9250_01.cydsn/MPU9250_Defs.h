@@ -33,5 +33,30 @@
     */
     #define MPU9250_UNKNOWN_ERR 3
     
+    /**
+    *   @brief Error message returned when a request cannot be accepted because the bus is busy.
+    */
+    #define MPU9250_BUSY_ERR 4
+    
+    /**
+    *   @brief Error message returned when a transaction does not complete within its deadline.
+    */
+    #define MPU9250_TIMEOUT_ERR 5
+    
+    /**
+    *   @brief Error message returned when the FIFO overflowed and was reset.
+    */
+    #define MPU9250_FIFO_OVERFLOW_ERR 6
+    
+    /**
+    *   @brief Error message returned when the magnetometer has no new sample.
+    */
+    #define MPU9250_MAG_NOT_READY_ERR 7
+    
+    /**
+    *   @brief Error message returned when the magnetometer sample overflowed (ST2 HOFL).
+    */
+    #define MPU9250_MAG_OVERFLOW_ERR 8
+    
 #endif
 /* [] END OF FILE */
@@ -0,0 +1,553 @@
+/*
+ * @brief Function definitions for FIFO streaming.
+ *
+ * This file contains the definitions of the functions that can be used
+ * to stream samples through the FIFO of the MPU9250.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Fifo.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_Shadow.h"
+#include "MPU9250_Mount.h"
+#include "MPU9250_Stats.h"
+#include "CyLib.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_USER_CTRL_FIFO_EN
+    #define MPU9250_USER_CTRL_FIFO_EN 0x40   // FIFO enable bit of USER_CTRL
+#endif
+
+#ifndef MPU9250_USER_CTRL_FIFO_RST
+    #define MPU9250_USER_CTRL_FIFO_RST 0x04  // FIFO reset bit of USER_CTRL
+#endif
+
+#ifndef MPU9250_SLV3_FIFO_EN
+    #define MPU9250_SLV3_FIFO_EN 0x20        // Slave 3 FIFO enable bit of I2C_MST_CTRL
+#endif
+
+#ifndef MPU9250_DLPF_CFG_MASK
+    #define MPU9250_DLPF_CFG_MASK 0x07       // DLPF configuration bits of CONFIG
+#endif
+
+#ifndef MPU9250_FCHOICE_B_MASK
+    #define MPU9250_FCHOICE_B_MASK 0x03      // Fchoice_b bits of GYRO_CONFIG
+#endif
+
+#ifndef MPU9250_SLV_LENG_MASK
+    #define MPU9250_SLV_LENG_MASK 0x0F       // Number of bytes read from a slave
+#endif
+
+#define MPU9250_FIFO_MAX_WORDS 7  // Accelerometer, temperature and gyroscope words
+
+/* ========= VARIABLES ========= */
+static volatile uint8_t overflow_pending = 0;              // Overflow seen in an interrupt status
+static volatile MPU9250_Fifo_Loss loss = {0, 0};           // Loss counters
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t MPU9250_Fifo_SlaveLength(uint8_t ctrl_reg, uint16_t* size) {
+    // Add the number of bytes read from a slave to the frame size
+    uint8_t ctrl;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, ctrl_reg, &ctrl);
+    if (err == MPU9250_OK) {
+        *size += ctrl & MPU9250_SLV_LENG_MASK;
+    }
+    return err;
+}
+
+static uint8_t MPU9250_Fifo_ComputeLayout(uint8_t sources, MPU9250_Fifo_Layout* layout) {
+    uint8_t err = MPU9250_OK;
+    uint8_t mst_ctrl;
+    uint16_t ext = 0;
+
+    // Sensor words, in register order
+    layout->sources = sources;
+    layout->words = 0;
+    if (sources & MPU9250_FIFO_ACCEL)  layout->words += 3;
+    if (sources & MPU9250_FIFO_TEMP)   layout->words += 1;
+    if (sources & MPU9250_FIFO_GYRO_X) layout->words += 1;
+    if (sources & MPU9250_FIFO_GYRO_Y) layout->words += 1;
+    if (sources & MPU9250_FIFO_GYRO_Z) layout->words += 1;
+
+    // External sensor data, in slave order
+    if ((err == MPU9250_OK) && (sources & MPU9250_FIFO_SLV0))
+        err = MPU9250_Fifo_SlaveLength(MPU9250_I2C_SLV0_CTRL_REG, &ext);
+    if ((err == MPU9250_OK) && (sources & MPU9250_FIFO_SLV1))
+        err = MPU9250_Fifo_SlaveLength(MPU9250_I2C_SLV1_CTRL_REG, &ext);
+    if ((err == MPU9250_OK) && (sources & MPU9250_FIFO_SLV2))
+        err = MPU9250_Fifo_SlaveLength(MPU9250_I2C_SLV2_CTRL_REG, &ext);
+    if (err == MPU9250_OK)
+        err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_I2C_MST_CTRL_REG, &mst_ctrl);
+    if ((err == MPU9250_OK) && (mst_ctrl & MPU9250_SLV3_FIFO_EN))
+        err = MPU9250_Fifo_SlaveLength(MPU9250_I2C_SLV3_CTRL_REG, &ext);
+
+    layout->ext_size = ext;
+    layout->frame_size = 2 * layout->words + ext;
+    return err;
+}
+
+static uint8_t MPU9250_Fifo_Resync(uint16_t count, uint16_t frame_size) {
+    // The frames still in the FIFO are discarded, including the partial one
+    loss.overflows++;
+    loss.discarded_frames += (count + frame_size - 1) / frame_size;
+    // Reset the FIFO, so that the next frame starts at the beginning of the FIFO
+    return MPU9250_Fifo_Reset();
+}
+
+static uint32_t MPU9250_Fifo_SchedWait(uint32_t frames, uint32_t period_q8) {
+    // Time taken by the frames, saturated (at 256 ms per frame, 16 frames
+    // already overflow a 32 bit product in Q24.8)
+    uint64_t wait_us = ((uint64_t) frames * period_q8) >> 8;
+    return (wait_us > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (uint32_t) wait_us;
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Fifo_Enable(uint8_t sources) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    MPU9250_Fifo_Layout layout;
+    uint8_t err = MPU9250_Fifo_ComputeLayout(sources, &layout);
+    if (err != MPU9250_OK)
+        return err;
+    if (layout.frame_size == 0)
+        return MPU9250_UNKNOWN_ERR;
+
+    // Stop writing to the FIFO, then reset and enable it
+    overflow_pending = 0;
+    err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG,
+        MPU9250_USER_CTRL_FIFO_EN | MPU9250_USER_CTRL_FIFO_RST,
+        MPU9250_USER_CTRL_FIFO_EN | MPU9250_USER_CTRL_FIFO_RST);
+    if (err != MPU9250_OK)
+        return err;
+
+    // Select the sources
+    return MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, sources);
+}
+
+uint8_t MPU9250_Fifo_EnableMag(uint8_t sources) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    // Mirror the AK8963 into the external sensor data of slave 0
+    uint8_t err = MPU9250_Mag_StartMirror();
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Fifo_Enable(sources | MPU9250_FIFO_SLV0);
+}
+
+uint8_t MPU9250_Fifo_DisableMag(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    uint8_t sources;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, &sources);
+    if (err != MPU9250_OK)
+        return err;
+    err = MPU9250_Mag_StopMirror();
+    if (err != MPU9250_OK)
+        return err;
+
+    // The frame layout changes, so the FIFO is reset
+    sources &= ~MPU9250_FIFO_SLV0;
+    return sources ? MPU9250_Fifo_Enable(sources) : MPU9250_Fifo_Disable();
+}
+
+uint8_t MPU9250_Fifo_Disable(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    uint8_t err = MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, 0x00);
+    if (err != MPU9250_OK)
+        return err;
+    // Clear FIFO enable bit of USER_CTRL
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG,
+        MPU9250_USER_CTRL_FIFO_EN, 0x00);
+}
+
+uint8_t MPU9250_Fifo_Reset(void) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    overflow_pending = 0;
+    // Set FIFO reset bit of USER_CTRL, it is cleared by the device
+    return MPU9250_Shadow_UpdateBits(MPU9250_I2C_ADDRESS, MPU9250_USER_CTRL_REG,
+        MPU9250_USER_CTRL_FIFO_RST, MPU9250_USER_CTRL_FIFO_RST);
+}
+
+uint8_t MPU9250_Fifo_GetLayout(MPU9250_Fifo_Layout* layout) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    // Computed from the shadow copy of the registers, no bus access once cached
+    uint8_t sources;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_FIFO_EN_REG, &sources);
+    if (err != MPU9250_OK)
+        return err;
+    return MPU9250_Fifo_ComputeLayout(sources, layout);
+}
+
+uint8_t MPU9250_Fifo_GetFrameSize(uint16_t* size) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    MPU9250_Fifo_Layout layout;
+    uint8_t err = MPU9250_Fifo_GetLayout(&layout);
+    if (err == MPU9250_OK) {
+        *size = layout.frame_size;
+    }
+    return err;
+}
+
+uint8_t MPU9250_Fifo_GetCount(uint16_t* count) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_DRAIN);
+    uint8_t temp[2];
+    uint8_t err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_FIFO_COUNTH_REG, temp, 2);
+    if (err != MPU9250_OK)
+        return err;
+    // The count is 13 bits wide
+    *count = ((temp[0] & 0x1F) << 8) | temp[1];
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_Fifo_DrainCount(uint8_t* data, uint16_t max_frames, uint16_t* frames, uint16_t* fifo_count) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_DRAIN);
+    uint16_t frame_size;
+    uint16_t count;
+    uint8_t status;
+
+    *frames = 0;
+    *fifo_count = 0;
+    uint8_t err = MPU9250_Fifo_GetFrameSize(&frame_size);
+    if (err != MPU9250_OK)
+        return err;
+    if (frame_size == 0)
+        return MPU9250_UNKNOWN_ERR;
+
+    err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_INT_STATUS_REG, &status, 1);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_Fifo_CheckStatus(status);
+
+    err = MPU9250_Fifo_GetCount(&count);
+    if (err != MPU9250_OK)
+        return err;
+    *fifo_count = count;
+
+    // A full FIFO overflows with the next sample, even if the flag was already cleared
+    if (overflow_pending || count >= MPU9250_FIFO_SIZE) {
+        err = MPU9250_Fifo_Resync(count, frame_size);
+        return (err == MPU9250_OK) ? MPU9250_FIFO_OVERFLOW_ERR : err;
+    }
+
+    // Only whole frames are read
+    uint16_t available = count / frame_size;
+    if (available > max_frames)
+        available = max_frames;
+
+    // Each burst is made of whole frames
+    uint16_t per_burst = MPU9250_FIFO_MAX_BURST / frame_size;
+    while (*frames < available) {
+        uint16_t n = available - *frames;
+        if (n > per_burst)
+            n = per_burst;
+        err = MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_FIFO_R_W_REG, data, n * frame_size);
+        if (err != MPU9250_OK)
+            return err;
+        data += n * frame_size;
+        *frames += n;
+    }
+    return MPU9250_OK;
+}
+
+uint8_t MPU9250_Fifo_Drain(uint8_t* data, uint16_t max_frames, uint16_t* frames) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_DRAIN);
+    uint16_t count;
+    return MPU9250_Fifo_DrainCount(data, max_frames, frames, &count);
+}
+
+uint8_t MPU9250_Fifo_GetFramePeriod(uint32_t* period_q8) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    uint8_t div, config, gyro_config;
+    uint8_t err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, &div);
+    if (err == MPU9250_OK)
+        err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_CONFIG_REG, &config);
+    if (err == MPU9250_OK)
+        err = MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_GYRO_CONFIG_REG, &gyro_config);
+    if (err != MPU9250_OK)
+        return err;
+
+    uint8_t dlpf_cfg = config & MPU9250_DLPF_CFG_MASK;
+    if (gyro_config & MPU9250_FCHOICE_B_MASK) {
+        // DLPF bypassed: 32 kHz, divider not effective
+        *period_q8 = (1000UL << 8) / 32;
+    } else if (dlpf_cfg == 0 || dlpf_cfg == 7) {
+        // 8 kHz, divider not effective
+        *period_q8 = (1000UL << 8) / 8;
+    } else {
+        // 1 kHz / (1 + SMPLRT_DIV)
+        *period_q8 = (1000UL << 8) * (1 + div);
+    }
+    return MPU9250_OK;
+}
+
+void MPU9250_Fifo_SchedInit(MPU9250_Fifo_Sched* sched, uint16_t frame_size,
+                            uint32_t period_q8, uint8_t level) {
+    // Frames that fit in the FIFO, keeping the margin free
+    uint16_t capacity = (frame_size > 0) ? MPU9250_FIFO_SIZE / frame_size : 0;
+    capacity = (capacity > MPU9250_FIFO_SCHED_MARGIN + 1) ? capacity - MPU9250_FIFO_SCHED_MARGIN : 1;
+
+    sched->frame_size = frame_size;
+    sched->target = 1 + ((uint32_t) (capacity - 1) * level) / 255;
+    sched->period_q8 = period_q8;
+    sched->residual = 0;
+    sched->wait_us = MPU9250_Fifo_SchedWait(sched->target, period_q8);
+}
+
+uint8_t MPU9250_Fifo_SchedStart(MPU9250_Fifo_Sched* sched, uint8_t level) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    uint16_t frame_size;
+    uint32_t period_q8;
+    uint8_t err = MPU9250_Fifo_GetFrameSize(&frame_size);
+    if (err != MPU9250_OK)
+        return err;
+    if (frame_size == 0)
+        return MPU9250_UNKNOWN_ERR;
+    err = MPU9250_Fifo_GetFramePeriod(&period_q8);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_Fifo_SchedInit(sched, frame_size, period_q8, level);
+    return MPU9250_OK;
+}
+
+uint32_t MPU9250_Fifo_SchedUpdate(MPU9250_Fifo_Sched* sched, uint16_t count,
+                                  uint16_t drained, uint32_t elapsed_us) {
+    uint32_t arrived = (count > sched->residual) ? count - sched->residual : 0;
+
+    if (count >= MPU9250_FIFO_SIZE) {
+        // Overflow: the FIFO was reset and the count saturated, so the period
+        // is at most the observed one. Also make sure the estimate shrinks.
+        uint64_t observed = ((uint64_t) elapsed_us * sched->frame_size << 8) / MPU9250_FIFO_SIZE;
+        sched->period_q8 = (observed < sched->period_q8) ? (uint32_t) observed : sched->period_q8;
+        sched->period_q8 -= sched->period_q8 >> MPU9250_FIFO_SCHED_GAIN_SHIFT;
+        sched->residual = 0;
+    } else {
+        if (arrived > 0 && elapsed_us > 0) {
+            // Filter the period observed since the previous drain, limited to twice the estimate
+            uint64_t observed = ((uint64_t) elapsed_us * sched->frame_size << 8) / arrived;
+            if (observed > 2 * (uint64_t) sched->period_q8)
+                observed = 2 * (uint64_t) sched->period_q8;
+            sched->period_q8 += ((int32_t) observed - (int32_t) sched->period_q8) >> MPU9250_FIFO_SCHED_GAIN_SHIFT;
+        }
+        sched->residual = count - drained * sched->frame_size;
+    }
+
+    // Wait for the frames missing to the target
+    uint16_t left = sched->residual / sched->frame_size;
+    uint16_t missing = (sched->target > left) ? sched->target - left : 1;
+    sched->wait_us = MPU9250_Fifo_SchedWait(missing, sched->period_q8);
+    return sched->wait_us;
+}
+
+uint8_t MPU9250_Fifo_SchedDrain(MPU9250_Fifo_Sched* sched, uint8_t* data, uint16_t max_frames,
+                                uint16_t* frames, uint32_t elapsed_us) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_DRAIN);
+    uint16_t count;
+    uint8_t err = MPU9250_Fifo_DrainCount(data, max_frames, frames, &count);
+    if (err == MPU9250_OK) {
+        MPU9250_Fifo_SchedUpdate(sched, count, *frames, elapsed_us);
+    } else if (err == MPU9250_FIFO_OVERFLOW_ERR) {
+        // The FIFO was reset: update as if it saturated
+        MPU9250_Fifo_SchedUpdate(sched, MPU9250_FIFO_SIZE, 0, elapsed_us);
+    }
+    return err;
+}
+
+void MPU9250_Fifo_ClockInit(MPU9250_Fifo_Clock* clock, uint16_t frame_size, uint32_t nominal_q8) {
+    clock->frame_size = frame_size;
+    clock->nominal_q8 = nominal_q8;
+    clock->period_q8 = nominal_q8;
+    clock->next_us = 0;
+    clock->next_frac = 0;
+    clock->span = 0;
+    clock->locked = 0;
+}
+
+uint8_t MPU9250_Fifo_ClockStart(MPU9250_Fifo_Clock* clock) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_CONFIG);
+    uint16_t frame_size;
+    uint32_t period_q8;
+    uint8_t err = MPU9250_Fifo_GetFrameSize(&frame_size);
+    if (err != MPU9250_OK)
+        return err;
+    if (frame_size == 0)
+        return MPU9250_UNKNOWN_ERR;
+    err = MPU9250_Fifo_GetFramePeriod(&period_q8);
+    if (err != MPU9250_OK)
+        return err;
+    MPU9250_Fifo_ClockInit(clock, frame_size, period_q8);
+    return MPU9250_OK;
+}
+
+void MPU9250_Fifo_ClockResync(MPU9250_Fifo_Clock* clock) {
+    clock->locked = 0;
+}
+
+static void MPU9250_Fifo_ClockAdvance(MPU9250_Fifo_Clock* clock, int64_t delta_q8) {
+    // Move the time of the next frame by delta_q8 (Q56.8): at the slowest
+    // rates, the frames in the FIFO span more than the 8 s of a Q24.8
+    int64_t total = clock->next_frac + delta_q8;
+    clock->next_us += (uint32_t) (total >> 8);
+    clock->next_frac = total & 0xFF;
+}
+
+void MPU9250_Fifo_ClockUpdate(MPU9250_Fifo_Clock* clock, uint32_t drain_us, uint16_t count,
+                              uint16_t frames, uint32_t* timestamps) {
+    uint16_t available = count / clock->frame_size;
+    if (available == 0)
+        return;
+
+    if (!clock->locked) {
+        // No prediction yet: measure from the drain time
+        clock->next_us = drain_us;
+        clock->next_frac = 0;
+    }
+
+    // Measured time of the oldest frame in the FIFO, relative to the predicted one.
+    // The newest frame was written, on average, half a period before the drain.
+    int64_t span_q8 = (int64_t) ((uint64_t) (2 * available - 1) * clock->period_q8 / 2);
+    int64_t error_q8 = (int64_t) (int32_t) (drain_us - clock->next_us) * 256 - clock->next_frac - span_q8;
+
+    // An error beyond the frames in the FIFO means that the prediction is
+    // lost (e.g. frames were dropped): measure again, as when unlocked
+    if (clock->locked && ((error_q8 > span_q8 + clock->period_q8) || (error_q8 < -span_q8 - clock->period_q8))) {
+        error_q8 = -span_q8;
+        clock->next_us = drain_us;
+        clock->next_frac = 0;
+        clock->locked = 0;
+    }
+
+    if (!clock->locked) {
+        // No prediction yet: take the measured time
+        MPU9250_Fifo_ClockAdvance(clock, error_q8);
+        clock->locked = 1;
+    } else {
+        // Correct the phase, and the period with the error accumulated over the last frames
+        MPU9250_Fifo_ClockAdvance(clock, error_q8 >> MPU9250_FIFO_CLOCK_PHASE_SHIFT);
+        if (clock->span > 0) {
+            int64_t period_q8 = (int64_t) clock->period_q8
+                + ((error_q8 / clock->span) >> MPU9250_FIFO_CLOCK_PERIOD_SHIFT);
+            int64_t range_q8 = clock->nominal_q8 >> MPU9250_FIFO_CLOCK_RANGE_SHIFT;
+            if (period_q8 > (int64_t) clock->nominal_q8 + range_q8)
+                period_q8 = (int64_t) clock->nominal_q8 + range_q8;
+            if (period_q8 < (int64_t) clock->nominal_q8 - range_q8)
+                period_q8 = (int64_t) clock->nominal_q8 - range_q8;
+            clock->period_q8 = (uint32_t) period_q8;
+        }
+    }
+
+    // Tag the frames read, oldest first
+    for (uint16_t i = 0; i < frames; i++) {
+        if (timestamps != NULL) {
+            timestamps[i] = clock->next_us + ((clock->next_frac + 128) >> 8);
+        }
+        MPU9250_Fifo_ClockAdvance(clock, clock->period_q8);
+    }
+    clock->span = frames;
+}
+
+uint8_t MPU9250_Fifo_TimedDrain(MPU9250_Fifo_Clock* clock, uint8_t* data, uint16_t max_frames,
+                                uint16_t* frames, uint32_t drain_us, uint32_t* timestamps) {
+    MPU9250_STATS_API(MPU9250_STATS_API_FIFO_DRAIN);
+    uint16_t count;
+    uint8_t err = MPU9250_Fifo_DrainCount(data, max_frames, frames, &count);
+    if (err == MPU9250_OK) {
+        MPU9250_Fifo_ClockUpdate(clock, drain_us, count, *frames, timestamps);
+    } else if (err == MPU9250_FIFO_OVERFLOW_ERR) {
+        // Frames were lost: the time of the next one is unknown
+        MPU9250_Fifo_ClockResync(clock);
+    }
+    return err;
+}
+
+void MPU9250_Fifo_CheckStatus(uint8_t status) {
+    if (status & MPU9250_INT_FIFO_OVERFLOW) {
+        overflow_pending = 1;
+    }
+}
+
+void MPU9250_Fifo_GetLoss(MPU9250_Fifo_Loss* fifo_loss) {
+    uint8_t interruptState = CyEnterCriticalSection();
+    fifo_loss->overflows = loss.overflows;
+    fifo_loss->discarded_frames = loss.discarded_frames;
+    CyExitCriticalSection(interruptState);
+}
+
+void MPU9250_Fifo_ResetLoss(void) {
+    uint8_t interruptState = CyEnterCriticalSection();
+    loss.overflows = 0;
+    loss.discarded_frames = 0;
+    CyExitCriticalSection(interruptState);
+}
+
+void MPU9250_Fifo_Decode(const MPU9250_Fifo_Layout* layout, const uint8_t* data,
+                         uint16_t frames, const MPU9250_Fifo_Samples* samples) {
+    int16_t* dst[MPU9250_FIFO_MAX_WORDS];   // Destination of each word
+    uint8_t step[MPU9250_FIFO_MAX_WORDS];   // 1 if the word is stored, 0 if discarded
+    int16_t discard;                        // Destination of discarded words
+    uint8_t w = 0;
+#if MPU9250_MOUNT_FLIPS
+    int16_t flip[MPU9250_FIFO_MAX_WORDS];   // -1 if the word is negated, 0 otherwise
+    #define MPU9250_FIFO_FLIP(sign) flip[w] = ((sign) < 0) ? -1 : 0
+#else
+    #define MPU9250_FIFO_FLIP(sign)
+#endif
+
+    // Map the words of a frame to their destination arrays: each sensor
+    // axis goes to the array of its body axis, so the remap costs nothing per word
+    #define MPU9250_FIFO_MAP(array, sign) \
+        do { dst[w] = (array) != NULL ? (array) : &discard; step[w] = (array) != NULL; \
+             MPU9250_FIFO_FLIP(sign); w++; } while (0)
+    if (layout->sources & MPU9250_FIFO_ACCEL) {
+        MPU9250_FIFO_MAP(samples->acc[MPU9250_MOUNT_BODY_AXIS(0)], MPU9250_MOUNT_BODY_SIGN(0));
+        MPU9250_FIFO_MAP(samples->acc[MPU9250_MOUNT_BODY_AXIS(1)], MPU9250_MOUNT_BODY_SIGN(1));
+        MPU9250_FIFO_MAP(samples->acc[MPU9250_MOUNT_BODY_AXIS(2)], MPU9250_MOUNT_BODY_SIGN(2));
+    }
+    if (layout->sources & MPU9250_FIFO_TEMP)
+        MPU9250_FIFO_MAP(samples->temp, 1);
+    if (layout->sources & MPU9250_FIFO_GYRO_X)
+        MPU9250_FIFO_MAP(samples->gyro[MPU9250_MOUNT_BODY_AXIS(0)], MPU9250_MOUNT_BODY_SIGN(0));
+    if (layout->sources & MPU9250_FIFO_GYRO_Y)
+        MPU9250_FIFO_MAP(samples->gyro[MPU9250_MOUNT_BODY_AXIS(1)], MPU9250_MOUNT_BODY_SIGN(1));
+    if (layout->sources & MPU9250_FIFO_GYRO_Z)
+        MPU9250_FIFO_MAP(samples->gyro[MPU9250_MOUNT_BODY_AXIS(2)], MPU9250_MOUNT_BODY_SIGN(2));
+    #undef MPU9250_FIFO_MAP
+    #undef MPU9250_FIFO_FLIP
+
+#if MPU9250_MOUNT_FLIPS
+    // Negation without branches: (v ^ -1) - (-1) = -v
+    #define MPU9250_FIFO_WORD(i, v) ((int16_t) (((v) ^ flip[i]) - flip[i]))
+#else
+    #define MPU9250_FIFO_WORD(i, v) ((int16_t) (v))
+#endif
+
+    for (uint16_t f = 0; f < frames; f++, data += layout->frame_size) {
+        uint8_t i = 0;
+
+        // Two big-endian words at a time: one unaligned load, one REV16
+        for (; i + 1 < w; i += 2) {
+            uint32_t pair;
+            memcpy(&pair, data + 2 * i, sizeof(pair));
+            pair = __REV16(pair);
+            *dst[i] = MPU9250_FIFO_WORD(i, (int16_t) pair);
+            *dst[i + 1] = MPU9250_FIFO_WORD(i + 1, (int16_t) (pair >> 16));
+            dst[i] += step[i];
+            dst[i + 1] += step[i + 1];
+        }
+        // Odd word left
+        if (i < w) {
+            *dst[i] = MPU9250_FIFO_WORD(i, (int16_t) ((data[2 * i] << 8) | data[2 * i + 1]));
+            dst[i] += step[i];
+        }
+        // External sensor data are copied as they are, their format depends on the slave
+        if ((layout->ext_size > 0) && (samples->ext != NULL)) {
+            memcpy(samples->ext + (uint32_t) f * layout->ext_size, data + 2 * w, layout->ext_size);
+        }
+    }
+    #undef MPU9250_FIFO_WORD
+}
+/* [] END OF FILE */
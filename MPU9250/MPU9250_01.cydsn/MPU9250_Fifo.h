@@ -0,0 +1,486 @@
+/** @file MPU9250_Fifo.h
+ * @brief Header file for FIFO streaming.
+ *
+ * This header file contains macros and function prototypes to stream
+ * samples through the 512 bytes FIFO of the MPU9250. The selected sources
+ * (see the MPU9250_FIFO_* macros of MPU9250.h) are written to the FIFO at
+ * the sample rate, in frames ordered as their data registers: accelerometer,
+ * temperature, gyroscope x/y/z, external sensor data of slaves 0 to 3.
+ * The application wakes up every now and then, reads the FIFO count and
+ * drains all the whole frames with long burst reads of #MPU9250_FIFO_R_W_REG.
+ *
+ * The magnetometer can be added to the frames: the internal I2C master of
+ * the MPU9250 reads the AK8963 at each sample through slave 0, so a frame
+ * carries accelerometer, temperature, gyroscope and magnetometer data
+ * sampled together, with no extra transaction on the bus.
+ *
+ * When the FIFO overflows the device overwrites the oldest bytes, so the
+ * stream is no longer aligned to frame boundaries. The drain detects the
+ * overflow, resets the FIFO to realign the stream and counts the event and
+ * the discarded frames, so that the gap can be accounted for.
+ *
+ * The MPU9250 has no FIFO watermark interrupt. The drain scheduler plays
+ * its role: it predicts the fill rate from the sample rate and the frame
+ * size, tells the application how long to wait before the next drain so
+ * that the FIFO reaches a target level, and refines its prediction from
+ * the FIFO count observed at each drain. The scheduler functions that do
+ * not access the bus can be fed with a simulated FIFO.
+ *
+ * Frames carry no timestamp. The sample clock tags each drained frame with
+ * a time of the MCU timebase, from the drain time, the FIFO count and the
+ * frame period. The period starts from the nominal one and follows the
+ * real output rate of the sensor, whose internal oscillator drifts by a
+ * few percent with respect to the MCU clock.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_FIFO_H_
+
+    #define __MPU9250_FIFO_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Size of the FIFO, in bytes.
+    */
+    #define MPU9250_FIFO_SIZE 512
+
+    /**
+    * @brief Maximum number of bytes of a single burst read of the FIFO.
+    *
+    * Longer drains are split in several bursts, each made of whole frames.
+    */
+    #ifndef MPU9250_FIFO_MAX_BURST
+        #define MPU9250_FIFO_MAX_BURST 255
+    #endif
+
+    /**
+    * @brief Number of magnetometer bytes in a frame.
+    *
+    * AK8963 registers from ST1 to ST2: ST1, HXL, HXH, HYL, HYH, HZL, HZH, ST2.
+    */
+    #define MPU9250_FIFO_MAG_SIZE 8  // MPU9250_MAG_MIRROR_SIZE
+
+    /**
+    * @brief Frames kept free in the FIFO by the drain scheduler.
+    *
+    * Margin for the jitter of the application wake up.
+    */
+    #ifndef MPU9250_FIFO_SCHED_MARGIN
+        #define MPU9250_FIFO_SCHED_MARGIN 2
+    #endif
+
+    /**
+    * @brief Gain of the frame period estimate of the drain scheduler.
+    *
+    * Each observation moves the estimate by 1 / 2^#MPU9250_FIFO_SCHED_GAIN_SHIFT
+    * of the error.
+    */
+    #ifndef MPU9250_FIFO_SCHED_GAIN_SHIFT
+        #define MPU9250_FIFO_SCHED_GAIN_SHIFT 3
+    #endif
+
+    /**
+    * @brief Phase gain of the sample clock.
+    *
+    * Each drain moves the timestamps by 1 / 2^#MPU9250_FIFO_CLOCK_PHASE_SHIFT
+    * of the error between predicted and measured time.
+    */
+    #ifndef MPU9250_FIFO_CLOCK_PHASE_SHIFT
+        #define MPU9250_FIFO_CLOCK_PHASE_SHIFT 2
+    #endif
+
+    /**
+    * @brief Frequency gain of the sample clock.
+    *
+    * Each drain moves the period by 1 / 2^#MPU9250_FIFO_CLOCK_PERIOD_SHIFT
+    * of the error per frame.
+    */
+    #ifndef MPU9250_FIFO_CLOCK_PERIOD_SHIFT
+        #define MPU9250_FIFO_CLOCK_PERIOD_SHIFT 4
+    #endif
+
+    /**
+    * @brief Maximum deviation of the period from the nominal one, as a power of 2.
+    *
+    * The period is kept within 1 / 2^#MPU9250_FIFO_CLOCK_RANGE_SHIFT of the nominal one.
+    */
+    #ifndef MPU9250_FIFO_CLOCK_RANGE_SHIFT
+        #define MPU9250_FIFO_CLOCK_RANGE_SHIFT 3
+    #endif
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Layout of a FIFO frame.
+    */
+    typedef struct {
+        /** Sources written to the FIFO (#MPU9250_FIFO_EN_REG) **/
+        uint8_t sources;
+        /** Size of a frame, in bytes **/
+        uint8_t frame_size;
+        /** Number of 16 bit big-endian words at the beginning of a frame **/
+        uint8_t words;
+        /** Number of bytes of external sensor data, after the words **/
+        uint8_t ext_size;
+    } MPU9250_Fifo_Layout;
+
+    /**
+    * @brief Decoded FIFO samples, one array per axis.
+    *
+    * Arrays of sources that are not needed can be NULL.
+    */
+    typedef struct {
+        /** Accelerometer x, y and z **/
+        int16_t* acc[3];
+        /** Temperature **/
+        int16_t* temp;
+        /** Gyroscope x, y and z **/
+        int16_t* gyro[3];
+        /** Raw external sensor data, #MPU9250_Fifo_Layout ext_size bytes per frame **/
+        uint8_t* ext;
+    } MPU9250_Fifo_Samples;
+
+    /**
+    * @brief FIFO loss counters.
+    */
+    typedef struct {
+        /** Number of overflows **/
+        uint32_t overflows;
+        /**
+        * Number of frames discarded by the driver when resetting the FIFO after
+        * an overflow. The frames overwritten by the device while the FIFO was
+        * full are lost before they can be counted, and are not included.
+        **/
+        uint32_t discarded_frames;
+    } MPU9250_Fifo_Loss;
+
+    /**
+    * @brief State of the drain scheduler.
+    */
+    typedef struct {
+        /** Size of a frame, in bytes **/
+        uint16_t frame_size;
+        /** Target number of frames in the FIFO at each drain **/
+        uint16_t target;
+        /** Estimated time between two frames, in us (Q24.8) **/
+        uint32_t period_q8;
+        /** Bytes left in the FIFO after the last drain **/
+        uint16_t residual;
+        /** Time to wait before the next drain, in us **/
+        uint32_t wait_us;
+    } MPU9250_Fifo_Sched;
+
+    /**
+    * @brief State of the sample clock.
+    */
+    typedef struct {
+        /** Size of a frame, in bytes **/
+        uint16_t frame_size;
+        /** Nominal time between two frames, in us (Q24.8) **/
+        uint32_t nominal_q8;
+        /** Estimated time between two frames, in us (Q24.8) **/
+        uint32_t period_q8;
+        /** Time of the next frame, in us **/
+        uint32_t next_us;
+        /** Fractional part of the time of the next frame (Q0.8) **/
+        uint8_t next_frac;
+        /** Frames tagged by the last update **/
+        uint16_t span;
+        /** Time of the next frame known (1) or to be measured (0) **/
+        uint8_t locked;
+    } MPU9250_Fifo_Clock;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Enable the FIFO.
+    *
+    * This function resets the FIFO, enables it and selects the sources
+    * written to it. The FIFO can also be enabled through the fifo_sources
+    * field of #MPU9250_Config.
+    * @param[in] sources: OR of the MPU9250_FIFO_* sources of MPU9250.h.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if no source is selected.
+    */
+    uint8_t MPU9250_Fifo_Enable(uint8_t sources);
+
+    /**
+    * @brief Enable the FIFO with the magnetometer in the frames.
+    *
+    * This function starts the magnetometer mirror (#MPU9250_Mag_StartMirror)
+    * and enables the FIFO with the given sources plus slave 0, so the last
+    * #MPU9250_FIFO_MAG_SIZE bytes of each frame are the magnetometer data.
+    * While enabled, the AK8963 is not reachable from the bus (e.g. with #MPU9250_ReadMag).
+    * @param[in] sources: OR of the MPU9250_FIFO_* sources of MPU9250.h.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the AK8963 does not answer the internal I2C master.
+    * @retval #MPU9250_TIMEOUT_ERR if the internal I2C master does not complete the write.
+    */
+    uint8_t MPU9250_Fifo_EnableMag(uint8_t sources);
+
+    /**
+    * @brief Remove the magnetometer from the frames.
+    *
+    * This function stops the magnetometer mirror (#MPU9250_Mag_StopMirror). The FIFO is reset
+    * and keeps the other sources, if any.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_DEV_NOT_FOUND_ERR if the AK8963 does not answer the internal I2C master.
+    * @retval #MPU9250_TIMEOUT_ERR if the internal I2C master does not complete the write.
+    */
+    uint8_t MPU9250_Fifo_DisableMag(void);
+
+    /**
+    * @brief Disable the FIFO.
+    *
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_Disable(void);
+
+    /**
+    * @brief Reset the FIFO, discarding its content.
+    *
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_Reset(void);
+
+    /**
+    * @brief Get the layout of the FIFO frames.
+    *
+    * The layout is computed from the selected sources and, for the slaves,
+    * from the length set in their control registers.
+    * @param[out] layout: layout of the frames.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_GetLayout(MPU9250_Fifo_Layout* layout);
+
+    /**
+    * @brief Get the size of a FIFO frame.
+    *
+    * The size is computed from the selected sources and, for the slaves,
+    * from the length set in their control registers.
+    * @param[out] size: size of a frame, in bytes.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_GetFrameSize(uint16_t* size);
+
+    /**
+    * @brief Read the number of bytes in the FIFO.
+    *
+    * @param[out] count: number of bytes in the FIFO.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_GetCount(uint16_t* count);
+
+    /**
+    * @brief Drain whole frames from the FIFO.
+    *
+    * This function reads the FIFO count and then reads up to max_frames
+    * whole frames, with bursts of at most #MPU9250_FIFO_MAX_BURST bytes.
+    * Before that, it reads #MPU9250_INT_STATUS_REG: if the FIFO overflowed,
+    * or if it is full, the FIFO is reset and no frame is read. Reading
+    * #MPU9250_INT_STATUS_REG clears the other interrupt flags too; if the
+    * application reads it elsewhere, it should pass it to #MPU9250_Fifo_CheckStatus.
+    * @param[out] data: buffer of at least max_frames frames.
+    * @param[in] max_frames: maximum number of frames to be read.
+    * @param[out] frames: number of frames read.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if no source is selected.
+    * @retval #MPU9250_FIFO_OVERFLOW_ERR if the FIFO overflowed: samples were lost
+    *         between the previous drain and the next one.
+    */
+    uint8_t MPU9250_Fifo_Drain(uint8_t* data, uint16_t max_frames, uint16_t* frames);
+
+    /**
+    * @brief Drain whole frames from the FIFO and get the FIFO count.
+    *
+    * Same as #MPU9250_Fifo_Drain, it also returns the FIFO count read before
+    * draining, to be passed to #MPU9250_Fifo_SchedUpdate and #MPU9250_Fifo_ClockUpdate.
+    * @param[out] data: buffer of at least max_frames frames.
+    * @param[in] max_frames: maximum number of frames to be read.
+    * @param[out] frames: number of frames read.
+    * @param[out] count: FIFO count, in bytes.
+    * @return Same values of #MPU9250_Fifo_Drain.
+    */
+    uint8_t MPU9250_Fifo_DrainCount(uint8_t* data, uint16_t max_frames, uint16_t* frames, uint16_t* count);
+
+    /**
+    * @brief Get the time between two FIFO frames.
+    *
+    * The time is computed from the shadow copy of #MPU9250_SMPLRT_DIV_REG,
+    * #MPU9250_CONFIG_REG and #MPU9250_GYRO_CONFIG_REG.
+    * @param[out] period_q8: time between two frames, in us (Q24.8).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    */
+    uint8_t MPU9250_Fifo_GetFramePeriod(uint32_t* period_q8);
+
+    /**
+    * @brief Initialize the drain scheduler.
+    *
+    * This function does not access the bus.
+    * @param[out] sched: scheduler.
+    * @param[in] frame_size: size of a frame, in bytes.
+    * @param[in] period_q8: expected time between two frames, in us (Q24.8).
+    * @param[in] level: target fill level, from 0 (drain at each frame, lowest
+    *            latency) to 255 (drain when the FIFO is almost full, fewest
+    *            transactions per sample).
+    */
+    void MPU9250_Fifo_SchedInit(MPU9250_Fifo_Sched* sched, uint16_t frame_size,
+                                uint32_t period_q8, uint8_t level);
+
+    /**
+    * @brief Start the drain scheduler for the current FIFO configuration.
+    *
+    * @param[out] sched: scheduler.
+    * @param[in] level: target fill level, see #MPU9250_Fifo_SchedInit.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if no source is selected.
+    */
+    uint8_t MPU9250_Fifo_SchedStart(MPU9250_Fifo_Sched* sched, uint8_t level);
+
+    /**
+    * @brief Update the drain scheduler with the result of a drain.
+    *
+    * This function refines the frame period from the bytes written to the FIFO
+    * since the previous drain and computes the time to wait before the next one
+    * (wait_us field). It does not access the bus.
+    * @param[in,out] sched: scheduler.
+    * @param[in] count: FIFO count read by the drain, in bytes.
+    * @param[in] drained: number of frames read by the drain.
+    * @param[in] elapsed_us: time since the previous drain, in us.
+    * @return Time to wait before the next drain, in us.
+    */
+    uint32_t MPU9250_Fifo_SchedUpdate(MPU9250_Fifo_Sched* sched, uint16_t count,
+                                      uint16_t drained, uint32_t elapsed_us);
+
+    /**
+    * @brief Drain the FIFO and update the drain scheduler.
+    *
+    * Same as #MPU9250_Fifo_Drain, followed by #MPU9250_Fifo_SchedUpdate.
+    * @param[in,out] sched: scheduler.
+    * @param[out] data: buffer of at least max_frames frames.
+    * @param[in] max_frames: maximum number of frames to be read.
+    * @param[out] frames: number of frames read.
+    * @param[in] elapsed_us: time since the previous drain, in us.
+    * @return Same values of #MPU9250_Fifo_Drain.
+    */
+    uint8_t MPU9250_Fifo_SchedDrain(MPU9250_Fifo_Sched* sched, uint8_t* data, uint16_t max_frames,
+                                    uint16_t* frames, uint32_t elapsed_us);
+
+    /**
+    * @brief Check an interrupt status for FIFO overflow.
+    *
+    * The overflow is handled at the next #MPU9250_Fifo_Drain.
+    * @param[in] status: value of #MPU9250_INT_STATUS_REG read by the application.
+    */
+    void MPU9250_Fifo_CheckStatus(uint8_t status);
+
+    /**
+    * @brief Get the loss counters.
+    *
+    * @param[out] loss: counters since start or since the last #MPU9250_Fifo_ResetLoss.
+    */
+    void MPU9250_Fifo_GetLoss(MPU9250_Fifo_Loss* loss);
+
+    /**
+    * @brief Reset the loss counters.
+    */
+    void MPU9250_Fifo_ResetLoss(void);
+
+    /**
+    * @brief Initialize the sample clock.
+    *
+    * This function does not access the bus.
+    * @param[out] clock: sample clock.
+    * @param[in] frame_size: size of a frame, in bytes.
+    * @param[in] nominal_q8: nominal time between two frames, in us (Q24.8).
+    */
+    void MPU9250_Fifo_ClockInit(MPU9250_Fifo_Clock* clock, uint16_t frame_size, uint32_t nominal_q8);
+
+    /**
+    * @brief Start the sample clock for the current FIFO configuration.
+    *
+    * @param[out] clock: sample clock.
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_I2C_ERR if error in I2C communication.
+    * @retval #MPU9250_UNKNOWN_ERR if no source is selected.
+    */
+    uint8_t MPU9250_Fifo_ClockStart(MPU9250_Fifo_Clock* clock);
+
+    /**
+    * @brief Restart the timestamps from the next drain.
+    *
+    * To be called when frames were lost (e.g. after an overflow): the estimated
+    * period is kept, the time of the next frame is measured again.
+    * @param[in,out] clock: sample clock.
+    */
+    void MPU9250_Fifo_ClockResync(MPU9250_Fifo_Clock* clock);
+
+    /**
+    * @brief Tag drained frames with their timestamps.
+    *
+    * The oldest frame in the FIFO is measured to be written (count / frame_size - 1/2)
+    * periods before the drain. The difference with the predicted time corrects
+    * both the time of the frames and the period. An error larger than the frames in
+    * the FIFO restarts the timestamps from the measured time, as
+    * #MPU9250_Fifo_ClockResync. This function does not access the bus.
+    * @param[in,out] clock: sample clock.
+    * @param[in] drain_us: time of the drain, in us of the MCU timebase.
+    * @param[in] count: FIFO count read by the drain, in bytes.
+    * @param[in] frames: number of frames read by the drain.
+    * @param[out] timestamps: time of each frame, in us of the MCU timebase. Can be NULL.
+    */
+    void MPU9250_Fifo_ClockUpdate(MPU9250_Fifo_Clock* clock, uint32_t drain_us, uint16_t count,
+                                  uint16_t frames, uint32_t* timestamps);
+
+    /**
+    * @brief Drain the FIFO and tag the frames with their timestamps.
+    *
+    * Same as #MPU9250_Fifo_DrainCount, followed by #MPU9250_Fifo_ClockUpdate. The
+    * clock is resynchronized after an overflow.
+    * @param[in,out] clock: sample clock.
+    * @param[out] data: buffer of at least max_frames frames.
+    * @param[in] max_frames: maximum number of frames to be read.
+    * @param[out] frames: number of frames read.
+    * @param[in] drain_us: time of the call, in us of the MCU timebase.
+    * @param[out] timestamps: time of each frame, at least max_frames elements. Can be NULL.
+    * @return Same values of #MPU9250_Fifo_Drain.
+    */
+    uint8_t MPU9250_Fifo_TimedDrain(MPU9250_Fifo_Clock* clock, uint8_t* data, uint16_t max_frames,
+                                    uint16_t* frames, uint32_t drain_us, uint32_t* timestamps);
+
+    /**
+    * @brief Decode FIFO frames into per-axis arrays.
+    *
+    * This function converts a batch of frames, as read by #MPU9250_Fifo_Drain,
+    * into separate arrays for each axis. Pairs of big-endian words are
+    * swapped with a single REV16 instruction. The accelerometer and gyroscope
+    * arrays are in the body axes (see MPU9250_Mount.h).
+    * @param[in] layout: layout of the frames.
+    * @param[in] data: frames to be decoded.
+    * @param[in] frames: number of frames.
+    * @param[out] samples: arrays of at least frames elements.
+    */
+    void MPU9250_Fifo_Decode(const MPU9250_Fifo_Layout* layout, const uint8_t* data,
+                             uint16_t frames, const MPU9250_Fifo_Samples* samples);
+
+#endif
+/* [] END OF FILE */
@@ -4,33 +4,226 @@
  * This file contains the definitions of the functions that can be used
  * to interface with the MPU9250 through the I2C protocol.
  *
+ * Transfers are carried out with the buffer functions of the I2C master
+ * component (MasterWriteBuf and MasterReadBuf), whose completion is polled
+ * against a deadline, so that a slave that does not answer or that holds
+ * the bus costs a known, capped amount of time. When a deadline expires,
+ * or when the bus is found busy, the bus recovery sequence is performed.
+ *
  * @date January 19, 2019
  * @author Davide Marzorati
  */
 
 #include "MPU9250_I2C.h"
+#include "MPU9250_I2C_Async.h"
+#include "MPU9250_Stats.h"
+#include "SCL_1.h"
+#include "SDA_1.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_I2C_POLL_US
+    #define MPU9250_I2C_POLL_US 10  // Polling period of the transfer status
+#endif
+
+#ifndef MPU9250_I2C_RECOVERY_HALF_PERIOD_US
+    #define MPU9250_I2C_RECOVERY_HALF_PERIOD_US 5  // SCL half period during bus recovery (100 kHz)
+#endif
+
+#define MPU9250_I2C_ERR_MASK (I2C_MPU9250_Master_MSTAT_ERR_SHORT_XFER | \
+                              I2C_MPU9250_Master_MSTAT_ERR_ADDR_NAK   | \
+                              I2C_MPU9250_Master_MSTAT_ERR_ARB_LOST   | \
+                              I2C_MPU9250_Master_MSTAT_ERR_XFER)
+
+/* ========= VARIABLES ========= */
+static uint16_t timeout_us = MPU9250_I2C_TIMEOUT_US;  // Per-transaction deadline
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t MPU9250_I2C_Acquire(void) {
+    // Wait for the pending non-blocking requests to complete, then take
+    // the bus, so that no request is started in the middle of the transaction.
+    // Each queued request ends within its deadline, counted while waiting:
+    // the wait is bounded by the deadlines of a full queue.
+    uint32_t remaining = (uint32_t) timeout_us * (MPU9250_I2C_ASYNC_QUEUE_SIZE + 1);
+    while (MPU9250_I2C_Async_Acquire() != MPU9250_OK) {
+        if (remaining < MPU9250_I2C_POLL_US)
+            return MPU9250_BUSY_ERR;
+        CyDelayUs(MPU9250_I2C_POLL_US);
+        MPU9250_I2C_Async_Tick(MPU9250_I2C_POLL_US);
+        remaining -= MPU9250_I2C_POLL_US;
+    }
+    return MPU9250_OK;
+}
+
+static uint8_t MPU9250_I2C_Wait(uint8_t flag, uint16_t* remaining) {
+    // Wait for the transfer to set the completion flag, an error flag or
+    // for the deadline to expire.
+    for (;;) {
+        uint8_t status = I2C_MPU9250_Master_MasterStatus();
+        if (status & I2C_MPU9250_Master_MSTAT_ERR_ADDR_NAK)
+            return MPU9250_DEV_NOT_FOUND_ERR;
+        if (status & MPU9250_I2C_ERR_MASK)
+            return MPU9250_I2C_ERR;
+        if (status & flag)
+            return MPU9250_OK;
+        if (*remaining < MPU9250_I2C_POLL_US) {
+            MPU9250_I2C_RecoverBus();
+            return MPU9250_TIMEOUT_ERR;
+        }
+        CyDelayUs(MPU9250_I2C_POLL_US);
+        *remaining -= MPU9250_I2C_POLL_US;
+    }
+}
+
+static uint8_t MPU9250_I2C_Xfer(uint8_t address, uint8_t direction, uint8_t* data, uint16_t count,
+                                uint8_t mode, uint16_t* remaining) {
+    // Perform a single transfer in the given direction and wait for its completion,
+    // within the time remaining before the deadline of the transaction
+    uint8_t err;
+
+    I2C_MPU9250_Master_MasterClearStatus();
+    if (direction == MPU9250_I2C_SEGMENT_READ) {
+        err = I2C_MPU9250_Master_MasterReadBuf(address, data, count, mode);
+    } else {
+        err = I2C_MPU9250_Master_MasterWriteBuf(address, data, count, mode);
+    }
+    if (err == I2C_MPU9250_Master_MSTR_BUS_BUSY) {
+        // A slave is holding the bus
+        MPU9250_I2C_RecoverBus();
+        return MPU9250_I2C_ERR;
+    } else if (err != I2C_MPU9250_Master_MSTR_NO_ERROR) {
+        if (mode & I2C_MPU9250_Master_MODE_REPEAT_START) {
+            // The previous transfer left the bus halted without stop
+            I2C_MPU9250_Master_MasterSendStop();
+        }
+        return MPU9250_I2C_ERR;
+    }
+
+    return MPU9250_I2C_Wait(direction == MPU9250_I2C_SEGMENT_READ ?
+        I2C_MPU9250_Master_MSTAT_RD_CMPLT : I2C_MPU9250_Master_MSTAT_WR_CMPLT, remaining);
+}
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_I2C_Start(void) {
+    // Check if the I2C component has already been started,
+    // otherwise start it.
+    if (!I2C_MPU9250_Master_initVar) {
+        I2C_MPU9250_Master_Start();
+        CyDelay(10);
+    }
+}
 
-uint8_t MPU9250_I2C_Read(uint8_t address, uint8_t reg) {
+void MPU9250_I2C_SetTimeout(uint16_t timeout) {
+    timeout_us = timeout;
+}
+
+uint16_t MPU9250_I2C_GetTimeout(void) {
+    return timeout_us;
+}
+
+uint8_t MPU9250_I2C_RecoverBus(void) {
     /*
-        Standard I2C single byte read protocol
-            - Send start signal requesting write operation
-            - Write byte with register address
-            - Send stop signal
-            - Send start signal requesting read operation
-            - Read byte without acknowledgement
-            - Send stop
+        Bus recovery
+            - Disconnect the pins from the I2C master
+            - Clock SCL up to 9 times, until the slave releases SDA
+            - Generate a stop condition
+            - Connect the pins back to the I2C master
     */
-    
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-    I2C_MPU9250_Master_MasterWriteByte(reg);
-	I2C_MPU9250_Master_MasterSendStop();
-	I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_READ_XFER_MODE);
-    uint8_t data = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_NAK_DATA);
-    I2C_MPU9250_Master_MasterSendStop();
-	return data;
+    I2C_MPU9250_Master_Stop();
+
+    // Release both lines, then take control of the pins
+    SCL_1_Write(1);
+    SDA_1_Write(1);
+    SCL_1_BYP &= ~SCL_1_MASK;
+    SDA_1_BYP &= ~SDA_1_MASK;
+    CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+
+    for (uint8_t clock = 0; (clock < 9) && !SDA_1_Read(); clock++) {
+        SCL_1_Write(0);
+        CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+        SCL_1_Write(1);
+        CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+    }
+
+    // Stop condition: SDA rising while SCL is high
+    SCL_1_Write(0);
+    CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+    SDA_1_Write(0);
+    CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+    SCL_1_Write(1);
+    CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+    SDA_1_Write(1);
+    CyDelayUs(MPU9250_I2C_RECOVERY_HALF_PERIOD_US);
+
+    uint8_t released = SDA_1_Read() && SCL_1_Read();
+
+    // Give the pins back to the I2C master
+    SCL_1_BYP |= SCL_1_MASK;
+    SDA_1_BYP |= SDA_1_MASK;
+    I2C_MPU9250_Master_Start();
+
+    return released ? MPU9250_OK : MPU9250_I2C_ERR;
 }
 
-void MPU9250_I2C_ReadMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+uint8_t MPU9250_I2C_Transfer(uint8_t address, const MPU9250_I2C_Segment* segments, uint8_t n) {
+    /*
+        Chained transfer
+            - Send start signal with the direction of the first segment
+            - Transfer the bytes of the segment
+            - Send restart signal with the direction of the next segment, if any
+            - Send stop after the last segment
+    */
+    uint16_t remaining = timeout_us;  // Deadline of the transaction
+    uint16_t read = 0;                // Bytes read, for bus accounting
+    uint16_t written = 0;             // Bytes written, for bus accounting
+    uint8_t err = MPU9250_OK;
+    uint8_t i;
+
+    // The component moves up to 255 bytes per segment: check them all
+    // before the start, so that the bus is not left halted midway
+    for (i = 0; i < n; i++) {
+        if (segments[i].count > 0xFF)
+            return MPU9250_UNKNOWN_ERR;
+    }
+
+    MPU9250_STATS_BEGIN();
+    err = MPU9250_I2C_Acquire();
+    if (err != MPU9250_OK) {
+        MPU9250_STATS_END(0, 0, 0, err);
+        return err;
+    }
+    for (i = 0; (i < n) && (err == MPU9250_OK); i++) {
+        uint8_t mode = I2C_MPU9250_Master_MODE_COMPLETE_XFER;
+        if (i > 0)
+            mode |= I2C_MPU9250_Master_MODE_REPEAT_START;
+        if (i < n - 1)
+            mode |= I2C_MPU9250_Master_MODE_NO_STOP;
+
+        err = MPU9250_I2C_Xfer(address, segments[i].direction, segments[i].data,
+            segments[i].count, mode, &remaining);
+        if (segments[i].direction == MPU9250_I2C_SEGMENT_READ) {
+            read += segments[i].count;
+        } else {
+            written += segments[i].count;
+        }
+    }
+    MPU9250_I2C_Async_Release();
+    MPU9250_STATS_END(read, written, i > 0 ? i - 1 : 0, err);
+    return err;
+}
+
+uint8_t MPU9250_I2C_IsDeviceConnected(uint8_t address) {
+    // Address probe: start, address with write bit, stop
+    uint8_t dummy;
+    MPU9250_I2C_Segment probe = {MPU9250_I2C_SEGMENT_WRITE, &dummy, 0};
+    return MPU9250_I2C_Transfer(address, &probe, 1);
+}
+
+uint8_t MPU9250_I2C_Read(uint8_t address, uint8_t reg, uint8_t* data) {
+    // Single byte read: same as a multi bytes read of one byte
+    return MPU9250_I2C_ReadMulti(address, reg, data, 1);
+}
+
+uint8_t MPU9250_I2C_ReadMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
 	/*
         Standard I2C multi bytes read protocol
             - Send start signal requesting write operation
@@ -40,36 +233,18 @@ void MPU9250_I2C_ReadMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t
             - Last byte read without acknowledgement
             - Send stop
     */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-    I2C_MPU9250_Master_MasterWriteByte(reg);
-    I2C_MPU9250_Master_MasterSendRestart(address,I2C_MPU9250_Master_READ_XFER_MODE);
-	while (count--) {
-		if (!count) {
-			/* Last byte */
-			*data++ = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_NAK_DATA); 
-		} else {
-			*data++ = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_ACK_DATA);
-		}
-	}
-    I2C_MPU9250_Master_MasterSendStop();
-}
-
-uint8_t MPU9250_I2C_ReadNoRegister(uint8_t address) {
-    /*
-        Standard I2C no register read protocol
-            - Send start signal requesting read operation
-            - Read without acknowledgement
-            - Send stop
-    */
-	uint8_t data;
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_READ_XFER_MODE);
-	/* Also stop condition happens */
-	data = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_NAK_DATA);
-    I2C_MPU9250_Master_MasterSendStop();
-	return data;
+    MPU9250_I2C_Segment segments[2] = {
+        {MPU9250_I2C_SEGMENT_WRITE, &reg, 1},
+        {MPU9250_I2C_SEGMENT_READ, data, count}
+    };
+    return MPU9250_I2C_Transfer(address, segments, 2);
+}
+
+uint8_t MPU9250_I2C_ReadNoRegister(uint8_t address, uint8_t* data) {
+    return MPU9250_I2C_ReadMultiNoRegister(address, data, 1);
 }
 
-void MPU9250_I2C_ReadMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count) {
+uint8_t MPU9250_I2C_ReadMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count) {
 	/*
         Standard I2C multi bytes no registers read protocol
             - Send start signal requesting read operation
@@ -77,70 +252,48 @@ void MPU9250_I2C_ReadMultiNoRegister(uint8_t address, uint8_t* data, uint16_t co
             - Last byte read without acknowledgement
             - Send stop
     */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_READ_XFER_MODE);
-	while (count--) {
-		if (!count) {
-			/* Last byte */
-			*data = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_NAK_DATA); 
-		} else {
-			*data = I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_ACK_DATA); 
-		}
-	}
-    I2C_MPU9250_Master_MasterSendStop();
-}
-
-void MPU9250_I2C_Write(uint8_t address, uint8_t reg, uint8_t data) {
-    /*
-        Standard I2C single byte write protocol
-            - Send start signal requesting write operation
-            - Write register byte
-            - Write data byte
-            - Send stop
-    */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-    I2C_MPU9250_Master_MasterWriteByte(reg);
-	I2C_MPU9250_Master_MasterWriteByte(data);
-    I2C_MPU9250_Master_MasterSendStop();
+    MPU9250_I2C_Segment segment = {MPU9250_I2C_SEGMENT_READ, data, count};
+    return MPU9250_I2C_Transfer(address, &segment, 1);
+}
+
+uint8_t MPU9250_I2C_Write(uint8_t address, uint8_t reg, uint8_t data) {
+    return MPU9250_I2C_WriteMulti(address, reg, &data, 1);
 }
 
-void MPU9250_I2C_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+uint8_t MPU9250_I2C_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
 	/*
         Standard I2C multi bytes write protocol
             - Send start signal requesting write operation
+            - Write register byte
             - While loop with all data to be written
             - Send stop
     */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-    I2C_MPU9250_Master_MasterWriteByte(reg);
-	while (count--) {
-        I2C_MPU9250_Master_MasterWriteByte(*data++);
-	}
-	I2C_MPU9250_Master_MasterSendStop();
+    uint8_t buffer[MPU9250_I2C_MAX_WRITE + 1];
+
+    if (count > MPU9250_I2C_MAX_WRITE)
+        return MPU9250_UNKNOWN_ERR;
+
+    // The register address and the data must be sent in the same segment,
+    // a restart in between would start a new register access
+    buffer[0] = reg;
+    for (uint16_t i = 0; i < count; i++) {
+        buffer[i + 1] = data[i];
+    }
+    return MPU9250_I2C_WriteMultiNoRegister(address, buffer, count + 1);
 }
 
-void MPU9250_I2C_WriteNoRegister(uint8_t address, uint8_t data) {
-    /*
-        Standard I2C single byte no register write protocol
-            - Send start signal requesting write operation
-            - Write byte
-            - Send stop
-    */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-	I2C_MPU9250_Master_MasterWriteByte(data);
-	I2C_MPU9250_Master_MasterSendStop();
+uint8_t MPU9250_I2C_WriteNoRegister(uint8_t address, uint8_t data) {
+    return MPU9250_I2C_WriteMultiNoRegister(address, &data, 1);
 }
 
-void MPU9250_I2C_WriteMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count) {
+uint8_t MPU9250_I2C_WriteMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count) {
 	/*
         Standard I2C multi byte no registers write protocol
             - Send start signal requesting write operation
             - Write all bytes
             - Send stop
     */
-    I2C_MPU9250_Master_MasterSendStart(address, I2C_MPU9250_Master_WRITE_XFER_MODE);
-	while (count--) {
-        I2C_MPU9250_Master_MasterWriteByte(*data++);
-	}
-	I2C_MPU9250_Master_MasterSendStop();
+    MPU9250_I2C_Segment segment = {MPU9250_I2C_SEGMENT_WRITE, data, count};
+    return MPU9250_I2C_Transfer(address, &segment, 1);
 }
-/* [] END OF FILE */
\ No newline at end of file
+/* [] END OF FILE */
@@ -17,21 +17,119 @@
     
     #include "cytypes.h"
     #include "I2C_MPU9250_Master.h"
+    #include "MPU9250_Defs.h"
+    #include "MPU9250_I2C_Segment.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Default deadline of a blocking transaction, in microseconds.
+    *
+    * A transaction that is not completed within this time is aborted,
+    * the bus recovery sequence is performed and #MPU9250_TIMEOUT_ERR
+    * is returned. It can be changed at run time with #MPU9250_I2C_SetTimeout.
+    */
+    #ifndef MPU9250_I2C_TIMEOUT_US
+        #define MPU9250_I2C_TIMEOUT_US 10000
+    #endif
+
+    /**
+    * @brief Maximum number of data bytes of a register write.
+    */
+    #ifndef MPU9250_I2C_MAX_WRITE
+        #define MPU9250_I2C_MAX_WRITE 32
+    #endif
 
     /*
     * Function prototypes
     */
 
+    /**
+     * @brief  Start the I2C master component.
+     *
+     * This function starts the I2C master component, if not already started.
+     * All the accesses to the I2C master component are done through the
+     * functions of this file, so that the component can be replaced without
+     * changing the rest of the library.
+     * @return Nothing
+     */
+    void MPU9250_I2C_Start(void);
+
+    /**
+     * @brief  Set the deadline of blocking transactions.
+     *
+     * @param[in] timeout: deadline of a transaction, in microseconds
+     * @return Nothing
+     */
+    void MPU9250_I2C_SetTimeout(uint16_t timeout);
+
+    /**
+     * @brief  Get the deadline of transactions.
+     *
+     * The deadline applies to the blocking transactions and to the
+     * requests of MPU9250_I2C_Async.h.
+     * @return Deadline of a transaction, in microseconds
+     */
+    uint16_t MPU9250_I2C_GetTimeout(void);
+
+    /**
+     * @brief  Recover the bus from a slave holding SDA low.
+     *
+     * This function takes control of the pins, clocks SCL up to 9 times
+     *         until the slave releases SDA, generates a stop condition and
+     *         restarts the I2C master component. It is called automatically
+     *         when a transaction times out or the bus is found busy.
+     * @retval #MPU9250_OK if both lines are released.
+     * @retval #MPU9250_I2C_ERR if a line is still held low.
+     */
+    uint8_t MPU9250_I2C_RecoverBus(void);
+
+    /**
+     * @brief  Perform a chained transfer with a slave.
+     *
+     * This function transfers the segments in order, chaining them with
+     *         repeated start conditions: there is a single start condition
+     *         before the first segment and a single stop condition after the
+     *         last one. All the other functions of this file are built on it.
+     * @param[in] address: 7 bit slave address, right aligned, bits 6:0 are used
+     * @param[in] *segments: segments to be transferred
+     * @param[in] n: number of segments
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
+     * @retval #MPU9250_UNKNOWN_ERR if a segment is too long.
+     */
+    uint8_t MPU9250_I2C_Transfer(uint8_t address, const MPU9250_I2C_Segment* segments, uint8_t n);
+
+    /**
+     * @brief  Check if a slave acknowledges its address.
+     *
+     * This function sends a start condition followed by the slave address
+     *         and checks if the slave acknowledges it.
+     * @param[in] address: 7 bit slave address, right aligned, bits 6:0 are used
+     * @retval #MPU9250_OK if the slave acknowledged its address.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
+     */
+    uint8_t MPU9250_I2C_IsDeviceConnected(uint8_t address);
+
     /**
      * @brief  Read a single byte from a slave.
      * 
      * This function reads a single byte from the slave with the address
-     *         passed as a parameter from the specified register.
+     *         passed as a parameter from the specified register. The byte is
+     *         read after a repeated start condition, with no stop in between.
      * @param[in] address: 7 bit slave address, right aligned, bits 6:0 are used
      * @param[in] reg: register address to read from
-     * @return the byte read from the slave register
+     * @param[out] *data: pointer to where the byte read is stored
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    uint8_t MPU9250_I2C_Read(uint8_t address, uint8_t reg);
+    uint8_t MPU9250_I2C_Read(uint8_t address, uint8_t reg, uint8_t* data);
 
     /**
      * @brief  Read multi bytes from a slave.
@@ -42,10 +140,13 @@
      * @param[in]   address: 7 bit slave address, right aligned, bits 6:0 are used
      * @param[in]   reg: register address to read from
      * @param[out]  *data: address of data array where data are stored
-     * @param[in]   count: number of bytes to be read
-     * @return Nothing
+     * @param[in]   count: number of bytes to be read, up to 255
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    void MPU9250_I2C_ReadMulti(uint8_t address, uint8_t reg, uint8_t *data, uint16_t count);
+    uint8_t MPU9250_I2C_ReadMulti(uint8_t address, uint8_t reg, uint8_t *data, uint16_t count);
 
     /**
      * @brief  Read byte from slave without specifying register address
@@ -53,9 +154,13 @@
      * This function reads a single byte from the slave with the address
      *         passed as a parameter without specififying the address of the register
      * @param[in]  address: 7 bit slave address, right aligned, bits 6:0 are used
-     * @return  Data from slave
+     * @param[out] *data: pointer to where the byte read is stored
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    uint8_t MPU9250_I2C_ReadNoRegister(uint8_t address);
+    uint8_t MPU9250_I2C_ReadNoRegister(uint8_t address, uint8_t* data);
 
     /**
      * @brief  Read multiple bytes from slave without specifying start register address
@@ -64,10 +169,13 @@
      *         passed as a parameter without specififying the address of the register
      * @param[in]  address: 7 bit slave address, right aligned, bits 6:0 are used
      * @param[out] *data: pointer to data array to store data from slave
-     * @param[in]  count: number of bytes to be read
-     * @return Nothing
+     * @param[in]  count: number of bytes to be read, up to 255
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    void MPU9250_I2C_ReadMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count);
+    uint8_t MPU9250_I2C_ReadMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count);
 
     /**
      * @brief  Write single byte to slave
@@ -77,9 +185,12 @@
      * @param[in]  address: 7 bit slave address, right aligned, bits 6:0 are used
      * @param[in]  reg: register address to write to
      * @param[in]  data: data to be written
-     * @return Nothing
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    void MPU9250_I2C_Write(uint8_t address, uint8_t reg, uint8_t data);
+    uint8_t MPU9250_I2C_Write(uint8_t address, uint8_t reg, uint8_t data);
 
     /**
      * @brief  Write multi bytes to slave
@@ -89,10 +200,14 @@
      * @param[in]  address: 7 bit slave address, right aligned, bits 6:0 are used
      * @param[in]  reg: register address to write to
      * @param[in]  *data: pointer to data array to be written
-     * @param[in]  count: number of bytes to be written
-     * @return Nothing
+     * @param[in]  count: number of bytes to be written, up to #MPU9250_I2C_MAX_WRITE
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
+     * @retval #MPU9250_UNKNOWN_ERR if count is too large.
      */
-    void MPU9250_I2C_WriteMulti(uint8_t address, uint8_t reg, uint8_t *data, uint16_t count);
+    uint8_t MPU9250_I2C_WriteMulti(uint8_t address, uint8_t reg, uint8_t *data, uint16_t count);
 
     /**
      * @brief  Writes byte to slave without specifying register address
@@ -107,9 +222,12 @@
      *
      * @param  address: 7 bit slave address, left aligned, bits 6:0 are used
      * @param  data: data byte which will be send to device
-     * @return Nothing
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    void MPU9250_I2C_WriteNoRegister(uint8_t address, uint8_t data);
+    uint8_t MPU9250_I2C_WriteNoRegister(uint8_t address, uint8_t data);
 
     /**
      * @brief  Writes multiple bytes to slave without setting start register address
@@ -124,10 +242,13 @@
      *
      * @param[in]  address: 7 bit slave address, left aligned, bits 6:0 are used, LSB bit is not used
      * @param[in]  *data: pointer to data array to write data to slave
-     * @param[in]  count: number of bytes to be written
-     * @return Nothing
+     * @param[in]  count: number of bytes to be written, up to 255
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the slave did not acknowledge its address.
+     * @retval #MPU9250_I2C_ERR if an error occurred on the bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete in time.
      */
-    void MPU9250_I2C_WriteMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count);
+    uint8_t MPU9250_I2C_WriteMultiNoRegister(uint8_t address, uint8_t* data, uint16_t count);
 
     #endif
 /* [] END OF FILE */
@@ -0,0 +1,288 @@
+/*
+ * @brief Function definitions for non-blocking MPU9250 I2C communication.
+ *
+ * This file contains the definitions of the functions of the queued
+ * I2C transaction engine. Transfers are carried out with the buffer
+ * functions of the I2C master component (MasterWriteBuf and MasterReadBuf),
+ * that move the bytes from within the component interrupt, so that the
+ * CPU is free while the transfer is in progress.
+ *
+ * A request goes through the following phases:
+ *   - read:  write register address without stop (ADDRESS phase),
+ *            read data after a repeated start (DATA phase)
+ *   - write: write register address and data (DATA phase)
+ *
+ * A request that is not completed within the deadline of the blocking
+ * transactions (#MPU9250_I2C_SetTimeout), counted by
+ * MPU9250_I2C_Async_Tick, is aborted with the bus recovery sequence and
+ * completed with #MPU9250_TIMEOUT_ERR, so that a hung transfer does not
+ * keep its slot, nor the bus, forever.
+ *
+ * Completed requests stay in their slot until their callback is called,
+ * outside of the critical sections. The blocking transfers of MPU9250_I2C.c
+ * take the bus with MPU9250_I2C_Async_Acquire: requests submitted in the
+ * meantime are only queued, and started by MPU9250_I2C_Async_Release.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_I2C_Async.h"
+#include "MPU9250_I2C.h"
+#include "I2C_MPU9250_Master.h"
+#include "MPU9250_Stats.h"
+#include "CyLib.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_I2C_ASYNC_ERR_MASK
+    #define MPU9250_I2C_ASYNC_ERR_MASK (I2C_MPU9250_Master_MSTAT_ERR_SHORT_XFER | \
+                                        I2C_MPU9250_Master_MSTAT_ERR_ADDR_NAK   | \
+                                        I2C_MPU9250_Master_MSTAT_ERR_ARB_LOST   | \
+                                        I2C_MPU9250_Master_MSTAT_ERR_XFER)
+#endif
+
+#define MPU9250_I2C_ASYNC_PHASE_IDLE    0  // No request in progress
+#define MPU9250_I2C_ASYNC_PHASE_ADDRESS 1  // Register address being written
+#define MPU9250_I2C_ASYNC_PHASE_DATA    2  // Data being read or written
+#define MPU9250_I2C_ASYNC_PHASE_RECOVER 3  // Bus recovery after the deadline
+
+/* ========= TYPE DEFS ========= */
+typedef struct {
+    MPU9250_I2C_Request request;                        // Copy of the request
+    uint8_t status;                                     // Status, once completed
+    uint8_t buffer[MPU9250_I2C_ASYNC_MAX_WRITE + 1];    // Register address + write data
+} MPU9250_I2C_Slot;
+
+/* ========= VARIABLES ========= */
+static MPU9250_I2C_Slot queue[MPU9250_I2C_ASYNC_QUEUE_SIZE];   // Request queue
+static volatile uint8_t queue_done = 0;                       // First completed request to be notified
+static volatile uint8_t queue_head = 0;                       // Slot of the request in progress
+static volatile uint8_t queue_tail = 0;                       // First free slot
+static volatile uint8_t queue_completed = 0;                  // Number of requests to be notified
+static volatile uint8_t queue_pending = 0;                    // Number of requests in the queue
+static volatile uint8_t phase = MPU9250_I2C_ASYNC_PHASE_IDLE; // Phase of the request in progress
+static volatile uint8_t bus_owned = 0;                        // Bus taken by a blocking transfer
+static volatile uint16_t elapsed_us = 0;                      // Time spent by the request in progress
+
+/* ========= STATIC FUNCTIONS ========= */
+static void MPU9250_I2C_Async_Complete(uint8_t status);
+
+static void MPU9250_I2C_Async_StartNext(void) {
+    // Start the request at the head of the queue, if any and if the bus is
+    // not taken. Must be called with interrupts disabled or from the I2C interrupt.
+    if (queue_pending == 0 || bus_owned) {
+        phase = MPU9250_I2C_ASYNC_PHASE_IDLE;
+        return;
+    }
+
+    MPU9250_I2C_Slot* slot = &queue[queue_head];
+    uint8_t err;
+
+    elapsed_us = 0;
+    I2C_MPU9250_Master_MasterClearStatus();
+    if (slot->request.direction == MPU9250_I2C_ASYNC_READ) {
+        // Write register address, without stop condition
+        phase = MPU9250_I2C_ASYNC_PHASE_ADDRESS;
+        err = I2C_MPU9250_Master_MasterWriteBuf(slot->request.address, slot->buffer, 1,
+            I2C_MPU9250_Master_MODE_NO_STOP);
+    } else {
+        // Write register address and data
+        phase = MPU9250_I2C_ASYNC_PHASE_DATA;
+        err = I2C_MPU9250_Master_MasterWriteBuf(slot->request.address, slot->buffer,
+            slot->request.count + 1, I2C_MPU9250_Master_MODE_COMPLETE_XFER);
+    }
+    if (err == I2C_MPU9250_Master_MSTR_BUS_BUSY) {
+        // A slave is holding the bus: the request stays in progress
+        // until its deadline, when the bus is recovered
+    } else if (err != I2C_MPU9250_Master_MSTR_NO_ERROR) {
+        // Could not start the transfer, fail the request and go on
+        MPU9250_I2C_Async_Complete(MPU9250_I2C_ERR);
+    }
+}
+
+static void MPU9250_I2C_Async_Complete(uint8_t status) {
+    // Move the request in progress to the completed ones and start the
+    // next one, so that the bus does not stay idle. The caller is notified
+    // by MPU9250_I2C_Async_Notify, once out of the critical section.
+    MPU9250_I2C_Slot* slot = &queue[queue_head];
+
+    if (slot->request.direction == MPU9250_I2C_ASYNC_READ) {
+        MPU9250_STATS_ASYNC(slot->request.count, 1, 1, status);
+    } else {
+        MPU9250_STATS_ASYNC(0, slot->request.count + 1, 0, status);
+    }
+
+    slot->status = status;
+    queue_head = (queue_head + 1) % MPU9250_I2C_ASYNC_QUEUE_SIZE;
+    queue_pending--;
+    queue_completed++;
+    MPU9250_I2C_Async_StartNext();
+}
+
+static void MPU9250_I2C_Async_Notify(void) {
+    // Call the callbacks of the completed requests, with interrupts enabled.
+    // Each slot is released before its callback, which can submit a new request.
+    for (;;) {
+        uint8_t interruptState = CyEnterCriticalSection();
+        if (queue_completed == 0) {
+            CyExitCriticalSection(interruptState);
+            return;
+        }
+        MPU9250_I2C_Slot* slot = &queue[queue_done];
+        MPU9250_I2C_Callback callback = slot->request.callback;
+        void* context = slot->request.context;
+        uint8_t status = slot->status;
+        queue_done = (queue_done + 1) % MPU9250_I2C_ASYNC_QUEUE_SIZE;
+        queue_completed--;
+        CyExitCriticalSection(interruptState);
+
+        if (callback != NULL) {
+            callback(status, context);
+        }
+    }
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_I2C_Async_Submit(const MPU9250_I2C_Request* request) {
+
+    if (request == NULL || request->count == 0)
+        return MPU9250_UNKNOWN_ERR;
+    if (request->direction == MPU9250_I2C_ASYNC_WRITE && request->count > MPU9250_I2C_ASYNC_MAX_WRITE)
+        return MPU9250_UNKNOWN_ERR;
+
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    // Completed slots are free only once their callback was called
+    if (queue_pending + queue_completed == MPU9250_I2C_ASYNC_QUEUE_SIZE) {
+        CyExitCriticalSection(interruptState);
+        return MPU9250_BUSY_ERR;
+    }
+
+    // Copy the request, and the data to be written, in the first free slot
+    MPU9250_I2C_Slot* slot = &queue[queue_tail];
+    slot->request = *request;
+    slot->buffer[0] = request->reg;
+    if (request->direction == MPU9250_I2C_ASYNC_WRITE) {
+        for (uint8_t i = 0; i < request->count; i++) {
+            slot->buffer[i + 1] = request->data[i];
+        }
+    }
+    queue_tail = (queue_tail + 1) % MPU9250_I2C_ASYNC_QUEUE_SIZE;
+    queue_pending++;
+
+    // Start it right away if the bus is idle, otherwise it is started when
+    // the request in progress completes or when the bus is released
+    if (phase == MPU9250_I2C_ASYNC_PHASE_IDLE) {
+        MPU9250_I2C_Async_StartNext();
+    }
+
+    CyExitCriticalSection(interruptState);
+    MPU9250_I2C_Async_Notify();
+    return MPU9250_OK;
+}
+
+void MPU9250_I2C_Async_Process(void) {
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    if (phase == MPU9250_I2C_ASYNC_PHASE_IDLE || phase == MPU9250_I2C_ASYNC_PHASE_RECOVER) {
+        CyExitCriticalSection(interruptState);
+        MPU9250_I2C_Async_Notify();
+        return;
+    }
+
+    uint8_t status = I2C_MPU9250_Master_MasterStatus();
+    MPU9250_I2C_Slot* slot = &queue[queue_head];
+
+    if (status & MPU9250_I2C_ASYNC_ERR_MASK) {
+        // Transfer failed
+        MPU9250_I2C_Async_Complete(MPU9250_I2C_ERR);
+    } else if ((phase == MPU9250_I2C_ASYNC_PHASE_ADDRESS) &&
+               (status & I2C_MPU9250_Master_MSTAT_WR_CMPLT)) {
+        // Register address written, read data after a repeated start
+        I2C_MPU9250_Master_MasterClearStatus();
+        phase = MPU9250_I2C_ASYNC_PHASE_DATA;
+        if (I2C_MPU9250_Master_MasterReadBuf(slot->request.address, slot->request.data,
+                slot->request.count, I2C_MPU9250_Master_MODE_REPEAT_START) != I2C_MPU9250_Master_MSTR_NO_ERROR) {
+            // The address phase left the bus halted: release it
+            I2C_MPU9250_Master_MasterSendStop();
+            MPU9250_I2C_Async_Complete(MPU9250_I2C_ERR);
+        }
+    } else if ((phase == MPU9250_I2C_ASYNC_PHASE_DATA) &&
+               (status & (I2C_MPU9250_Master_MSTAT_RD_CMPLT | I2C_MPU9250_Master_MSTAT_WR_CMPLT))) {
+        // Request completed
+        MPU9250_I2C_Async_Complete(MPU9250_OK);
+    }
+
+    CyExitCriticalSection(interruptState);
+    MPU9250_I2C_Async_Notify();
+}
+
+void MPU9250_I2C_Async_Tick(uint16_t elapsed) {
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    if (phase != MPU9250_I2C_ASYNC_PHASE_ADDRESS && phase != MPU9250_I2C_ASYNC_PHASE_DATA) {
+        CyExitCriticalSection(interruptState);
+        MPU9250_I2C_Async_Notify();
+        return;
+    }
+
+    uint16_t timeout = MPU9250_I2C_GetTimeout();
+    elapsed_us = (elapsed >= timeout - elapsed_us) ? timeout : elapsed_us + elapsed;
+    if (elapsed_us < timeout) {
+        CyExitCriticalSection(interruptState);
+        return;
+    }
+
+    // Deadline expired: abort the transfer and free the bus, with interrupts
+    // enabled, as the recovery sequence takes some hundreds of microseconds.
+    // Meanwhile, completions are ignored and new requests only queued.
+    phase = MPU9250_I2C_ASYNC_PHASE_RECOVER;
+    CyExitCriticalSection(interruptState);
+    MPU9250_I2C_RecoverBus();
+
+    interruptState = CyEnterCriticalSection();
+    MPU9250_I2C_Async_Complete(MPU9250_TIMEOUT_ERR);
+    CyExitCriticalSection(interruptState);
+    MPU9250_I2C_Async_Notify();
+}
+
+uint8_t MPU9250_I2C_Async_Acquire(void) {
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    // The queued requests go first, so that they are seen by the blocking transfer
+    if (queue_pending > 0 || bus_owned) {
+        CyExitCriticalSection(interruptState);
+        return MPU9250_BUSY_ERR;
+    }
+    bus_owned = 1;
+
+    CyExitCriticalSection(interruptState);
+    return MPU9250_OK;
+}
+
+void MPU9250_I2C_Async_Release(void) {
+    uint8_t interruptState = CyEnterCriticalSection();
+
+    // Start the requests submitted while the bus was taken
+    bus_owned = 0;
+    if (phase == MPU9250_I2C_ASYNC_PHASE_IDLE) {
+        MPU9250_I2C_Async_StartNext();
+    }
+
+    CyExitCriticalSection(interruptState);
+    MPU9250_I2C_Async_Notify();
+}
+
+uint8_t MPU9250_I2C_Async_IsIdle(void) {
+    return queue_pending == 0;
+}
+
+uint8_t MPU9250_I2C_Async_GetPending(void) {
+    return queue_pending;
+}
+
+void I2C_MPU9250_Master_ISR_ExitCallback(void) {
+    // Advance the engine each time the I2C master interrupt is served
+    MPU9250_I2C_Async_Process();
+}
+/* [] END OF FILE */
@@ -0,0 +1,172 @@
+/** @file MPU9250_I2C_Async.h
+ * @brief Header file for non-blocking I2C communication.
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes of the queued, interrupt driven I2C transaction engine.
+ * Callers submit a read or write request and get a completion callback,
+ * while the transfer itself is carried out by the I2C master component
+ * interrupt. Requests submitted while the bus is busy are queued and
+ * started back-to-back.
+ *
+ * The engine is advanced from the exit callback of the I2C master
+ * component interrupt (see cyapicallbacks.h), so the completion callbacks
+ * are usually executed in interrupt context, but outside of the critical
+ * sections of the engine. The blocking functions of MPU9250_I2C.h wait for the queued
+ * requests to complete, then take the bus: requests submitted meanwhile
+ * are queued and started when the blocking transfer ends.
+ *
+ * Requests have the same deadline as the blocking transactions
+ * (#MPU9250_I2C_SetTimeout). The time is counted by
+ * #MPU9250_I2C_Async_Tick, called by the application (e.g. from a timer)
+ * and by the blocking functions while they wait for the bus.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_I2C_ASYNC_H_
+
+    #define __MPU9250_I2C_ASYNC_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Number of requests that can be queued.
+    */
+    #ifndef MPU9250_I2C_ASYNC_QUEUE_SIZE
+        #define MPU9250_I2C_ASYNC_QUEUE_SIZE 8
+    #endif
+
+    /**
+    * @brief Maximum number of data bytes of a write request.
+    *
+    * Write requests are copied in the queue, so that the caller
+    * buffer can be reused as soon as the request is submitted.
+    */
+    #ifndef MPU9250_I2C_ASYNC_MAX_WRITE
+        #define MPU9250_I2C_ASYNC_MAX_WRITE 8
+    #endif
+
+    /**
+    * @brief Read request.
+    */
+    #define MPU9250_I2C_ASYNC_READ 0
+
+    /**
+    * @brief Write request.
+    */
+    #define MPU9250_I2C_ASYNC_WRITE 1
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Completion callback.
+    *
+    * Function called, usually in interrupt context, when a request is completed.
+    * The first parameter is the status of the request (#MPU9250_OK,
+    * #MPU9250_I2C_ERR or #MPU9250_TIMEOUT_ERR), the second one is the
+    * context of the request.
+    */
+    typedef void (*MPU9250_I2C_Callback)(uint8_t status, void* context);
+
+    /**
+    * @brief Descriptor of a non-blocking I2C request.
+    */
+    typedef struct {
+        /** 7 bit slave address, right aligned **/
+        uint8_t address;
+        /** Register address to read from or write to **/
+        uint8_t reg;
+        /** Direction: #MPU9250_I2C_ASYNC_READ or #MPU9250_I2C_ASYNC_WRITE **/
+        uint8_t direction;
+        /** Number of bytes to be read or written **/
+        uint8_t count;
+        /** Destination buffer (read) or source buffer (write) **/
+        uint8_t* data;
+        /** Completion callback, can be NULL **/
+        MPU9250_I2C_Callback callback;
+        /** Context passed to the completion callback **/
+        void* context;
+    } MPU9250_I2C_Request;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Submit a non-blocking I2C request.
+    *
+    * This function queues the request and starts it if the bus is idle,
+    * otherwise it is started when the request in progress or the blocking
+    * transfer ends. The callbacks of the requests completed in the meantime
+    * can be called before this function returns. The descriptor is copied, and so are the data of write requests.
+    * The destination buffer of read requests must remain valid until the
+    * completion callback is called.
+    * @param[in] request: descriptor of the request.
+    * @retval #MPU9250_OK if the request was queued.
+    * @retval #MPU9250_BUSY_ERR if the queue is full.
+    * @retval #MPU9250_UNKNOWN_ERR if the request is not valid.
+    */
+    uint8_t MPU9250_I2C_Async_Submit(const MPU9250_I2C_Request* request);
+
+    /**
+    * @brief Advance the transaction engine.
+    *
+    * This function checks the status of the I2C master component and
+    * moves the current request to its next phase, completes it and
+    * starts the next queued one. It is called from the exit callback
+    * of the I2C master component interrupt, but it can also be polled.
+    */
+    void MPU9250_I2C_Async_Process(void);
+
+    /**
+    * @brief Count the time spent by the request in progress.
+    *
+    * This function charges the elapsed time to the request in progress.
+    * Once the deadline of #MPU9250_I2C_SetTimeout is reached, the transfer
+    * is aborted with #MPU9250_I2C_RecoverBus, the request is completed with
+    * #MPU9250_TIMEOUT_ERR and the next one is started. A request that could
+    * not start because a slave was holding the bus is handled the same way.
+    * It must not be called from interrupt context, as the recovery waits
+    * with CyDelayUs.
+    * @param[in] elapsed: time elapsed since the previous call, in microseconds.
+    */
+    void MPU9250_I2C_Async_Tick(uint16_t elapsed);
+
+    /**
+    * @brief Check if the transaction engine is idle.
+    *
+    * @return 1 if no request is queued or in progress, 0 otherwise.
+    */
+    uint8_t MPU9250_I2C_Async_IsIdle(void);
+
+    /**
+    * @brief Get the number of requests in the queue.
+    *
+    * @return Number of requests queued, including the one in progress.
+    */
+    uint8_t MPU9250_I2C_Async_GetPending(void);
+
+    /**
+    * @brief Take the bus for a blocking transfer.
+    *
+    * This function is used by MPU9250_I2C.c. It succeeds only if no request
+    * is queued or in progress; until #MPU9250_I2C_Async_Release, submitted
+    * requests are queued but not started.
+    * @retval #MPU9250_OK if the bus was taken.
+    * @retval #MPU9250_BUSY_ERR if requests are pending or the bus is already taken.
+    */
+    uint8_t MPU9250_I2C_Async_Acquire(void);
+
+    /**
+    * @brief Give back the bus taken by #MPU9250_I2C_Async_Acquire.
+    *
+    * The requests queued in the meantime are started.
+    */
+    void MPU9250_I2C_Async_Release(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,48 @@
+/** @file MPU9250_I2C_Segment.h
+ * @brief Header file for the segments of a chained I2C transfer.
+ *
+ * This header file contains the type definitions of the segments that
+ * make up a chained I2C transfer (see #MPU9250_I2C_Transfer). It does not
+ * depend on the I2C master component, so that the segments can also be
+ * used where the component is not available (e.g. by the cost model).
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_I2C_SEGMENT_H_
+
+    #define __MPU9250_I2C_SEGMENT_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Segment writing to the slave.
+    */
+    #define MPU9250_I2C_SEGMENT_WRITE 0
+
+    /**
+    * @brief Segment reading from the slave.
+    */
+    #define MPU9250_I2C_SEGMENT_READ 1
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Segment of a chained I2C transfer.
+    */
+    typedef struct {
+        /** Direction: #MPU9250_I2C_SEGMENT_WRITE or #MPU9250_I2C_SEGMENT_READ **/
+        uint8_t direction;
+        /** Source buffer (write) or destination buffer (read) **/
+        uint8_t* data;
+        /** Number of bytes to be transferred, up to 255 **/
+        uint16_t count;
+    } MPU9250_I2C_Segment;
+
+#endif
+/* [] END OF FILE */
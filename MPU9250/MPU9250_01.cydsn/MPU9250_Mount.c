@@ -0,0 +1,43 @@
+/*
+ * @brief Function definitions for the mounting of the sensor.
+ *
+ * This file contains the definitions of the functions that rotate the
+ * samples with the mounting matrix, in fixed point.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Mount.h"
+
+/* ========= VARIABLES ========= */
+static const int16_t mount_matrix[9] = { MPU9250_MOUNT_MATRIX };   // Q1.14, row by row
+
+/* ========= STATIC FUNCTIONS ========= */
+static inline int16_t MPU9250_Mount_Row(const int16_t* row, int32_t x, int32_t y, int32_t z) {
+    // Elements up to 1.0: the sum of three products fits in 32 bits
+    int32_t value = (row[0] * x + row[1] * y + row[2] * z + (1L << 13)) >> 14;
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return value;
+}
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_Mount_Rotate(int16_t* v) {
+    int32_t x = v[0], y = v[1], z = v[2];
+    v[0] = MPU9250_Mount_Row(&mount_matrix[0], x, y, z);
+    v[1] = MPU9250_Mount_Row(&mount_matrix[3], x, y, z);
+    v[2] = MPU9250_Mount_Row(&mount_matrix[6], x, y, z);
+}
+
+void MPU9250_Mount_RotateBatch(int16_t* const* axes, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t x = axes[0][i], y = axes[1][i], z = axes[2][i];
+        axes[0][i] = MPU9250_Mount_Row(&mount_matrix[0], x, y, z);
+        axes[1][i] = MPU9250_Mount_Row(&mount_matrix[3], x, y, z);
+        axes[2][i] = MPU9250_Mount_Row(&mount_matrix[6], x, y, z);
+    }
+}
+/* [] END OF FILE */
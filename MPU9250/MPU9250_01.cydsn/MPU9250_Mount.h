@@ -0,0 +1,176 @@
+/** @file MPU9250_Mount.h
+ * @brief Header file for the mounting of the sensor on the board.
+ *
+ * This header file contains the macros that describe how the MPU9250 is
+ * mounted on the board, and the prototypes of the functions that rotate
+ * the samples from the sensor axes to the body axes.
+ *
+ * If the sensor axes are a permutation of the body axes, possibly with sign
+ * flips, the mounting is set at compile time with #MPU9250_MOUNT_X_AXIS,
+ * #MPU9250_MOUNT_X_SIGN and the ones of the y and z axes. The remap is then
+ * part of the decoding of the samples (#MPU9250_ReadAcc, #MPU9250_ReadGyro,
+ * #MPU9250_ReadAccGyro, #MPU9250_ReadAccTempGyro, #MPU9250_ReadAll and
+ * #MPU9250_Fifo_Decode): each body axis is decoded from the bytes of its
+ * sensor axis, with no extra operations. The raw functions keep the
+ * sensor axes.
+ *
+ * Any other mounting is set with #MPU9250_MOUNT_MATRIX and applied to the
+ * decoded samples by #MPU9250_Mount_Rotate or #MPU9250_Mount_RotateBatch.
+ *
+ * The macros can be defined in the build options, or in a header (e.g.
+ * generated from the board description) whose name is #MPU9250_MOUNT_HEADER.
+ * The mounting applies to the accelerometer and to the gyroscope, not to
+ * the magnetometer.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_MOUNT_H_
+
+    #define __MPU9250_MOUNT_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    #ifdef MPU9250_MOUNT_HEADER
+        #include MPU9250_MOUNT_HEADER
+    #endif
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Sensor axis (0 = x, 1 = y, 2 = z) along the body x axis.
+    */
+    #ifndef MPU9250_MOUNT_X_AXIS
+        #define MPU9250_MOUNT_X_AXIS 0
+    #endif
+
+    /**
+    * @brief Sensor axis (0 = x, 1 = y, 2 = z) along the body y axis.
+    */
+    #ifndef MPU9250_MOUNT_Y_AXIS
+        #define MPU9250_MOUNT_Y_AXIS 1
+    #endif
+
+    /**
+    * @brief Sensor axis (0 = x, 1 = y, 2 = z) along the body z axis.
+    */
+    #ifndef MPU9250_MOUNT_Z_AXIS
+        #define MPU9250_MOUNT_Z_AXIS 2
+    #endif
+
+    /**
+    * @brief Sign of the sensor axis along the body x axis (1 or -1).
+    */
+    #ifndef MPU9250_MOUNT_X_SIGN
+        #define MPU9250_MOUNT_X_SIGN 1
+    #endif
+
+    /**
+    * @brief Sign of the sensor axis along the body y axis (1 or -1).
+    */
+    #ifndef MPU9250_MOUNT_Y_SIGN
+        #define MPU9250_MOUNT_Y_SIGN 1
+    #endif
+
+    /**
+    * @brief Sign of the sensor axis along the body z axis (1 or -1).
+    */
+    #ifndef MPU9250_MOUNT_Z_SIGN
+        #define MPU9250_MOUNT_Z_SIGN 1
+    #endif
+
+    #if (MPU9250_MOUNT_X_AXIS > 2) || (MPU9250_MOUNT_Y_AXIS > 2) || (MPU9250_MOUNT_Z_AXIS > 2) || \
+        (MPU9250_MOUNT_X_AXIS == MPU9250_MOUNT_Y_AXIS) || \
+        (MPU9250_MOUNT_X_AXIS == MPU9250_MOUNT_Z_AXIS) || \
+        (MPU9250_MOUNT_Y_AXIS == MPU9250_MOUNT_Z_AXIS)
+        #error "MPU9250_MOUNT_X_AXIS, MPU9250_MOUNT_Y_AXIS and MPU9250_MOUNT_Z_AXIS must be a permutation of 0, 1 and 2"
+    #endif
+
+    #if ((MPU9250_MOUNT_X_SIGN != 1) && (MPU9250_MOUNT_X_SIGN != -1)) || \
+        ((MPU9250_MOUNT_Y_SIGN != 1) && (MPU9250_MOUNT_Y_SIGN != -1)) || \
+        ((MPU9250_MOUNT_Z_SIGN != 1) && (MPU9250_MOUNT_Z_SIGN != -1))
+        #error "MPU9250_MOUNT_X_SIGN, MPU9250_MOUNT_Y_SIGN and MPU9250_MOUNT_Z_SIGN must be 1 or -1"
+    #endif
+
+    /**
+    * @brief 1 if at least one axis is flipped.
+    */
+    #define MPU9250_MOUNT_FLIPS \
+        ((MPU9250_MOUNT_X_SIGN < 0) || (MPU9250_MOUNT_Y_SIGN < 0) || (MPU9250_MOUNT_Z_SIGN < 0))
+
+    /**
+    * @brief Body axis along a sensor axis.
+    */
+    #define MPU9250_MOUNT_BODY_AXIS(sensor) \
+        ((MPU9250_MOUNT_X_AXIS == (sensor)) ? 0 : (MPU9250_MOUNT_Y_AXIS == (sensor)) ? 1 : 2)
+
+    /**
+    * @brief Sign of a sensor axis along its body axis.
+    */
+    #define MPU9250_MOUNT_BODY_SIGN(sensor) \
+        ((MPU9250_MOUNT_X_AXIS == (sensor)) ? MPU9250_MOUNT_X_SIGN : \
+         (MPU9250_MOUNT_Y_AXIS == (sensor)) ? MPU9250_MOUNT_Y_SIGN : MPU9250_MOUNT_Z_SIGN)
+
+    /**
+    * @brief Decode the big-endian word of a sensor axis.
+    */
+    #define MPU9250_MOUNT_WORD(data, axis) \
+        ((int16_t) (((data)[2 * (axis)] << 8) | ((data)[2 * (axis) + 1] & 0xFF)))
+
+    /**
+    * @brief Decode three big-endian sensor axes into the body axes.
+    *
+    * Indexes and signs are constants: the remap is folded in the decoding.
+    * A flipped -32768 stays -32768.
+    */
+    #define MPU9250_MOUNT_DECODE(out, data)                                                          \
+        do {                                                                                         \
+            (out)[0] = (int16_t) (MPU9250_MOUNT_X_SIGN * MPU9250_MOUNT_WORD(data, MPU9250_MOUNT_X_AXIS)); \
+            (out)[1] = (int16_t) (MPU9250_MOUNT_Y_SIGN * MPU9250_MOUNT_WORD(data, MPU9250_MOUNT_Y_AXIS)); \
+            (out)[2] = (int16_t) (MPU9250_MOUNT_Z_SIGN * MPU9250_MOUNT_WORD(data, MPU9250_MOUNT_Z_AXIS)); \
+        } while (0)
+
+    /**
+    * @brief One in the Q1.14 format of #MPU9250_MOUNT_MATRIX.
+    */
+    #define MPU9250_MOUNT_ONE 16384
+
+    /**
+    * @brief Mounting matrix, from sensor axes to body axes.
+    *
+    * Nine Q1.14 elements (-1.0 to 1.0, #MPU9250_MOUNT_ONE is 1.0), row by
+    * row: body[i] = sum of matrix[3 * i + j] * sensor[j]. It is applied by
+    * #MPU9250_Mount_Rotate after the decoding, so the permutation macros are
+    * usually left to the identity when it is set.
+    */
+    #ifndef MPU9250_MOUNT_MATRIX
+        #define MPU9250_MOUNT_MATRIX \
+            MPU9250_MOUNT_ONE, 0, 0, \
+            0, MPU9250_MOUNT_ONE, 0, \
+            0, 0, MPU9250_MOUNT_ONE
+    #endif
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Rotate a sample with the mounting matrix.
+    *
+    * The result is saturated to the range of the raw values.
+    * @param[in,out] v: values of the x, y and z axes.
+    */
+    void MPU9250_Mount_Rotate(int16_t* v);
+
+    /**
+    * @brief Rotate a batch of samples with the mounting matrix.
+    *
+    * @param[in,out] axes: values of the x, y and z axes, one array per axis
+    *                 (e.g. the acc or gyro arrays of #MPU9250_Fifo_Samples).
+    * @param[in] count: number of samples.
+    */
+    void MPU9250_Mount_RotateBatch(int16_t* const* axes, uint16_t count);
+
+#endif
+/* [] END OF FILE */
@@ -1148,6 +1148,51 @@
         #define MPU9250_MAG_CNTL1_REG 0x0A
     #endif
     
+    /**
+    * @brief Magnetometer CONTROL2 reg.
+    *
+    * Bit [0] (SRST) triggers a soft reset of the magnetometer
+    * and is automatically cleared.
+    */
+    #ifndef MPU9250_MAG_CNTL2_REG
+        #define MPU9250_MAG_CNTL2_REG 0x0B
+    #endif
+    
+    /**
+    * @brief Magnetometer self test control reg.
+    */
+    #ifndef MPU9250_MAG_ASTC_REG
+        #define MPU9250_MAG_ASTC_REG 0x0C
+    #endif
+    
+    /**
+    * @brief Magnetometer I2C disable reg.
+    */
+    #ifndef MPU9250_MAG_I2CDIS_REG
+        #define MPU9250_MAG_I2CDIS_REG 0x0F
+    #endif
+    
+    /**
+    * @brief Magnetometer x axis sensitivity adjustment value (fuse ROM).
+    */
+    #ifndef MPU9250_MAG_ASAX_REG
+        #define MPU9250_MAG_ASAX_REG 0x10
+    #endif
+    
+    /**
+    * @brief Magnetometer y axis sensitivity adjustment value (fuse ROM).
+    */
+    #ifndef MPU9250_MAG_ASAY_REG
+        #define MPU9250_MAG_ASAY_REG 0x11
+    #endif
+    
+    /**
+    * @brief Magnetometer z axis sensitivity adjustment value (fuse ROM).
+    */
+    #ifndef MPU9250_MAG_ASAZ_REG
+        #define MPU9250_MAG_ASAZ_REG 0x12
+    #endif
+    
     
 #endif
 
@@ -0,0 +1,142 @@
+/*
+ * @brief Function definitions for MPU9250 SPI communication.
+ *
+ * This file contains the definitions of the functions that can be used
+ * to interface with the MPU9250 through the SPI protocol, and the SPI
+ * register access backend.
+ *
+ * A transaction is made of a first byte with the register address, whose
+ * MSB selects a read (1) or a write (0), followed by the data bytes. Up to
+ * 4 bytes are kept in flight, so that the FIFOs of the component never
+ * overflow and the bus does not stay idle between bytes. A transaction
+ * in which no byte is received for #MPU9250_SPI_TIMEOUT_US is aborted.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#ifdef MPU9250_SPI_ENABLED
+
+#include "MPU9250_SPI.h"
+#include "MPU9250.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Stats.h"
+#include "cyfitter.h"
+#include "SPI_MPU9250_Master.h"
+#include "SPI_MPU9250_Master_IntClock.h"
+#include "SPI_MPU9250_CS.h"
+#include "CyLib.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_SPI_FIFO_SIZE
+    #define MPU9250_SPI_FIFO_SIZE 4  // Depth of the TX and RX FIFOs of the component
+#endif
+
+// The component clock runs at twice the SPI clock
+#define MPU9250_SPI_DIVIDER(hz) ((BCLK__BUS_CLK__HZ + 2 * (hz) - 1) / (2 * (hz)))
+
+/* ========= VARIABLES ========= */
+const MPU9250_Bus MPU9250_Bus_SPI = {
+    MPU9250_SPI_Start,
+    MPU9250_SPI_ReadMulti,
+    MPU9250_SPI_WriteMulti,
+    MPU9250_SPI_Write,
+    MPU9250_SPI_I2C_IF_DIS
+};
+
+static uint16_t divider = 0;  // Current divider of the component clock
+
+/* ========= STATIC FUNCTIONS ========= */
+static void MPU9250_SPI_SetClock(uint16_t value) {
+    // Change the clock only when needed, the component is idle between transactions
+    if (divider != value) {
+        SPI_MPU9250_Master_IntClock_SetDividerValue(value);
+        divider = value;
+    }
+}
+
+static uint8_t MPU9250_SPI_Transfer(uint8_t header, const uint8_t* tx, uint8_t* rx, uint16_t count) {
+    // Send the header followed by count bytes (0xFF if tx is NULL),
+    // storing the bytes received after the header in rx, if not NULL.
+    uint16_t total = count + 1;
+    uint16_t sent = 0;
+    uint16_t received = 0;
+    uint16_t idle_us = 0;  // Time since the last byte received
+
+    SPI_MPU9250_Master_ClearFIFO();
+    SPI_MPU9250_CS_Write(0);
+    while (received < total) {
+        uint8_t progress = 0;
+        if ((sent < total) && ((sent - received) < MPU9250_SPI_FIFO_SIZE)) {
+            SPI_MPU9250_Master_WriteTxData(sent == 0 ? header : (tx != NULL ? tx[sent - 1] : 0xFF));
+            sent++;
+            progress = 1;
+        }
+        if (SPI_MPU9250_Master_GetRxBufferSize() > 0) {
+            uint8_t byte = SPI_MPU9250_Master_ReadRxData();
+            if ((received > 0) && (rx != NULL)) {
+                rx[received - 1] = byte;
+            }
+            received++;
+            idle_us = 0;
+            progress = 1;
+        }
+        if (!progress) {
+            // Bytes in flight: wait for them, but not forever
+            if (idle_us >= MPU9250_SPI_TIMEOUT_US) {
+                SPI_MPU9250_CS_Write(1);
+                return MPU9250_TIMEOUT_ERR;
+            }
+            CyDelayUs(1);
+            idle_us++;
+        }
+    }
+    SPI_MPU9250_CS_Write(1);
+    return MPU9250_OK;
+}
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_SPI_Start(void) {
+    // Check if the SPI component has already been started,
+    // otherwise start it.
+    if (!SPI_MPU9250_Master_initVar) {
+        SPI_MPU9250_CS_Write(1);
+        MPU9250_SPI_SetClock(MPU9250_SPI_DIVIDER(MPU9250_SPI_SLOW_HZ));
+        SPI_MPU9250_Master_Start();
+    }
+}
+
+uint8_t MPU9250_SPI_ReadMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+    if (address != MPU9250_I2C_ADDRESS)
+        return MPU9250_DEV_NOT_FOUND_ERR;
+
+    // Sensor and interrupt registers can be read at full speed
+    if ((reg >= MPU9250_INT_STATUS_REG) && (reg + count - 1 <= MPU9250_EXT_SENS_DATA_23_REG)) {
+        MPU9250_SPI_SetClock(MPU9250_SPI_DIVIDER(MPU9250_SPI_FAST_HZ));
+    } else {
+        MPU9250_SPI_SetClock(MPU9250_SPI_DIVIDER(MPU9250_SPI_SLOW_HZ));
+    }
+    MPU9250_STATS_BEGIN();
+    uint8_t err = MPU9250_SPI_Transfer(reg | MPU9250_SPI_READ_BIT, NULL, data, count);
+    MPU9250_STATS_END(count, 1, 0, err);
+    return err;
+}
+
+uint8_t MPU9250_SPI_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+    if (address != MPU9250_I2C_ADDRESS)
+        return MPU9250_DEV_NOT_FOUND_ERR;
+
+    MPU9250_SPI_SetClock(MPU9250_SPI_DIVIDER(MPU9250_SPI_SLOW_HZ));
+    MPU9250_STATS_BEGIN();
+    uint8_t err = MPU9250_SPI_Transfer(reg & ~MPU9250_SPI_READ_BIT, data, NULL, count);
+    MPU9250_STATS_END(0, count + 1, 0, err);
+    return err;
+}
+
+uint8_t MPU9250_SPI_Write(uint8_t address, uint8_t reg, uint8_t data) {
+    return MPU9250_SPI_WriteMulti(address, reg, &data, 1);
+}
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/** @file MPU9250_SPI.h
+ * @brief Header file for SPI communication.
+ *
+ * This header file contains macros and function prototypes to
+ * perform SPI communication with the MPU9250. These functions are
+ * available when #MPU9250_SPI_ENABLED is defined, and require an SPI
+ * master component named SPI_MPU9250_Master (mode 3, MSB first, 8 bit
+ * data, internal clock) and a digital output pin named SPI_MPU9250_CS
+ * connected to the chip select line of the MPU9250.
+ *
+ * The MPU9250 accepts SPI clocks up to 1 MHz for all the registers,
+ * and up to 20 MHz for reads of the sensor and interrupt registers.
+ * The clock of the component is switched accordingly before each
+ * transaction. The AK8963 is not reachable on the SPI bus.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_SPI_H_
+
+    #define __MPU9250_SPI_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief SPI clock used for register writes and configuration reads, in Hz.
+    */
+    #ifndef MPU9250_SPI_SLOW_HZ
+        #define MPU9250_SPI_SLOW_HZ 1000000
+    #endif
+
+    /**
+    * @brief SPI clock used for sensor and interrupt register reads, in Hz.
+    */
+    #ifndef MPU9250_SPI_FAST_HZ
+        #define MPU9250_SPI_FAST_HZ 20000000
+    #endif
+
+    /**
+    * @brief Deadline of a transaction without any byte received, in microseconds.
+    *
+    * The SPI master component has no timeout of its own: if its clock
+    * stops, a transaction waits for this time, then releases the chip
+    * select line and returns #MPU9250_TIMEOUT_ERR.
+    */
+    #ifndef MPU9250_SPI_TIMEOUT_US
+        #define MPU9250_SPI_TIMEOUT_US 1000
+    #endif
+
+    /**
+    * @brief Bit of the first byte of a transaction that selects a read.
+    */
+    #define MPU9250_SPI_READ_BIT 0x80
+
+    /**
+    * @brief #MPU9250_USER_CTRL_REG bit that disables the I2C interface.
+    */
+    #define MPU9250_SPI_I2C_IF_DIS 0x10
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+     * @brief  Start the SPI master component.
+     *
+     * This function starts the SPI master component and releases
+     *         the chip select line.
+     * @return Nothing
+     */
+    void MPU9250_SPI_Start(void);
+
+    /**
+     * @brief  Read multi bytes from the MPU9250.
+     *
+     * @param[in]   address: 7 bit I2C address of the device, must be #MPU9250_I2C_ADDRESS
+     * @param[in]   reg: register address to read from
+     * @param[out]  *data: address of data array where data are stored
+     * @param[in]   count: number of bytes to be read
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the device is not on the SPI bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete.
+     */
+    uint8_t MPU9250_SPI_ReadMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+
+    /**
+     * @brief  Write multi bytes to the MPU9250.
+     *
+     * @param[in]  address: 7 bit I2C address of the device, must be #MPU9250_I2C_ADDRESS
+     * @param[in]  reg: register address to write to
+     * @param[in]  *data: pointer to data array to be written
+     * @param[in]  count: number of bytes to be written
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the device is not on the SPI bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete.
+     */
+    uint8_t MPU9250_SPI_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+
+    /**
+     * @brief  Write single byte to the MPU9250.
+     *
+     * @param[in]  address: 7 bit I2C address of the device, must be #MPU9250_I2C_ADDRESS
+     * @param[in]  reg: register address to write to
+     * @param[in]  data: data to be written
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_DEV_NOT_FOUND_ERR if the device is not on the SPI bus.
+     * @retval #MPU9250_TIMEOUT_ERR if the transaction did not complete.
+     */
+    uint8_t MPU9250_SPI_Write(uint8_t address, uint8_t reg, uint8_t data);
+
+#endif
+/* [] END OF FILE */
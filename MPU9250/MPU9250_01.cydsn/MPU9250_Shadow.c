@@ -0,0 +1,195 @@
+/*
+ * @brief Function definitions for the shadow register cache.
+ *
+ * This file contains the definitions of the functions that can be used
+ * to access the writable registers of the MPU9250 and of the AK8963
+ * through a write-through shadow copy.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Shadow.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Bus.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_H_RESET_MASK
+    #define MPU9250_H_RESET_MASK 0x80       // Device reset bit of PWR_MGMT_1
+#endif
+
+#ifndef MPU9250_USER_CTRL_RST_MASK
+    #define MPU9250_USER_CTRL_RST_MASK 0x07 // Self clearing reset bits of USER_CTRL
+#endif
+
+#ifndef MPU9250_MAG_SRST_MASK
+    #define MPU9250_MAG_SRST_MASK 0x01      // Soft reset bit of AK8963 CNTL2
+#endif
+
+#ifndef MPU9250_MAG_MODE_MASK
+    #define MPU9250_MAG_MODE_MASK 0x0F      // Operation mode bits of AK8963 CNTL1
+#endif
+
+#define MPU9250_SHADOW_SIZE 128  // Number of MPU9250 registers
+#define AK8963_SHADOW_SIZE  16   // Number of AK8963 registers
+
+/* ========= VARIABLES ========= */
+
+// Writable MPU9250 registers, one bit per register. Data, status, FIFO and
+// signal path reset registers are never cached, nor is I2C_SLV4_CTRL, whose
+// enable bit is cleared by the device at the end of each transfer.
+static const uint8_t mpu9250_cacheable[MPU9250_SHADOW_SIZE / 8] = {
+    0x07, 0xE0, 0xF8, 0xFF, 0xF8, 0xFF, 0x8F, 0x01,   // 0x00 - 0x3F
+    0x00, 0x00, 0x00, 0x00, 0xF8, 0x1E, 0x80, 0x6D    // 0x40 - 0x7F
+};
+
+// Writable AK8963 registers: CNTL1, ASTC and I2CDIS.
+static const uint16_t ak8963_cacheable = (1 << MPU9250_MAG_CNTL1_REG) |
+                                         (1 << MPU9250_MAG_ASTC_REG)  |
+                                         (1 << MPU9250_MAG_I2CDIS_REG);
+
+static uint8_t mpu9250_shadow[MPU9250_SHADOW_SIZE];          // Shadow copy of MPU9250 registers
+static uint8_t mpu9250_valid[MPU9250_SHADOW_SIZE / 8];       // Valid bits of MPU9250 shadow copy
+static uint8_t ak8963_shadow[AK8963_SHADOW_SIZE];            // Shadow copy of AK8963 registers
+static uint16_t ak8963_valid = 0;                            // Valid bits of AK8963 shadow copy
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t MPU9250_Shadow_IsCacheable(uint8_t address, uint8_t reg) {
+    if (address == MPU9250_I2C_ADDRESS) {
+        return (reg < MPU9250_SHADOW_SIZE) && (mpu9250_cacheable[reg >> 3] & (1 << (reg & 0x07)));
+    } else if (address == AK8963_I2C_ADDRESS) {
+        return (reg < AK8963_SHADOW_SIZE) && (ak8963_cacheable & (1 << reg));
+    }
+    return 0;
+}
+
+static uint8_t MPU9250_Shadow_IsValid(uint8_t address, uint8_t reg) {
+    if (address == MPU9250_I2C_ADDRESS) {
+        return (mpu9250_valid[reg >> 3] & (1 << (reg & 0x07))) != 0;
+    }
+    return (ak8963_valid & (1 << reg)) != 0;
+}
+
+static void MPU9250_Shadow_Store(uint8_t address, uint8_t reg, uint8_t data) {
+    // Store the value of a register after it has been written to or read from the bus
+    if (!MPU9250_Shadow_IsCacheable(address, reg))
+        return;
+
+    if (address == MPU9250_I2C_ADDRESS) {
+        if ((reg == MPU9250_PWR_MGMT_1_REG) && (data & MPU9250_H_RESET_MASK)) {
+            // Device reset: all registers go back to their reset values
+            for (uint8_t i = 0; i < sizeof(mpu9250_valid); i++) {
+                mpu9250_valid[i] = 0;
+            }
+            return;
+        }
+        if (reg == MPU9250_USER_CTRL_REG) {
+            // Reset bits are automatically cleared
+            data &= ~MPU9250_USER_CTRL_RST_MASK;
+        }
+        mpu9250_shadow[reg] = data;
+        mpu9250_valid[reg >> 3] |= (1 << (reg & 0x07));
+    } else {
+        if ((reg == MPU9250_MAG_CNTL1_REG) &&
+            (((data & MPU9250_MAG_MODE_MASK) == 0x01) || ((data & MPU9250_MAG_MODE_MASK) == 0x08))) {
+            // Single measurement and self test modes go back to power down
+            // by themselves, so the register cannot be cached
+            ak8963_valid &= ~(1 << reg);
+            return;
+        }
+        ak8963_shadow[reg] = data;
+        ak8963_valid |= (1 << reg);
+    }
+}
+
+static void MPU9250_Shadow_Track(uint8_t address, uint8_t reg, uint8_t data) {
+    // Track writes to registers that are not cached, but affect the cache
+    if ((address == AK8963_I2C_ADDRESS) && (reg == MPU9250_MAG_CNTL2_REG) && (data & MPU9250_MAG_SRST_MASK)) {
+        // Magnetometer soft reset
+        ak8963_valid = 0;
+    }
+    MPU9250_Shadow_Store(address, reg, data);
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Shadow_Read(uint8_t address, uint8_t reg, uint8_t* data) {
+    if (MPU9250_Shadow_IsCacheable(address, reg) && MPU9250_Shadow_IsValid(address, reg)) {
+        *data = (address == MPU9250_I2C_ADDRESS) ? mpu9250_shadow[reg] : ak8963_shadow[reg];
+        return MPU9250_OK;
+    }
+    uint8_t err = MPU9250_Bus_ReadBurst(address, reg, data, 1);
+    if (err == MPU9250_OK) {
+        MPU9250_Shadow_Store(address, reg, *data);
+    }
+    return err;
+}
+
+uint8_t MPU9250_Shadow_Write(uint8_t address, uint8_t reg, uint8_t data) {
+    uint8_t err = MPU9250_Bus_WriteSingle(address, reg, data);
+    if (err == MPU9250_OK) {
+        MPU9250_Shadow_Track(address, reg, data);
+    } else {
+        // The register could have been written anyway
+        MPU9250_Shadow_Forget(address, reg);
+    }
+    return err;
+}
+
+uint8_t MPU9250_Shadow_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count) {
+    uint8_t err = MPU9250_Bus_WriteBurst(address, reg, data, count);
+    for (uint16_t i = 0; i < count; i++) {
+        if (err == MPU9250_OK) {
+            MPU9250_Shadow_Track(address, reg + i, data[i]);
+        } else {
+            MPU9250_Shadow_Forget(address, reg + i);
+        }
+    }
+    return err;
+}
+
+uint8_t MPU9250_Shadow_UpdateBits(uint8_t address, uint8_t reg, uint8_t mask, uint8_t value) {
+    uint8_t current;
+    uint8_t err = MPU9250_Shadow_Read(address, reg, &current);
+    if (err != MPU9250_OK)
+        return err;
+    uint8_t updated = (current & ~mask) | (value & mask);
+
+    // Skip the write if the cached register already has the requested value
+    if ((updated == current) && MPU9250_Shadow_IsCacheable(address, reg))
+        return MPU9250_OK;
+    return MPU9250_Shadow_Write(address, reg, updated);
+}
+
+uint8_t MPU9250_Shadow_Matches(uint8_t address, uint8_t reg, const uint8_t* data, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++, reg++) {
+        if (!MPU9250_Shadow_IsCacheable(address, reg) || !MPU9250_Shadow_IsValid(address, reg))
+            return 0;
+        if (((address == MPU9250_I2C_ADDRESS) ? mpu9250_shadow[reg] : ak8963_shadow[reg]) != data[i])
+            return 0;
+    }
+    return 1;
+}
+
+void MPU9250_Shadow_Record(uint8_t address, uint8_t reg, uint8_t data) {
+    MPU9250_Shadow_Track(address, reg, data);
+}
+
+void MPU9250_Shadow_Forget(uint8_t address, uint8_t reg) {
+    // Drop the shadow copy of a register whose value is not known anymore
+    if (!MPU9250_Shadow_IsCacheable(address, reg))
+        return;
+    if (address == MPU9250_I2C_ADDRESS) {
+        mpu9250_valid[reg >> 3] &= ~(1 << (reg & 0x07));
+    } else {
+        ak8963_valid &= ~(1 << reg);
+    }
+}
+
+void MPU9250_Shadow_Invalidate(void) {
+    for (uint8_t i = 0; i < sizeof(mpu9250_valid); i++) {
+        mpu9250_valid[i] = 0;
+    }
+    ak8963_valid = 0;
+}
+/* [] END OF FILE */
@@ -0,0 +1,138 @@
+/** @file MPU9250_Shadow.h
+ * @brief Header file for the shadow register cache.
+ *
+ * This header file contains the function prototypes to access
+ * the writable registers of the MPU9250 and of the AK8963 through
+ * a write-through shadow copy. A register is read from the bus only
+ * the first time it is accessed, then its value is kept in RAM and
+ * updated on every write, so that bit updates cost a single write
+ * and configuration getters do not need to access the bus at all.
+ *
+ * Registers that are not writable (e.g. sensor data and status
+ * registers) are always accessed on the bus. The shadow copy of the
+ * MPU9250 is invalidated when a reset is triggered through
+ * #MPU9250_PWR_MGMT_1_REG, and the one of the AK8963 when a reset
+ * is triggered through #MPU9250_MAG_CNTL2_REG.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_SHADOW_H_
+
+    #define __MPU9250_SHADOW_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+
+    /*
+    * Function prototypes
+    */
+
+    /**
+     * @brief  Read a register through the shadow copy.
+     *
+     * This function returns the shadow copy of the register, if valid,
+     *         otherwise reads the register from the bus and stores its value.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: register address to read from
+     * @param[out] *data: pointer to where the value of the register is stored
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+     *         if the bus access failed.
+     */
+    uint8_t MPU9250_Shadow_Read(uint8_t address, uint8_t reg, uint8_t* data);
+
+    /**
+     * @brief  Write a register and update its shadow copy.
+     *
+     * If the write fails, the shadow copy of the register is invalidated.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: register address to write to
+     * @param[in] data: data to be written
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+     *         if the bus access failed.
+     */
+    uint8_t MPU9250_Shadow_Write(uint8_t address, uint8_t reg, uint8_t data);
+
+    /**
+     * @brief  Write consecutive registers and update their shadow copy.
+     *
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: first register address to write to
+     * @param[in] *data: pointer to data array to be written
+     * @param[in] count: number of bytes to be written
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+     *         if the bus access failed.
+     */
+    uint8_t MPU9250_Shadow_WriteMulti(uint8_t address, uint8_t reg, uint8_t* data, uint16_t count);
+
+    /**
+     * @brief  Update some bits of a register.
+     *
+     * This function updates the bits of the register selected by mask
+     *         with the ones in value. If the shadow copy of the register is
+     *         valid, only a single write is performed on the bus. The write
+     *         is skipped if the register already has the requested value.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: register address to update
+     * @param[in] mask: bits to be updated
+     * @param[in] value: new value of the bits selected by mask
+     * @retval #MPU9250_OK if no error occurred.
+     * @retval #MPU9250_I2C_ERR, #MPU9250_DEV_NOT_FOUND_ERR or #MPU9250_TIMEOUT_ERR
+     *         if the bus access failed.
+     */
+    uint8_t MPU9250_Shadow_UpdateBits(uint8_t address, uint8_t reg, uint8_t mask, uint8_t value);
+
+    /**
+     * @brief  Check if consecutive registers already hold some values.
+     *
+     * This function compares the data with the shadow copy of the registers,
+     *         without accessing the bus.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: first register address
+     * @param[in] *data: pointer to data array to be compared
+     * @param[in] count: number of registers to be compared
+     * @return 1 if all the registers are cached and hold the same values, 0 otherwise
+     */
+    uint8_t MPU9250_Shadow_Matches(uint8_t address, uint8_t reg, const uint8_t* data, uint16_t count);
+
+    /**
+     * @brief  Record a register written without going through these functions.
+     *
+     * This function updates the shadow copy after a write done by other
+     *         means, e.g. to the AK8963 through slave 4 of the I2C master.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: register address
+     * @param[in] data: value written
+     * @return Nothing
+     */
+    void MPU9250_Shadow_Record(uint8_t address, uint8_t reg, uint8_t data);
+
+    /**
+     * @brief  Invalidate the shadow copy of a register.
+     *
+     * This function must be called when a write done by other means could
+     *         have changed the register, but its value is not known.
+     * @param[in] address: 7 bit slave address (MPU9250 or AK8963)
+     * @param[in] reg: register address
+     * @return Nothing
+     */
+    void MPU9250_Shadow_Forget(uint8_t address, uint8_t reg);
+
+    /**
+     * @brief  Invalidate the shadow copy of all the registers.
+     *
+     * This function must be called whenever the registers could have been
+     *         changed without going through these functions (e.g. after a
+     *         power cycle of the sensor).
+     * @return Nothing
+     */
+    void MPU9250_Shadow_Invalidate(void);
+
+#endif
+/* [] END OF FILE */
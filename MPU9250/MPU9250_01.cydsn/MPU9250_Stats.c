@@ -0,0 +1,105 @@
+/*
+ * @brief Function definitions for bus accounting.
+ *
+ * This file contains the definitions of the functions that keep the
+ * bus usage counters of the library. It is empty unless
+ * MPU9250_STATS_ENABLED is defined.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Stats.h"
+
+#ifdef MPU9250_STATS_ENABLED
+
+#include "MPU9250_Defs.h"
+#include "CyLib.h"
+
+/* ========= MACROS ========= */
+#define MPU9250_STATS_DEMCR     0xE000EDFCu  // Debug exception and monitor control register
+#define MPU9250_STATS_TRCENA    0x01000000u  // Trace enable bit of DEMCR
+#define MPU9250_STATS_DWT_CTRL  0xE0001000u  // DWT control register
+#define MPU9250_STATS_CYCCNTENA 0x00000001u  // Cycle counter enable bit of DWT_CTRL
+#define MPU9250_STATS_DWT_CYCCNT 0xE0001004u // DWT cycle counter
+
+#define MPU9250_STATS_API_NONE 0xFF  // No entry point in progress
+
+/* ========= VARIABLES ========= */
+static MPU9250_Stats_Counters counters[MPU9250_STATS_API_COUNT];  // Counters of each entry point
+static uint8_t current = MPU9250_STATS_API_NONE;                  // Entry point in progress
+static uint32_t begin = 0;                                        // Ticks at transaction begin
+
+/* ========= STATIC FUNCTIONS ========= */
+static void MPU9250_Stats_Add(uint8_t api, uint16_t read, uint16_t written, uint8_t restarts, uint8_t status) {
+    MPU9250_Stats_Counters* c = &counters[api];
+
+    c->transactions++;
+    c->bytes_read += read;
+    c->bytes_written += written;
+    c->starts++;
+    c->restarts += restarts;
+    c->stops++;
+    if (status == MPU9250_DEV_NOT_FOUND_ERR) {
+        c->naks++;
+    }
+}
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_Stats_Snapshot(MPU9250_Stats_Counters* snapshot) {
+    uint8_t interruptState = CyEnterCriticalSection();
+    for (uint8_t i = 0; i < MPU9250_STATS_API_COUNT; i++) {
+        snapshot[i] = counters[i];
+    }
+    CyExitCriticalSection(interruptState);
+}
+
+void MPU9250_Stats_Reset(void) {
+    static const MPU9250_Stats_Counters zero;
+
+    // Enable the cycle counter
+    CY_SET_REG32(MPU9250_STATS_DEMCR, CY_GET_REG32(MPU9250_STATS_DEMCR) | MPU9250_STATS_TRCENA);
+    CY_SET_REG32(MPU9250_STATS_DWT_CTRL, CY_GET_REG32(MPU9250_STATS_DWT_CTRL) | MPU9250_STATS_CYCCNTENA);
+
+    uint8_t interruptState = CyEnterCriticalSection();
+    for (uint8_t i = 0; i < MPU9250_STATS_API_COUNT; i++) {
+        counters[i] = zero;
+    }
+    CyExitCriticalSection(interruptState);
+}
+
+uint8_t MPU9250_Stats_Enter(uint8_t api) {
+    if (current != MPU9250_STATS_API_NONE)
+        return 0;
+    current = api;
+    counters[api].calls++;
+    return 1;
+}
+
+void MPU9250_Stats_Leave(uint8_t* owner) {
+    if (*owner) {
+        current = MPU9250_STATS_API_NONE;
+    }
+}
+
+void MPU9250_Stats_Begin(void) {
+    begin = CY_GET_REG32(MPU9250_STATS_DWT_CYCCNT);
+}
+
+void MPU9250_Stats_End(uint16_t read, uint16_t written, uint8_t restarts, uint8_t status) {
+    uint8_t api = (current == MPU9250_STATS_API_NONE) ? MPU9250_STATS_API_OTHER : current;
+    uint32_t elapsed = CY_GET_REG32(MPU9250_STATS_DWT_CYCCNT) - begin;
+
+    uint8_t interruptState = CyEnterCriticalSection();
+    MPU9250_Stats_Add(api, read, written, restarts, status);
+    counters[api].ticks += elapsed;
+    CyExitCriticalSection(interruptState);
+}
+
+void MPU9250_Stats_Async(uint16_t read, uint16_t written, uint8_t restarts, uint8_t status) {
+    // Called from the I2C interrupt
+    MPU9250_Stats_Add(MPU9250_STATS_API_ASYNC, read, written, restarts, status);
+}
+
+#endif
+/* [] END OF FILE */
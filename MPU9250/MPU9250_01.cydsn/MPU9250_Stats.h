@@ -0,0 +1,183 @@
+/** @file MPU9250_Stats.h
+ * @brief Header file for bus accounting.
+ *
+ * This header file contains the type definitions, macros and function
+ * prototypes used to account for the bus usage of the library. When
+ * #MPU9250_STATS_ENABLED is defined, the transport layer counts the
+ * transactions, bytes, bus conditions, NAKs and elapsed CPU clock ticks,
+ * and attributes them to the outermost public function of MPU9250.h in
+ * progress. When it is not defined, the macros generate no code.
+ *
+ * Ticks are read from the DWT cycle counter of the Cortex-M3, so they
+ * are CPU clock cycles.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_STATS_H_
+
+    #define __MPU9250_STATS_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Entry points bus usage is attributed to.
+    */
+    typedef enum {
+        MPU9250_STATS_API_OTHER,            /**< Any other function **/
+        MPU9250_STATS_API_START,            /**< #MPU9250_Start **/
+        MPU9250_STATS_API_APPLY_CONFIG,     /**< #MPU9250_ApplyConfig **/
+        MPU9250_STATS_API_IS_CONNECTED,     /**< #MPU9250_IsConnected **/
+        MPU9250_STATS_API_READ_WHO_AM_I,    /**< #MPU9250_ReadWhoAmI and #MPU9250_ReadMagWhoAmI **/
+        MPU9250_STATS_API_READ_ACC,         /**< #MPU9250_ReadAcc and #MPU9250_ReadAccRaw **/
+        MPU9250_STATS_API_READ_GYRO,        /**< #MPU9250_ReadGyro and #MPU9250_ReadGyroRaw **/
+        MPU9250_STATS_API_READ_ACC_GYRO,    /**< #MPU9250_ReadAccGyro, #MPU9250_ReadAccGyroRaw and #MPU9250_ReadAccTempGyro **/
+        MPU9250_STATS_API_READ_TEMP,        /**< #MPU9250_ReadTemp **/
+        MPU9250_STATS_API_READ_MAG,         /**< #MPU9250_ReadMag, #MPU9250_ReadMagRaw and #MPU9250_ReadMagMicroTesla **/
+        MPU9250_STATS_API_READ_ALL,         /**< #MPU9250_ReadAll and #MPU9250_ReadAllRaw **/
+        MPU9250_STATS_API_READ_INT_STATUS,  /**< #MPU9250_ReadInterruptStatus **/
+        MPU9250_STATS_API_SELF_TEST,        /**< #MPU9250_SelfTest, #MPU9250_ReadSelfTestAcc and #MPU9250_ReadSelfTestGyro **/
+        MPU9250_STATS_API_POWER,            /**< #MPU9250_Sleep, #MPU9250_WakeUp and #MPU9250_Reset **/
+        MPU9250_STATS_API_CONFIG,           /**< Full scale ranges, sample rate, offsets, interrupts and I2C bypass **/
+        MPU9250_STATS_API_MAG_CONFIG,       /**< Magnetometer configuration (MPU9250_Mag_*) **/
+        MPU9250_STATS_API_AUX,              /**< Auxiliary I2C slaves (MPU9250_Aux.h) **/
+        MPU9250_STATS_API_FIFO_CONFIG,      /**< FIFO configuration and drain scheduling setup (MPU9250_Fifo.h) **/
+        MPU9250_STATS_API_FIFO_DRAIN,       /**< FIFO count and drains (MPU9250_Fifo.h) **/
+        MPU9250_STATS_API_ASYNC,            /**< Non-blocking requests (MPU9250_I2C_Async.h) **/
+        MPU9250_STATS_API_COUNT             /**< Number of entry points **/
+    } MPU9250_Stats_Api;
+
+    /**
+    * @brief Bus usage counters.
+    */
+    typedef struct {
+        /** Number of calls of the entry point **/
+        uint32_t calls;
+        /** Number of bus transactions **/
+        uint32_t transactions;
+        /** Number of bytes read from the slaves **/
+        uint32_t bytes_read;
+        /** Number of bytes written to the slaves, including register addresses **/
+        uint32_t bytes_written;
+        /** Number of START conditions (chip select assertions on SPI) **/
+        uint32_t starts;
+        /** Number of repeated START conditions **/
+        uint32_t restarts;
+        /** Number of STOP conditions (chip select releases on SPI) **/
+        uint32_t stops;
+        /** Number of transactions whose address was not acknowledged **/
+        uint32_t naks;
+        /** CPU clock ticks spent in blocking transactions **/
+        uint64_t ticks;
+    } MPU9250_Stats_Counters;
+
+    /* ========= MACROS ========= */
+
+    #ifdef MPU9250_STATS_ENABLED
+
+        /**
+        * @brief Attribute the bus usage of the enclosing function to an entry point.
+        *
+        * Must be placed at the beginning of the function. The attribution ends
+        * when the function returns. Nested calls are attributed to the outermost one.
+        */
+        #define MPU9250_STATS_API(api) \
+            uint8_t mpu9250_stats_owner __attribute__((cleanup(MPU9250_Stats_Leave))) = MPU9250_Stats_Enter(api)
+
+        /**
+        * @brief Mark the beginning of a blocking transaction.
+        */
+        #define MPU9250_STATS_BEGIN() MPU9250_Stats_Begin()
+
+        /**
+        * @brief Mark the end of a blocking transaction.
+        */
+        #define MPU9250_STATS_END(read, written, restarts, status) \
+            MPU9250_Stats_End(read, written, restarts, status)
+
+        /**
+        * @brief Record a non-blocking transaction.
+        */
+        #define MPU9250_STATS_ASYNC(read, written, restarts, status) \
+            MPU9250_Stats_Async(read, written, restarts, status)
+
+    #else
+
+        // Byte counts are only evaluated to avoid unused variable warnings
+        #define MPU9250_STATS_API(api)
+        #define MPU9250_STATS_BEGIN()
+        #define MPU9250_STATS_END(read, written, restarts, status) ((void) (read), (void) (written))
+        #define MPU9250_STATS_ASYNC(read, written, restarts, status)
+
+    #endif
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    #ifdef MPU9250_STATS_ENABLED
+
+        /**
+        * @brief Copy the counters of all the entry points.
+        *
+        * @param[out] snapshot: array of #MPU9250_STATS_API_COUNT counters,
+        *             indexed by #MPU9250_Stats_Api.
+        */
+        void MPU9250_Stats_Snapshot(MPU9250_Stats_Counters* snapshot);
+
+        /**
+        * @brief Clear the counters of all the entry points.
+        *
+        * This function also enables the cycle counter used for ticks.
+        */
+        void MPU9250_Stats_Reset(void);
+
+        /**
+        * @brief Start attributing bus usage to an entry point.
+        *
+        * Used by #MPU9250_STATS_API, not to be called directly.
+        * @param[in] api: entry point.
+        * @return 1 if this is the outermost entry point, 0 otherwise.
+        */
+        uint8_t MPU9250_Stats_Enter(uint8_t api);
+
+        /**
+        * @brief Stop attributing bus usage to an entry point.
+        *
+        * Used by #MPU9250_STATS_API, not to be called directly.
+        * @param[in] owner: value returned by #MPU9250_Stats_Enter.
+        */
+        void MPU9250_Stats_Leave(uint8_t* owner);
+
+        /**
+        * @brief Mark the beginning of a blocking transaction.
+        */
+        void MPU9250_Stats_Begin(void);
+
+        /**
+        * @brief Mark the end of a blocking transaction.
+        *
+        * @param[in] read: number of bytes read.
+        * @param[in] written: number of bytes written.
+        * @param[in] restarts: number of repeated START conditions.
+        * @param[in] status: status of the transaction.
+        */
+        void MPU9250_Stats_End(uint16_t read, uint16_t written, uint8_t restarts, uint8_t status);
+
+        /**
+        * @brief Record a completed non-blocking transaction.
+        *
+        * @param[in] read: number of bytes read.
+        * @param[in] written: number of bytes written.
+        * @param[in] restarts: number of repeated START conditions.
+        * @param[in] status: status of the transaction.
+        */
+        void MPU9250_Stats_Async(uint16_t read, uint16_t written, uint8_t restarts, uint8_t status);
+
+    #endif
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,134 @@
+/*
+ * @brief Function definitions for thermal bias compensation.
+ *
+ * This file contains the definitions of the functions that evaluate
+ * the thermal bias table and subtract the bias from the samples.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Thermal.h"
+
+/* ========= MACROS ========= */
+#define MPU9250_THERMAL_AXES 6  // Accelerometer and gyroscope axes
+
+/* ========= VARIABLES ========= */
+static int16_t point_temp[MPU9250_THERMAL_MAX_POINTS];                            // Temperature of each point
+static int16_t point_bias[MPU9250_THERMAL_MAX_POINTS][MPU9250_THERMAL_AXES];      // Bias of each point
+static int32_t segment_slope[MPU9250_THERMAL_MAX_POINTS][MPU9250_THERMAL_AXES];   // Bias per LSB of temperature (Q16.16)
+static uint8_t points = 0;                                                        // Number of points
+
+/* ========= STATIC FUNCTIONS ========= */
+static void MPU9250_Thermal_Evaluate(int16_t temp, int16_t* bias) {
+    uint8_t axis;
+
+    if (points == 0) {
+        for (axis = 0; axis < MPU9250_THERMAL_AXES; axis++)
+            bias[axis] = 0;
+        return;
+    }
+
+    // Segment of the temperature, clamped to the first and last point
+    uint8_t p = 0;
+    while ((p + 1 < points) && (temp >= point_temp[p + 1]))
+        p++;
+    int32_t dt = temp - point_temp[p];
+    if (dt < 0 || p + 1 == points)
+        dt = 0;
+
+    for (axis = 0; axis < MPU9250_THERMAL_AXES; axis++) {
+        bias[axis] = point_bias[p][axis] + (((int64_t) dt * segment_slope[p][axis] + 0x8000) >> 16);
+    }
+}
+
+static inline int16_t MPU9250_Thermal_Subtract(int16_t value, int16_t bias) {
+    // Saturated to the range of the raw values
+    int32_t result = (int32_t) value - bias;
+    if (result > INT16_MAX)
+        return INT16_MAX;
+    if (result < INT16_MIN)
+        return INT16_MIN;
+    return result;
+}
+
+/* ========= FUNCTIONS ========= */
+uint8_t MPU9250_Thermal_SetTable(const MPU9250_Thermal_Point* table, uint8_t count) {
+    uint8_t p, axis;
+
+    if (count > MPU9250_THERMAL_MAX_POINTS)
+        return MPU9250_UNKNOWN_ERR;
+    for (p = 1; p < count; p++) {
+        if (table[p].temp <= table[p - 1].temp)
+            return MPU9250_UNKNOWN_ERR;
+    }
+
+    for (p = 0; p < count; p++) {
+        point_temp[p] = table[p].temp;
+        for (axis = 0; axis < 3; axis++) {
+            point_bias[p][axis] = table[p].acc[axis];
+            point_bias[p][axis + 3] = table[p].gyro[axis];
+        }
+    }
+    // Slopes are computed once here, so the evaluation needs no division
+    for (p = 0; p + 1 < count; p++) {
+        int64_t dt = (int64_t) point_temp[p + 1] - point_temp[p];
+        for (axis = 0; axis < MPU9250_THERMAL_AXES; axis++) {
+            int64_t db = (int64_t) point_bias[p + 1][axis] - point_bias[p][axis];
+            int64_t slope = (db * 65536) / dt;
+            // Only reached with one LSB segments, whose slope is never evaluated
+            if (slope > INT32_MAX)
+                slope = INT32_MAX;
+            else if (slope < INT32_MIN)
+                slope = INT32_MIN;
+            segment_slope[p][axis] = (int32_t) slope;
+        }
+    }
+    points = count;
+    return MPU9250_OK;
+}
+
+void MPU9250_Thermal_GetBias(int16_t temp, int16_t* acc, int16_t* gyro) {
+    int16_t bias[MPU9250_THERMAL_AXES];
+    MPU9250_Thermal_Evaluate(temp, bias);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        acc[axis] = bias[axis];
+        gyro[axis] = bias[axis + 3];
+    }
+}
+
+void MPU9250_Thermal_Apply(int16_t temp, int16_t* acc, int16_t* gyro) {
+    int16_t bias[MPU9250_THERMAL_AXES];
+    MPU9250_Thermal_Evaluate(temp, bias);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        if (acc != NULL)
+            acc[axis] = MPU9250_Thermal_Subtract(acc[axis], bias[axis]);
+        if (gyro != NULL)
+            gyro[axis] = MPU9250_Thermal_Subtract(gyro[axis], bias[axis + 3]);
+    }
+}
+
+void MPU9250_Thermal_ApplyBatch(const MPU9250_Fifo_Samples* samples, uint16_t frames, int16_t temp) {
+    int16_t bias[MPU9250_THERMAL_AXES];
+
+    if (frames == 0)
+        return;
+    if (samples->temp != NULL)
+        temp = samples->temp[0];
+    MPU9250_Thermal_Evaluate(temp, bias);
+
+    for (uint16_t f = 0; f < frames; f++) {
+        // The temperature changes slowly: evaluate the table only when it does
+        if (samples->temp != NULL && samples->temp[f] != temp) {
+            temp = samples->temp[f];
+            MPU9250_Thermal_Evaluate(temp, bias);
+        }
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            if (samples->acc[axis] != NULL)
+                samples->acc[axis][f] = MPU9250_Thermal_Subtract(samples->acc[axis][f], bias[axis]);
+            if (samples->gyro[axis] != NULL)
+                samples->gyro[axis][f] = MPU9250_Thermal_Subtract(samples->gyro[axis][f], bias[axis + 3]);
+        }
+    }
+}
+/* [] END OF FILE */
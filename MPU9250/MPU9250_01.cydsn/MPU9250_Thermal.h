@@ -0,0 +1,94 @@
+/** @file MPU9250_Thermal.h
+ * @brief Header file for thermal bias compensation.
+ *
+ * This header file contains macros, type definitions and function
+ * prototypes of the thermal bias compensation. The bias of each
+ * accelerometer and gyroscope axis is described by a small lookup table
+ * indexed by the raw die temperature, and linearly interpolated between
+ * its points. The slopes of the segments are computed once, when the
+ * table is set, so the evaluation uses integer multiplies and shifts only.
+ * The bias is subtracted from the raw values, before unit conversion.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_THERMAL_H_
+
+    #define __MPU9250_THERMAL_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_Defs.h"
+    #include "MPU9250_Fifo.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Maximum number of points of the table.
+    */
+    #ifndef MPU9250_THERMAL_MAX_POINTS
+        #define MPU9250_THERMAL_MAX_POINTS 8
+    #endif
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Point of the thermal bias table.
+    */
+    typedef struct {
+        /** Raw die temperature, see #MPU9250_UNITS_TEMP_RAW **/
+        int16_t temp;
+        /** Accelerometer bias (x, y and z), in LSB of the raw values **/
+        int16_t acc[3];
+        /** Gyroscope bias (x, y and z), in LSB of the raw values **/
+        int16_t gyro[3];
+    } MPU9250_Thermal_Point;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Set the thermal bias table.
+    *
+    * The points are copied. Below the first point and above the last one,
+    * the bias is the one of the first and of the last point.
+    * @param[in] points: points, sorted by increasing temperature.
+    * @param[in] count: number of points (0 disables the compensation).
+    * @retval #MPU9250_OK if everything correct.
+    * @retval #MPU9250_UNKNOWN_ERR if there are too many points or they are not sorted.
+    */
+    uint8_t MPU9250_Thermal_SetTable(const MPU9250_Thermal_Point* points, uint8_t count);
+
+    /**
+    * @brief Get the bias at a temperature.
+    *
+    * @param[in] temp: raw die temperature.
+    * @param[out] acc: accelerometer bias (x, y and z).
+    * @param[out] gyro: gyroscope bias (x, y and z).
+    */
+    void MPU9250_Thermal_GetBias(int16_t temp, int16_t* acc, int16_t* gyro);
+
+    /**
+    * @brief Compensate a sample.
+    *
+    * @param[in] temp: raw die temperature of the sample.
+    * @param[in,out] acc: accelerometer values (x, y and z), can be NULL.
+    * @param[in,out] gyro: gyroscope values (x, y and z), can be NULL.
+    */
+    void MPU9250_Thermal_Apply(int16_t temp, int16_t* acc, int16_t* gyro);
+
+    /**
+    * @brief Compensate a batch of samples decoded from the FIFO.
+    *
+    * Each frame is compensated with its own temperature, if the temperature
+    * is in the FIFO, or with the given one otherwise. The bias is evaluated
+    * again only when the temperature changes.
+    * @param[in] samples: samples decoded by #MPU9250_Fifo_Decode.
+    * @param[in] frames: number of frames.
+    * @param[in] temp: raw die temperature used when samples has no temperature.
+    */
+    void MPU9250_Thermal_ApplyBatch(const MPU9250_Fifo_Samples* samples, uint16_t frames, int16_t temp);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*
+ * @brief Function definitions for unit conversion.
+ *
+ * This file contains the conversion tables and the functions that
+ * convert raw values into physical units with integer math only.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Units.h"
+
+/* ========= MACROS ========= */
+#ifndef MPU9250_UNITS_G
+    #define MPU9250_UNITS_G 9.80665        // Standard gravity, m/s^2
+#endif
+
+#ifndef MPU9250_UNITS_PI
+    #define MPU9250_UNITS_PI 3.14159265358979
+#endif
+
+// Scale of a unit per LSB, from its value at full scale: value * 2^16 (Q16.16)
+// per 2^15 LSB, with 16 more fractional bits. Constant expressions, folded
+// by the compiler: no floating point code is generated.
+#define MPU9250_UNITS_SCALE(full_scale) ((int32_t) ((full_scale) * 65536.0 * 2.0 + 0.5))
+
+/* ========= VARIABLES ========= */
+
+// Accelerometer scales, indexed by unit and full scale range (2, 4, 8, 16 g)
+static const int32_t acc_scale[MPU9250_Acc_Units][4] = {
+    {   // mg
+        MPU9250_UNITS_SCALE(2000.0),
+        MPU9250_UNITS_SCALE(4000.0),
+        MPU9250_UNITS_SCALE(8000.0),
+        MPU9250_UNITS_SCALE(16000.0)
+    },
+    {   // m/s^2
+        MPU9250_UNITS_SCALE(2.0 * MPU9250_UNITS_G),
+        MPU9250_UNITS_SCALE(4.0 * MPU9250_UNITS_G),
+        MPU9250_UNITS_SCALE(8.0 * MPU9250_UNITS_G),
+        MPU9250_UNITS_SCALE(16.0 * MPU9250_UNITS_G)
+    }
+};
+
+// Gyroscope scales, indexed by unit and full scale range (250, 500, 1000, 2000 dps)
+static const int32_t gyro_scale[MPU9250_Gyro_Units][4] = {
+    {   // dps
+        MPU9250_UNITS_SCALE(250.0),
+        MPU9250_UNITS_SCALE(500.0),
+        MPU9250_UNITS_SCALE(1000.0),
+        MPU9250_UNITS_SCALE(2000.0)
+    },
+    {   // rad/s
+        MPU9250_UNITS_SCALE(250.0 * MPU9250_UNITS_PI / 180.0),
+        MPU9250_UNITS_SCALE(500.0 * MPU9250_UNITS_PI / 180.0),
+        MPU9250_UNITS_SCALE(1000.0 * MPU9250_UNITS_PI / 180.0),
+        MPU9250_UNITS_SCALE(2000.0 * MPU9250_UNITS_PI / 180.0)
+    }
+};
+
+// Temperature scale: 1 / sensitivity degC per LSB
+static const int32_t temp_scale = MPU9250_UNITS_SCALE(32768.0 / MPU9250_UNITS_TEMP_SENSITIVITY);
+
+/* ========= STATIC FUNCTIONS ========= */
+static inline int32_t MPU9250_Units_Scale(int16_t raw, int32_t scale) {
+    // 32 x 32 bit multiply with 64 bit result, rounded to Q16.16
+    return (int32_t) (((int64_t) raw * scale + 0x8000) >> 16);
+}
+
+static void MPU9250_Units_ScaleBatch(const int16_t* raw, int32_t* values, uint16_t count, int32_t scale) {
+    for (uint16_t i = 0; i < count; i++) {
+        values[i] = MPU9250_Units_Scale(raw[i], scale);
+    }
+}
+
+/* ========= FUNCTIONS ========= */
+int32_t MPU9250_Units_AccValue(MPU9250_Acc_Unit unit, MPU9250_Acc_FS fs, int16_t raw) {
+    return MPU9250_Units_Scale(raw, acc_scale[unit][fs & 0x03]);
+}
+
+void MPU9250_Units_AccBatch(MPU9250_Acc_Unit unit, MPU9250_Acc_FS fs,
+                            const int16_t* raw, int32_t* values, uint16_t count) {
+    MPU9250_Units_ScaleBatch(raw, values, count, acc_scale[unit][fs & 0x03]);
+}
+
+int32_t MPU9250_Units_GyroValue(MPU9250_Gyro_Unit unit, MPU9250_Gyro_FS fs, int16_t raw) {
+    return MPU9250_Units_Scale(raw, gyro_scale[unit][fs & 0x03]);
+}
+
+void MPU9250_Units_GyroBatch(MPU9250_Gyro_Unit unit, MPU9250_Gyro_FS fs,
+                             const int16_t* raw, int32_t* values, uint16_t count) {
+    MPU9250_Units_ScaleBatch(raw, values, count, gyro_scale[unit][fs & 0x03]);
+}
+
+int32_t MPU9250_Units_TempValue(int16_t raw) {
+    return MPU9250_Units_Scale(raw - MPU9250_UNITS_TEMP_OFFSET, temp_scale) + (21L << 16);
+}
+/* [] END OF FILE */
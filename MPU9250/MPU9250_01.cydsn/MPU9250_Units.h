@@ -0,0 +1,126 @@
+/** @file MPU9250_Units.h
+ * @brief Header file for unit conversion.
+ *
+ * This header file contains type definitions and function prototypes to
+ * convert raw accelerometer and gyroscope values into physical units with
+ * integer math only. The scale of each unit and full scale range is a
+ * constant of a precomputed table (Q16.16 per LSB, with 16 more fractional
+ * bits), so a conversion is a 32 x 32 bit multiply and a shift.
+ *
+ * All the outputs are in Q16.16 format.
+ *
+ * The temperature is (raw - #MPU9250_UNITS_TEMP_OFFSET) / #MPU9250_UNITS_TEMP_SENSITIVITY + 21 degC.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_UNITS_H_
+
+    #define __MPU9250_UNITS_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Temperature sensitivity, in LSB/degC.
+    */
+    #ifndef MPU9250_UNITS_TEMP_SENSITIVITY
+        #define MPU9250_UNITS_TEMP_SENSITIVITY 333.87
+    #endif
+
+    /**
+    * @brief Temperature raw value at 21 degC.
+    */
+    #ifndef MPU9250_UNITS_TEMP_OFFSET
+        #define MPU9250_UNITS_TEMP_OFFSET 0
+    #endif
+
+    /**
+    * @brief Raw temperature value of a temperature in degC, as a constant expression.
+    */
+    #define MPU9250_UNITS_TEMP_RAW(celsius) \
+        ((int16_t) (((celsius) - 21.0) * MPU9250_UNITS_TEMP_SENSITIVITY + MPU9250_UNITS_TEMP_OFFSET))
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Accelerometer units.
+    */
+    typedef enum {
+        MPU9250_Acc_Unit_mg,    /**< Thousandths of standard gravity **/
+        MPU9250_Acc_Unit_ms2,   /**< m/s^2 **/
+        MPU9250_Acc_Units       /**< Number of units **/
+    } MPU9250_Acc_Unit;
+
+    /**
+    * @brief Gyroscope units.
+    */
+    typedef enum {
+        MPU9250_Gyro_Unit_dps,  /**< Degrees per second **/
+        MPU9250_Gyro_Unit_rads, /**< Radians per second **/
+        MPU9250_Gyro_Units      /**< Number of units **/
+    } MPU9250_Gyro_Unit;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Convert an accelerometer value.
+    *
+    * @param[in] unit: output unit.
+    * @param[in] fs: full scale range of the raw value.
+    * @param[in] raw: raw value.
+    * @return Value in the given unit (Q16.16).
+    */
+    int32_t MPU9250_Units_AccValue(MPU9250_Acc_Unit unit, MPU9250_Acc_FS fs, int16_t raw);
+
+    /**
+    * @brief Convert a batch of accelerometer values.
+    *
+    * The values can be samples of three axis (e.g. from #MPU9250_ReadAcc)
+    * or the samples of a single axis (e.g. from #MPU9250_Fifo_Decode).
+    * @param[in] unit: output unit.
+    * @param[in] fs: full scale range of the raw values.
+    * @param[in] raw: raw values.
+    * @param[out] values: values in the given unit (Q16.16).
+    * @param[in] count: number of values.
+    */
+    void MPU9250_Units_AccBatch(MPU9250_Acc_Unit unit, MPU9250_Acc_FS fs,
+                                const int16_t* raw, int32_t* values, uint16_t count);
+
+    /**
+    * @brief Convert a gyroscope value.
+    *
+    * @param[in] unit: output unit.
+    * @param[in] fs: full scale range of the raw value.
+    * @param[in] raw: raw value.
+    * @return Value in the given unit (Q16.16).
+    */
+    int32_t MPU9250_Units_GyroValue(MPU9250_Gyro_Unit unit, MPU9250_Gyro_FS fs, int16_t raw);
+
+    /**
+    * @brief Convert a batch of gyroscope values.
+    *
+    * @param[in] unit: output unit.
+    * @param[in] fs: full scale range of the raw values.
+    * @param[in] raw: raw values.
+    * @param[out] values: values in the given unit (Q16.16).
+    * @param[in] count: number of values.
+    */
+    void MPU9250_Units_GyroBatch(MPU9250_Gyro_Unit unit, MPU9250_Gyro_FS fs,
+                                 const int16_t* raw, int32_t* values, uint16_t count);
+
+    /**
+    * @brief Convert a temperature value.
+    *
+    * @param[in] raw: raw value.
+    * @return Temperature, in degrees Celsius (Q16.16).
+    */
+    int32_t MPU9250_Units_TempValue(int16_t raw);
+
+#endif
+/* [] END OF FILE */
@@ -16,6 +16,10 @@
     /*Define your macro callbacks here */
     /*For more information, refer to the Writing Code topic in the PSoC Creator Help.*/
 
+    /* Advance the MPU9250 non-blocking I2C engine from the I2C master interrupt */
+    #define I2C_MPU9250_Master_ISR_EXIT_CALLBACK
+    void I2C_MPU9250_Master_ISR_ExitCallback(void);
+
     
 #endif /* CYAPICALLBACKS_H */   
 /* [] */
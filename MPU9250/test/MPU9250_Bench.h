@@ -0,0 +1,80 @@
+/** @file MPU9250_Bench.h
+ * @brief Header file for the timing of the host benchmarks.
+ *
+ * Each benchmark program is a single translation unit: it times its
+ * loops with #MPU9250_Bench_Begin and #MPU9250_Bench_End, and prints the
+ * time per operation. Cycles are those of the host time stamp counter,
+ * where there is one: they give the relative cost of two paths, not the
+ * cycles of the Cortex-M3.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_BENCH_H_
+
+    #define __MPU9250_BENCH_H_
+
+    // Include required libraries
+
+    #include <stdint.h>
+    #include <stdio.h>
+    #include <time.h>
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Start of a timed loop.
+    */
+    typedef struct {
+        /** Host time, in ns **/
+        uint64_t ns;
+        /** Host time stamp counter, 0 if there is none **/
+        uint64_t cycles;
+    } MPU9250_Bench;
+
+    /* ========= VARIABLES ========= */
+    static volatile int32_t mpu9250_bench_sink = 0;  // Results kept alive across timed loops
+
+    /* ========= FUNCTIONS ========= */
+
+    /**
+    * @brief Start a timed loop.
+    */
+    static inline MPU9250_Bench MPU9250_Bench_Begin(void) {
+        MPU9250_Bench bench;
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        bench.ns = (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+    #if defined(__x86_64__) || defined(__i386__)
+        bench.cycles = __rdtsc();
+    #else
+        bench.cycles = 0;
+    #endif
+        return bench;
+    }
+
+    /**
+    * @brief End a timed loop, and print its time per operation.
+    *
+    * @param[in] bench: start of the loop.
+    * @param[in] name: name of the operation.
+    * @param[in] ops: number of operations of the loop.
+    * @return Time per operation, in ns.
+    */
+    static inline double MPU9250_Bench_End(MPU9250_Bench bench, const char* name, uint32_t ops) {
+        MPU9250_Bench end = MPU9250_Bench_Begin();
+        double ns = (double) (end.ns - bench.ns) / ops;
+        if (bench.cycles != 0) {
+            printf("  %-38s %8.2f ns %8.1f cycles\n", name, ns, (double) (end.cycles - bench.cycles) / ops);
+        } else {
+            printf("  %-38s %8.2f ns\n", name, ns);
+        }
+        return ns;
+    }
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,249 @@
+/*
+ * @brief Function definitions for the simulated MPU9250, for host tests.
+ *
+ * This file contains the register level model of the MPU9250 and of the
+ * AK8963, seen from the bus as I2C slaves, and the simulated time. The
+ * components that reach the devices are in MPU9250_Fake_I2C.c and
+ * MPU9250_Fake_SPI.c.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Fifo.h"
+#include "CyLib.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define MPU9250_FAKE_REGS 128          // Registers of each device
+
+#define MPU9250_FAKE_H_RESET 0x80      // Device reset bit of PWR_MGMT_1
+#define MPU9250_FAKE_FIFO_RST 0x04     // FIFO reset bit of USER_CTRL
+#define MPU9250_FAKE_SLV_EN 0x80       // Enable bit of I2C_SLV4_CTRL
+#define MPU9250_FAKE_SLV_RNW 0x80      // Read bit of I2C_SLV4_ADDR
+#define MPU9250_FAKE_SLV4_DONE 0x40    // Slave 4 transfer done bit of I2C_MST_STATUS
+#define MPU9250_FAKE_SLV4_NACK 0x10    // Slave 4 NACK bit of I2C_MST_STATUS
+#define MPU9250_FAKE_MAG_SRST 0x01     // Soft reset bit of AK8963 CNTL2
+#define MPU9250_FAKE_MAG_WIA 0x48      // AK8963 device ID
+#define MPU9250_FAKE_MAG_ASA 0x80      // AK8963 sensitivity adjustment (1.0)
+#define MPU9250_FAKE_MAG_MODE 0x0F     // Operation mode bits of AK8963 CNTL1
+#define MPU9250_FAKE_MAG_PD_NS 100000  // Time in power down before a mode change
+
+/* ========= VARIABLES ========= */
+static uint8_t mpu[MPU9250_FAKE_REGS];     // MPU9250 registers
+static uint8_t mag[MPU9250_FAKE_REGS];     // AK8963 registers
+static uint8_t pointer[2];                 // Register pointer of each device
+static uint8_t pointer_next[2];            // Next byte written sets the register pointer
+static uint8_t fifo[MPU9250_FIFO_SIZE];    // FIFO content
+static uint16_t fifo_count = 0;            // Bytes in the FIFO
+static uint64_t time_ns = 0;               // Simulated time
+static int64_t mag_off_ns = 0;             // Time the AK8963 went to power down
+static uint32_t mag_mode_errors = 0;       // AK8963 mode changes not through power down
+
+/* ========= STATIC FUNCTIONS ========= */
+static void MPU9250_Fake_ResetMpu(void) {
+    memset(mpu, 0, sizeof(mpu));
+    mpu[MPU9250_PWR_MGMT_1_REG] = 0x01;
+    mpu[MPU9250_WHO_AM_I_REG] = MPU9250_WHO_AM_I;
+    fifo_count = 0;
+}
+
+static void MPU9250_Fake_ResetMag(void) {
+    memset(mag, 0, sizeof(mag));
+    mag_off_ns = (int64_t) time_ns - MPU9250_FAKE_MAG_PD_NS;
+    mag[0x00] = MPU9250_FAKE_MAG_WIA;
+    mag[MPU9250_MAG_ASAX_REG] = MPU9250_FAKE_MAG_ASA;
+    mag[MPU9250_MAG_ASAY_REG] = MPU9250_FAKE_MAG_ASA;
+    mag[MPU9250_MAG_ASAZ_REG] = MPU9250_FAKE_MAG_ASA;
+}
+
+static uint8_t MPU9250_Fake_Device(uint8_t address) {
+    // Index of the device in the register pointers
+    return (address == AK8963_I2C_ADDRESS) ? 1 : 0;
+}
+
+static uint8_t MPU9250_Fake_ReadReg(uint8_t address, uint8_t reg) {
+    uint8_t value;
+
+    if (address == AK8963_I2C_ADDRESS)
+        return mag[reg];
+
+    switch (reg) {
+    case MPU9250_FIFO_COUNTH_REG:
+        return fifo_count >> 8;
+    case MPU9250_FIFO_COUNTL_REG:
+        return fifo_count & 0xFF;
+    case MPU9250_FIFO_R_W_REG:
+        if (fifo_count == 0)
+            return 0xFF;
+        value = fifo[0];
+        memmove(fifo, fifo + 1, --fifo_count);
+        return value;
+    case MPU9250_INT_STATUS_REG:
+    case MPU9250_I2C_MST_STATUS_REG:
+        // Cleared on read
+        value = mpu[reg];
+        mpu[reg] = 0x00;
+        return value;
+    default:
+        return mpu[reg];
+    }
+}
+
+static void MPU9250_Fake_WriteReg(uint8_t address, uint8_t reg, uint8_t value);
+
+static void MPU9250_Fake_Slave4(void) {
+    // Transfer a byte with the AK8963, the only device on the auxiliary bus
+    uint8_t address = mpu[MPU9250_I2C_SLV4_ADDR_REG];
+    uint8_t reg = mpu[MPU9250_I2C_SLV4_REG_REG] % MPU9250_FAKE_REGS;
+
+    if ((address & ~MPU9250_FAKE_SLV_RNW) != AK8963_I2C_ADDRESS) {
+        mpu[MPU9250_I2C_MST_STATUS_REG] |= MPU9250_FAKE_SLV4_NACK;
+    } else if (address & MPU9250_FAKE_SLV_RNW) {
+        mpu[MPU9250_I2C_SLV4_DI_REG] = mag[reg];
+    } else {
+        MPU9250_Fake_WriteReg(AK8963_I2C_ADDRESS, reg, mpu[MPU9250_I2C_SLV4_DO_REG]);
+    }
+    mpu[MPU9250_I2C_MST_STATUS_REG] |= MPU9250_FAKE_SLV4_DONE;
+}
+
+static void MPU9250_Fake_WriteReg(uint8_t address, uint8_t reg, uint8_t value) {
+    if (address == AK8963_I2C_ADDRESS) {
+        if (reg == MPU9250_MAG_CNTL2_REG && (value & MPU9250_FAKE_MAG_SRST)) {
+            MPU9250_Fake_ResetMag();
+        } else if (reg == MPU9250_MAG_CNTL1_REG && (value & MPU9250_FAKE_MAG_MODE) != 0 &&
+                   ((mag[reg] & MPU9250_FAKE_MAG_MODE) != 0 ||
+                    (int64_t) time_ns - mag_off_ns < MPU9250_FAKE_MAG_PD_NS)) {
+            // Mode changes must go through power down mode, and wait in it
+            mag_mode_errors++;
+        } else {
+            if (reg == MPU9250_MAG_CNTL1_REG && (value & MPU9250_FAKE_MAG_MODE) == 0
+                && (mag[reg] & MPU9250_FAKE_MAG_MODE) != 0) {
+                mag_off_ns = (int64_t) time_ns;
+            }
+            mag[reg] = value;
+        }
+        return;
+    }
+
+    switch (reg) {
+    case MPU9250_PWR_MGMT_1_REG:
+        if (value & MPU9250_FAKE_H_RESET) {
+            MPU9250_Fake_ResetMpu();
+        } else {
+            mpu[reg] = value;
+        }
+        break;
+    case MPU9250_USER_CTRL_REG:
+        // The FIFO reset bit clears itself
+        if (value & MPU9250_FAKE_FIFO_RST) {
+            fifo_count = 0;
+        }
+        mpu[reg] = value & ~MPU9250_FAKE_FIFO_RST;
+        break;
+    case MPU9250_FIFO_R_W_REG:
+        MPU9250_Fake_PushFifo(&value, 1);
+        break;
+    case MPU9250_I2C_SLV4_CTRL_REG:
+        // The enable bit clears itself when the transfer is done
+        mpu[reg] = value & ~MPU9250_FAKE_SLV_EN;
+        if (value & MPU9250_FAKE_SLV_EN) {
+            MPU9250_Fake_Slave4();
+        }
+        break;
+    default:
+        mpu[reg] = value;
+        break;
+    }
+}
+
+static uint8_t MPU9250_Fake_NextReg(uint8_t address, uint8_t reg) {
+    // Burst accesses auto-increment the register address, except on FIFO_R_W
+    if (address == MPU9250_I2C_ADDRESS && reg == MPU9250_FIFO_R_W_REG)
+        return reg;
+    return (reg + 1) % MPU9250_FAKE_REGS;
+}
+
+/* ========= FUNCTIONS ========= */
+void MPU9250_Fake_PowerOn(void) {
+    time_ns = 0;
+    MPU9250_Fake_ResetMpu();
+    MPU9250_Fake_ResetMag();
+    mag_mode_errors = 0;
+    MPU9250_Fake_I2C_Reset();
+    MPU9250_Fake_SPI_Reset();
+    MPU9250_Bus_SetBackend(&MPU9250_Bus_I2C);
+}
+
+uint8_t* MPU9250_Fake_Regs(uint8_t address) {
+    return (address == AK8963_I2C_ADDRESS) ? mag : mpu;
+}
+
+uint32_t MPU9250_Fake_GetMagModeErrors(void) {
+    return mag_mode_errors;
+}
+
+void MPU9250_Fake_PushFifo(const uint8_t* data, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        if (fifo_count == MPU9250_FIFO_SIZE) {
+            // The oldest byte is overwritten
+            memmove(fifo, fifo + 1, MPU9250_FIFO_SIZE - 1);
+            fifo_count--;
+            mpu[MPU9250_INT_STATUS_REG] |= MPU9250_INT_FIFO_OVERFLOW;
+        }
+        fifo[fifo_count++] = data[i];
+    }
+}
+
+uint32_t MPU9250_Fake_GetTimeUs(void) {
+    return (uint32_t) (time_ns / 1000);
+}
+
+uint64_t MPU9250_Fake_GetTimeNs(void) {
+    return time_ns;
+}
+
+void MPU9250_Fake_Advance(uint32_t us) {
+    time_ns += (uint64_t) us * 1000;
+    MPU9250_Fake_I2C_Run();
+    MPU9250_Fake_SPI_Run();
+}
+
+uint8_t MPU9250_Fake_Address(uint8_t address, uint8_t read) {
+    if (address != MPU9250_I2C_ADDRESS && address != AK8963_I2C_ADDRESS)
+        return 0;
+    // A write starts with the register address
+    pointer_next[MPU9250_Fake_Device(address)] = !read;
+    return 1;
+}
+
+void MPU9250_Fake_WriteByte(uint8_t address, uint8_t byte) {
+    uint8_t device = MPU9250_Fake_Device(address);
+    if (pointer_next[device]) {
+        pointer[device] = byte % MPU9250_FAKE_REGS;
+        pointer_next[device] = 0;
+    } else {
+        MPU9250_Fake_WriteReg(address, pointer[device], byte);
+        pointer[device] = MPU9250_Fake_NextReg(address, pointer[device]);
+    }
+}
+
+uint8_t MPU9250_Fake_ReadByte(uint8_t address) {
+    uint8_t device = MPU9250_Fake_Device(address);
+    uint8_t byte = MPU9250_Fake_ReadReg(address, pointer[device]);
+    pointer[device] = MPU9250_Fake_NextReg(address, pointer[device]);
+    return byte;
+}
+
+void CyDelay(uint32_t milliseconds) {
+    MPU9250_Fake_Advance(milliseconds * 1000);
+}
+
+void CyDelayUs(uint16_t microseconds) {
+    MPU9250_Fake_Advance(microseconds);
+}
+/* [] END OF FILE */
@@ -0,0 +1,298 @@
+/** @file MPU9250_Fake.h
+ * @brief Header file for the simulated MPU9250, for host tests.
+ *
+ * This header file contains the prototypes of a register level model of
+ * the MPU9250 and of the AK8963, and of the simulated PSoC components that
+ * reach it. The library is built unchanged on the host: MPU9250_I2C.c and
+ * MPU9250_I2C_Async.c drive the I2C master component and the SCL_1 and
+ * SDA_1 pins simulated by MPU9250_Fake_I2C.c, MPU9250_SPI.c drives the
+ * SPI master component and the SPI_MPU9250_CS pin simulated by
+ * MPU9250_Fake_SPI.c. Both reach the same device.
+ *
+ * The device models what the library relies on:
+ *   - power-on values of the identification and power registers
+ *   - device reset (PWR_MGMT_1 H_RESET, AK8963 CNTL2 SRST)
+ *   - register pointer, set by the first byte written after the address
+ *     and auto-incremented, except on FIFO_R_W
+ *   - FIFO: FIFO_COUNT, FIFO_R_W, FIFO reset and overflow status
+ *   - clear on read of INT_STATUS and I2C_MST_STATUS
+ *   - slave 4 transfers of the internal I2C master, done immediately
+ *   - AK8963 mode changes, taken only from power down mode after 100 us
+ * The other registers behave as plain memory.
+ *
+ * The I2C master component models:
+ *   - the buffer functions (MasterWriteBuf, MasterReadBuf), completed in
+ *     simulated time and followed by the interrupt exit callback
+ *   - the byte functions (MasterSendStart, MasterWriteByte, MasterReadByte,
+ *     MasterSendRestart, MasterSendStop)
+ *   - START, repeated START and STOP conditions, address NAK, a bus held
+ *     by the component between NO_STOP and REPEAT_START transfers
+ *   - the faults injected with #MPU9250_Fake_Fail
+ * Every condition and byte is counted (#MPU9250_Fake_Counters), and the
+ * segments of the last transactions are recorded (#MPU9250_Fake_Transaction).
+ *
+ * The SPI master component models the TX and RX FIFOs, the byte time set
+ * by the divider of its clock and a stopped clock (#MPU9250_Fake_SPI_Stall).
+ *
+ * Time is simulated: it advances with CyDelay, CyDelayUs and
+ * #MPU9250_Fake_Advance, and a transfer takes the time of its bits.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_FAKE_H_
+
+    #define __MPU9250_FAKE_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "MPU9250_I2C_Segment.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Number of transactions kept in the log.
+    */
+    #define MPU9250_FAKE_LOG_SIZE 64
+
+    /**
+    * @brief Maximum number of segments of a logged transaction.
+    */
+    #define MPU9250_FAKE_MAX_SEGMENTS 4
+
+    /**
+    * @brief SCL clocks needed by a hung slave to release SDA.
+    */
+    #define MPU9250_FAKE_HANG_CLOCKS 5
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Faults that can be injected in the I2C transfers.
+    */
+    typedef enum {
+        MPU9250_FAKE_FAULT_NAK,       /**< The slave does not acknowledge its address **/
+        MPU9250_FAKE_FAULT_ARB_LOST,  /**< Arbitration is lost during the address **/
+        MPU9250_FAKE_FAULT_REFUSE,    /**< The component refuses to start the transfer **/
+        MPU9250_FAKE_FAULT_HANG       /**< The transfer never ends and the slave holds SDA low **/
+    } MPU9250_Fake_Fault;
+
+    /**
+    * @brief Bus activity seen by the simulated I2C master component.
+    */
+    typedef struct {
+        /** Transactions, from START to STOP **/
+        uint32_t transactions;
+        /** Transactions with a read segment **/
+        uint32_t reads;
+        /** Transactions with write segments only **/
+        uint32_t writes;
+        /** START conditions **/
+        uint32_t starts;
+        /** Repeated START conditions **/
+        uint32_t restarts;
+        /** STOP conditions **/
+        uint32_t stops;
+        /** Address bytes **/
+        uint32_t addresses;
+        /** Address bytes not acknowledged **/
+        uint32_t nacks;
+        /** Data bytes read **/
+        uint32_t bytes_read;
+        /** Data bytes written, register addresses included **/
+        uint32_t bytes_written;
+        /** STOP conditions generated by the bus recovery sequence **/
+        uint32_t recoveries;
+    } MPU9250_Fake_Counters;
+
+    /**
+    * @brief Transaction recorded by the simulated I2C master component.
+    */
+    typedef struct {
+        /** 7 bit slave address **/
+        uint8_t address;
+        /** Number of segments, one per START or repeated START **/
+        uint8_t n;
+        /** Direction and number of data bytes of each segment (data is NULL) **/
+        MPU9250_I2C_Segment segments[MPU9250_FAKE_MAX_SEGMENTS];
+        /** Time of the conditions and bytes, in ns, without the pauses between segments **/
+        uint32_t ns;
+    } MPU9250_Fake_Transaction;
+
+    /**
+    * @brief Bus activity seen by the simulated SPI master component.
+    */
+    typedef struct {
+        /** Transactions, from the chip select going low to going high **/
+        uint32_t transactions;
+        /** Bytes exchanged with the chip select low, header included **/
+        uint32_t bytes;
+        /** Bytes lost because the RX FIFO was full **/
+        uint32_t overflows;
+    } MPU9250_Fake_SPI_Counters;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Power cycle the fake device.
+    *
+    * All the registers go back to their power-on values, the FIFO is
+    * emptied, the components are reset, and so are the counters, the log
+    * and the simulated time. It also selects the I2C backend, which
+    * invalidates the shadow copy.
+    */
+    void MPU9250_Fake_PowerOn(void);
+
+    /**
+    * @brief Access the registers of a device.
+    *
+    * @param[in] address: 7 bit address (MPU9250 or AK8963).
+    * @return Registers of the device, 128 bytes.
+    */
+    uint8_t* MPU9250_Fake_Regs(uint8_t address);
+
+    /**
+    * @brief Get the number of AK8963 mode changes ignored since the power on.
+    *
+    * A mode other than power down is taken only if the AK8963 is in power
+    * down mode, for at least 100 us: other writes of CNTL1 are ignored.
+    * @return Number of ignored mode changes.
+    */
+    uint32_t MPU9250_Fake_GetMagModeErrors(void);
+
+    /**
+    * @brief Write samples to the FIFO, as the device would.
+    *
+    * Bytes that do not fit are lost and the overflow is flagged in INT_STATUS.
+    * @param[in] data: bytes to be written.
+    * @param[in] count: number of bytes.
+    */
+    void MPU9250_Fake_PushFifo(const uint8_t* data, uint16_t count);
+
+    /**
+    * @brief Inject a fault in the next I2C transfers.
+    *
+    * A transfer is a call of MasterWriteBuf or MasterReadBuf, or a START
+    * or repeated START of the byte functions.
+    * @param[in] skip: number of transfers done normally first.
+    * @param[in] transfers: number of transfers with the fault.
+    * @param[in] fault: fault to be injected.
+    */
+    void MPU9250_Fake_Fail(uint8_t skip, uint8_t transfers, MPU9250_Fake_Fault fault);
+
+    /**
+    * @brief Set the bit rate of the simulated bus.
+    *
+    * @param[in] bitrate: bit rate, in Hz (400 kHz after the power on).
+    */
+    void MPU9250_Fake_SetBitrate(uint32_t bitrate);
+
+    /**
+    * @brief Get the bus activity since the power on.
+    *
+    * @param[out] counters: counters.
+    */
+    void MPU9250_Fake_GetCounters(MPU9250_Fake_Counters* counters);
+
+    /**
+    * @brief Get a recorded transaction.
+    *
+    * @param[in] index: index of the transaction, counted from the power on
+    *            (see #MPU9250_Fake_Counters.transactions).
+    * @return Transaction, NULL if not in the log anymore or not started yet.
+    */
+    const MPU9250_Fake_Transaction* MPU9250_Fake_GetTransaction(uint32_t index);
+
+    /**
+    * @brief Stop or restart the clock of the simulated SPI master component.
+    *
+    * @param[in] stall: 1 to stop the clock, 0 to restart it.
+    */
+    void MPU9250_Fake_SPI_Stall(uint8_t stall);
+
+    /**
+    * @brief Get the SPI bus activity since the power on.
+    *
+    * @param[out] counters: counters.
+    */
+    void MPU9250_Fake_SPI_GetCounters(MPU9250_Fake_SPI_Counters* counters);
+
+    /**
+    * @brief Get the simulated time.
+    *
+    * @return Time since the power on, in us.
+    */
+    uint32_t MPU9250_Fake_GetTimeUs(void);
+
+    /**
+    * @brief Let the simulated time run, as an idle CPU would.
+    *
+    * The transfers that end meanwhile are completed, and the interrupt
+    * exit callback of the I2C master component is called.
+    * @param[in] us: time to let run, in us.
+    */
+    void MPU9250_Fake_Advance(uint32_t us);
+
+    /*
+    * Device side, used by the simulated components
+    */
+
+    /**
+    * @brief Get the simulated time, in ns.
+    */
+    uint64_t MPU9250_Fake_GetTimeNs(void);
+
+    /**
+    * @brief Address a device, after a START or a repeated START.
+    *
+    * @param[in] address: 7 bit address.
+    * @param[in] read: 1 for a read, 0 for a write.
+    * @return 1 if the device acknowledges its address, 0 otherwise.
+    */
+    uint8_t MPU9250_Fake_Address(uint8_t address, uint8_t read);
+
+    /**
+    * @brief Write a byte to the addressed device.
+    *
+    * The first byte after the address sets the register pointer.
+    * @param[in] address: 7 bit address.
+    * @param[in] byte: byte written.
+    */
+    void MPU9250_Fake_WriteByte(uint8_t address, uint8_t byte);
+
+    /**
+    * @brief Read a byte from the addressed device, at the register pointer.
+    *
+    * @param[in] address: 7 bit address.
+    * @return Byte read.
+    */
+    uint8_t MPU9250_Fake_ReadByte(uint8_t address);
+
+    /**
+    * @brief Reset the simulated I2C master component and pins.
+    */
+    void MPU9250_Fake_I2C_Reset(void);
+
+    /**
+    * @brief Complete the I2C transfer that ended, if any.
+    *
+    * Called each time the simulated time advances.
+    */
+    void MPU9250_Fake_I2C_Run(void);
+
+    /**
+    * @brief Reset the simulated SPI master component and chip select pin.
+    */
+    void MPU9250_Fake_SPI_Reset(void);
+
+    /**
+    * @brief Complete the SPI bytes shifted by now.
+    *
+    * Called each time the simulated time advances.
+    */
+    void MPU9250_Fake_SPI_Run(void);
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,409 @@
+/*
+ * @brief Function definitions for the simulated I2C master component, for host tests.
+ *
+ * This file contains the simulated I2C master component (I2C_MPU9250_Master)
+ * and the simulated SCL_1 and SDA_1 pins, connected to the devices of
+ * MPU9250_Fake.c. A transfer started with MasterWriteBuf or MasterReadBuf
+ * ends after the time of its bits: its bytes are then moved, its status is
+ * set and the interrupt exit callback is called, as the component interrupt
+ * would do. The byte functions wait for the bus, so they advance the
+ * simulated time themselves.
+ *
+ * A START, a repeated START or a STOP takes one bit period, a byte takes
+ * nine (ACK included).
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Fake.h"
+#include "I2C_MPU9250_Master.h"
+#include "SCL_1.h"
+#include "SDA_1.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define MPU9250_FAKE_BITRATE 400000    // Bit rate after the power on
+
+#define MPU9250_FAKE_BUS_FREE   0      // No transaction
+#define MPU9250_FAKE_BUS_OWNED  1      // Transaction of the byte functions in progress
+#define MPU9250_FAKE_BUS_XFER   2      // Buffer transfer in progress
+#define MPU9250_FAKE_BUS_HALTED 3      // Buffer transfer ended without STOP
+
+#define MPU9250_FAKE_FAULT_NONE 0xFF   // Transfer without fault
+
+/* ========= VARIABLES ========= */
+uint8 I2C_MPU9250_Master_initVar = 0;
+uint8 SCL_1_BYP = SCL_1_MASK;
+uint8 SDA_1_BYP = SDA_1_MASK;
+
+static uint8_t enabled = 0;                          // Component started
+static uint8_t state = MPU9250_FAKE_BUS_FREE;        // Bus state
+static uint8_t status = 0;                           // Master status
+static uint8_t slave = 0;                            // Slave address of the transaction
+static uint8_t direction = 0;                        // Direction of the current segment
+static uint8_t acked = 0;                            // Address acknowledged by the slave
+static uint8_t* xfer_data = NULL;                    // Buffer of the transfer in progress
+static uint8_t xfer_count = 0;                       // Bytes of the transfer in progress
+static uint8_t xfer_mode = 0;                        // Mode of the transfer in progress
+static uint8_t xfer_fault = MPU9250_FAKE_FAULT_NONE; // Fault of the transfer in progress
+static uint64_t xfer_end_ns = 0;                     // End of the transfer in progress
+static uint8_t irq_pending = 0;                      // Interrupt to be served
+static uint8_t in_isr = 0;                           // Interrupt being served
+static uint32_t bit_ns = 1000000000u / MPU9250_FAKE_BITRATE;  // Bit period
+static uint8_t fail_skip = 0;                        // Transfers before the faults
+static uint8_t fail_transfers = 0;                   // Transfers with a fault
+static MPU9250_Fake_Fault fail_fault;                // Fault injected
+static uint8_t sda_hold = 0;                         // SCL clocks before the slave releases SDA
+static uint8_t scl_out = 1;                          // SCL data register
+static uint8_t sda_out = 1;                          // SDA data register
+static MPU9250_Fake_Counters counters;               // Bus activity
+static MPU9250_Fake_Transaction transactions[MPU9250_FAKE_LOG_SIZE];  // Last transactions
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint8_t MPU9250_Fake_TakeFault(void) {
+    // Fault of the next transfer, if any
+    if (fail_skip > 0) {
+        fail_skip--;
+        return MPU9250_FAKE_FAULT_NONE;
+    }
+    if (fail_transfers > 0) {
+        fail_transfers--;
+        return fail_fault;
+    }
+    return MPU9250_FAKE_FAULT_NONE;
+}
+
+static MPU9250_Fake_Transaction* MPU9250_Fake_Current(void) {
+    return &transactions[(counters.transactions - 1) % MPU9250_FAKE_LOG_SIZE];
+}
+
+static void MPU9250_Fake_Condition(uint8_t address, uint8_t read, uint8_t restart) {
+    // START or repeated START, followed by the address byte: opens a segment
+    if (!restart) {
+        counters.transactions++;
+        counters.starts++;
+        MPU9250_Fake_Transaction* t = MPU9250_Fake_Current();
+        memset(t, 0, sizeof(*t));
+        t->address = address;
+    } else {
+        counters.restarts++;
+    }
+    counters.addresses++;
+
+    MPU9250_Fake_Transaction* t = MPU9250_Fake_Current();
+    if (t->n < MPU9250_FAKE_MAX_SEGMENTS) {
+        t->segments[t->n].direction = read ? MPU9250_I2C_SEGMENT_READ : MPU9250_I2C_SEGMENT_WRITE;
+        t->segments[t->n].data = NULL;
+        t->segments[t->n].count = 0;
+        t->n++;
+    }
+    slave = address;
+    direction = read;
+}
+
+static void MPU9250_Fake_Bytes(uint16_t count) {
+    // Data bytes of the current segment
+    MPU9250_Fake_Transaction* t = MPU9250_Fake_Current();
+    t->segments[t->n - 1].count += count;
+    if (direction == I2C_MPU9250_Master_READ_XFER_MODE) {
+        counters.bytes_read += count;
+    } else {
+        counters.bytes_written += count;
+    }
+}
+
+static void MPU9250_Fake_Time(uint32_t bits) {
+    // Bus time of the transaction
+    MPU9250_Fake_Current()->ns += bits * bit_ns;
+}
+
+static void MPU9250_Fake_End(uint8_t stop) {
+    // End of the transaction, with a STOP or with the bus lost
+    MPU9250_Fake_Transaction* t = MPU9250_Fake_Current();
+    uint8_t read = 0;
+    for (uint8_t i = 0; i < t->n; i++) {
+        read |= (t->segments[i].direction == MPU9250_I2C_SEGMENT_READ);
+    }
+    if (read) {
+        counters.reads++;
+    } else {
+        counters.writes++;
+    }
+    if (stop) {
+        counters.stops++;
+    }
+    state = MPU9250_FAKE_BUS_FREE;
+}
+
+static void MPU9250_Fake_Wait(uint32_t bits) {
+    // The byte functions return once the bus is done
+    MPU9250_Fake_Time(bits);
+    uint64_t end_ns = MPU9250_Fake_GetTimeNs() + (uint64_t) bits * bit_ns;
+    while (MPU9250_Fake_GetTimeNs() < end_ns) {
+        MPU9250_Fake_Advance(1);
+    }
+}
+
+static uint8_t MPU9250_Fake_StartBuf(uint8_t address, uint8_t* data, uint8_t count, uint8_t mode, uint8_t read) {
+    // Start a buffer transfer, that ends after the time of its bits
+    if (!enabled || state == MPU9250_FAKE_BUS_XFER || state == MPU9250_FAKE_BUS_OWNED)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+    if (mode & I2C_MPU9250_Master_MODE_REPEAT_START) {
+        // Only after a transfer that kept the bus
+        if (state != MPU9250_FAKE_BUS_HALTED)
+            return I2C_MPU9250_Master_MSTR_NOT_READY;
+    } else if (state == MPU9250_FAKE_BUS_HALTED || sda_hold > 0) {
+        return I2C_MPU9250_Master_MSTR_BUS_BUSY;
+    }
+
+    uint8_t fault = MPU9250_Fake_TakeFault();
+    if (fault == MPU9250_FAKE_FAULT_REFUSE)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+
+    MPU9250_Fake_Condition(address, read, mode & I2C_MPU9250_Master_MODE_REPEAT_START);
+    acked = (fault == MPU9250_FAKE_FAULT_NONE) && MPU9250_Fake_Address(address, read);
+
+    // START, address, data if acknowledged, STOP if requested or after a NAK
+    uint32_t bits = 1 + 9;
+    if (fault == MPU9250_FAKE_FAULT_NONE && acked) {
+        bits += 9 * count;
+        bits += (mode & I2C_MPU9250_Master_MODE_NO_STOP) ? 0 : 1;
+    } else if (fault != MPU9250_FAKE_FAULT_ARB_LOST) {
+        bits += 1;
+    }
+
+    xfer_data = data;
+    xfer_count = count;
+    xfer_mode = mode;
+    xfer_fault = fault;
+    if (fault == MPU9250_FAKE_FAULT_HANG) {
+        // The slave holds SDA low, the transfer never ends
+        sda_hold = MPU9250_FAKE_HANG_CLOCKS;
+        xfer_end_ns = UINT64_MAX;
+    } else {
+        xfer_end_ns = MPU9250_Fake_GetTimeNs() + (uint64_t) bits * bit_ns;
+        MPU9250_Fake_Time(bits);
+    }
+    state = MPU9250_FAKE_BUS_XFER;
+    status = I2C_MPU9250_Master_MSTAT_XFER_INP;
+    return I2C_MPU9250_Master_MSTR_NO_ERROR;
+}
+
+static void MPU9250_Fake_CompleteBuf(void) {
+    // Move the bytes and set the status, as the component interrupt does
+    uint8_t done = (direction == I2C_MPU9250_Master_READ_XFER_MODE) ?
+        I2C_MPU9250_Master_MSTAT_RD_CMPLT : I2C_MPU9250_Master_MSTAT_WR_CMPLT;
+
+    if (xfer_fault == MPU9250_FAKE_FAULT_ARB_LOST) {
+        status = I2C_MPU9250_Master_MSTAT_ERR_ARB_LOST | I2C_MPU9250_Master_MSTAT_ERR_XFER;
+        MPU9250_Fake_End(0);
+    } else if (!acked) {
+        counters.nacks++;
+        status = done | I2C_MPU9250_Master_MSTAT_ERR_ADDR_NAK | I2C_MPU9250_Master_MSTAT_ERR_XFER;
+        MPU9250_Fake_End(1);
+    } else {
+        for (uint8_t i = 0; i < xfer_count; i++) {
+            if (direction == I2C_MPU9250_Master_READ_XFER_MODE) {
+                xfer_data[i] = MPU9250_Fake_ReadByte(slave);
+            } else {
+                MPU9250_Fake_WriteByte(slave, xfer_data[i]);
+            }
+        }
+        MPU9250_Fake_Bytes(xfer_count);
+        status = done;
+        if (xfer_mode & I2C_MPU9250_Master_MODE_NO_STOP) {
+            status |= I2C_MPU9250_Master_MSTAT_XFER_HALT;
+            state = MPU9250_FAKE_BUS_HALTED;
+        } else {
+            MPU9250_Fake_End(1);
+        }
+    }
+}
+
+static uint8_t MPU9250_Fake_SendAddress(uint8_t address, uint8_t R_nW, uint8_t restart) {
+    // START or repeated START of the byte functions
+    uint8_t fault = MPU9250_Fake_TakeFault();
+    if (fault == MPU9250_FAKE_FAULT_REFUSE)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+
+    MPU9250_Fake_Condition(address, R_nW, restart);
+    state = MPU9250_FAKE_BUS_OWNED;
+    MPU9250_Fake_Wait(1 + 9);
+    if (fault == MPU9250_FAKE_FAULT_ARB_LOST || fault == MPU9250_FAKE_FAULT_HANG) {
+        if (fault == MPU9250_FAKE_FAULT_HANG) {
+            sda_hold = MPU9250_FAKE_HANG_CLOCKS;
+        }
+        MPU9250_Fake_End(0);
+        return I2C_MPU9250_Master_MSTR_ERR_ARB_LOST;
+    }
+
+    acked = (fault == MPU9250_FAKE_FAULT_NONE) && MPU9250_Fake_Address(address, R_nW);
+    if (!acked) {
+        // The bus is kept, the caller sends the STOP
+        counters.nacks++;
+        return I2C_MPU9250_Master_MSTR_ERR_LB_NAK;
+    }
+    return I2C_MPU9250_Master_MSTR_NO_ERROR;
+}
+
+/* ========= FUNCTIONS ========= */
+void I2C_MPU9250_Master_Start(void) {
+    I2C_MPU9250_Master_initVar = 1;
+    enabled = 1;
+    status = 0;
+}
+
+void I2C_MPU9250_Master_Stop(void) {
+    // The transfer in progress is abandoned, the lines are released
+    if (state != MPU9250_FAKE_BUS_FREE) {
+        MPU9250_Fake_End(0);
+    }
+    enabled = 0;
+    status = 0;
+    irq_pending = 0;
+}
+
+uint8 I2C_MPU9250_Master_MasterStatus(void) {
+    return status;
+}
+
+uint8 I2C_MPU9250_Master_MasterClearStatus(void) {
+    uint8_t old = status;
+    status &= I2C_MPU9250_Master_MSTAT_XFER_INP;
+    return old;
+}
+
+uint8 I2C_MPU9250_Master_MasterWriteBuf(uint8 slaveAddress, uint8* wrData, uint8 cnt, uint8 mode) {
+    return MPU9250_Fake_StartBuf(slaveAddress, wrData, cnt, mode, I2C_MPU9250_Master_WRITE_XFER_MODE);
+}
+
+uint8 I2C_MPU9250_Master_MasterReadBuf(uint8 slaveAddress, uint8* rdData, uint8 cnt, uint8 mode) {
+    return MPU9250_Fake_StartBuf(slaveAddress, rdData, cnt, mode, I2C_MPU9250_Master_READ_XFER_MODE);
+}
+
+uint8 I2C_MPU9250_Master_MasterSendStart(uint8 slaveAddress, uint8 R_nW) {
+    if (!enabled || state != MPU9250_FAKE_BUS_FREE)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+    if (sda_hold > 0)
+        return I2C_MPU9250_Master_MSTR_BUS_BUSY;
+    return MPU9250_Fake_SendAddress(slaveAddress, R_nW, 0);
+}
+
+uint8 I2C_MPU9250_Master_MasterSendRestart(uint8 slaveAddress, uint8 R_nW) {
+    if (state != MPU9250_FAKE_BUS_OWNED && state != MPU9250_FAKE_BUS_HALTED)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+    return MPU9250_Fake_SendAddress(slaveAddress, R_nW, 1);
+}
+
+uint8 I2C_MPU9250_Master_MasterSendStop(void) {
+    if (state != MPU9250_FAKE_BUS_OWNED && state != MPU9250_FAKE_BUS_HALTED)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+    MPU9250_Fake_Wait(1);
+    MPU9250_Fake_End(1);
+    status &= ~I2C_MPU9250_Master_MSTAT_XFER_HALT;
+    return I2C_MPU9250_Master_MSTR_NO_ERROR;
+}
+
+uint8 I2C_MPU9250_Master_MasterWriteByte(uint8 theByte) {
+    if (state != MPU9250_FAKE_BUS_OWNED || direction != I2C_MPU9250_Master_WRITE_XFER_MODE)
+        return I2C_MPU9250_Master_MSTR_NOT_READY;
+    MPU9250_Fake_Wait(9);
+    if (!acked)
+        return I2C_MPU9250_Master_MSTR_ERR_LB_NAK;
+    MPU9250_Fake_WriteByte(slave, theByte);
+    MPU9250_Fake_Bytes(1);
+    return I2C_MPU9250_Master_MSTR_NO_ERROR;
+}
+
+uint8 I2C_MPU9250_Master_MasterReadByte(uint8 acknNak) {
+    (void) acknNak;
+    if (state != MPU9250_FAKE_BUS_OWNED || direction != I2C_MPU9250_Master_READ_XFER_MODE || !acked)
+        return 0xFF;
+    MPU9250_Fake_Wait(9);
+    MPU9250_Fake_Bytes(1);
+    return MPU9250_Fake_ReadByte(slave);
+}
+
+void SCL_1_Write(uint8 value) {
+    uint8_t rising = value && !scl_out;
+    scl_out = value ? 1 : 0;
+    // A slave holding SDA releases it after some clocks
+    if (!(SCL_1_BYP & SCL_1_MASK) && rising && sda_hold > 0) {
+        sda_hold--;
+    }
+}
+
+uint8 SCL_1_Read(void) {
+    return (SCL_1_BYP & SCL_1_MASK) ? 1 : scl_out;
+}
+
+void SDA_1_Write(uint8 value) {
+    uint8_t rising = value && !sda_out;
+    sda_out = value ? 1 : 0;
+    // STOP generated by the firmware: SDA rising while SCL is high
+    if (!(SDA_1_BYP & SDA_1_MASK) && !(SCL_1_BYP & SCL_1_MASK) && rising && scl_out && sda_hold == 0) {
+        counters.recoveries++;
+    }
+}
+
+uint8 SDA_1_Read(void) {
+    if (sda_hold > 0)
+        return 0;
+    return (SDA_1_BYP & SDA_1_MASK) ? 1 : sda_out;
+}
+
+void MPU9250_Fake_I2C_Reset(void) {
+    I2C_MPU9250_Master_initVar = 0;
+    SCL_1_BYP = SCL_1_MASK;
+    SDA_1_BYP = SDA_1_MASK;
+    enabled = 0;
+    state = MPU9250_FAKE_BUS_FREE;
+    status = 0;
+    irq_pending = 0;
+    in_isr = 0;
+    bit_ns = 1000000000u / MPU9250_FAKE_BITRATE;
+    fail_skip = 0;
+    fail_transfers = 0;
+    sda_hold = 0;
+    scl_out = 1;
+    sda_out = 1;
+    memset(&counters, 0, sizeof(counters));
+}
+
+void MPU9250_Fake_I2C_Run(void) {
+    // Serve the interrupt of the transfers that ended, unless already serving it
+    for (;;) {
+        if (state == MPU9250_FAKE_BUS_XFER && MPU9250_Fake_GetTimeNs() >= xfer_end_ns) {
+            MPU9250_Fake_CompleteBuf();
+            irq_pending = 1;
+        }
+        if (!irq_pending || in_isr)
+            return;
+        irq_pending = 0;
+        in_isr = 1;
+        I2C_MPU9250_Master_ISR_ExitCallback();
+        in_isr = 0;
+    }
+}
+
+void MPU9250_Fake_Fail(uint8_t skip, uint8_t transfers, MPU9250_Fake_Fault fault) {
+    fail_skip = skip;
+    fail_transfers = transfers;
+    fail_fault = fault;
+}
+
+void MPU9250_Fake_SetBitrate(uint32_t bitrate) {
+    bit_ns = 1000000000u / bitrate;
+}
+
+void MPU9250_Fake_GetCounters(MPU9250_Fake_Counters* fake_counters) {
+    *fake_counters = counters;
+}
+
+const MPU9250_Fake_Transaction* MPU9250_Fake_GetTransaction(uint32_t index) {
+    if (index >= counters.transactions || counters.transactions - index > MPU9250_FAKE_LOG_SIZE)
+        return NULL;
+    return &transactions[index % MPU9250_FAKE_LOG_SIZE];
+}
+/* [] END OF FILE */
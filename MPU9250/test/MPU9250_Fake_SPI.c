@@ -0,0 +1,176 @@
+/*
+ * @brief Function definitions for the simulated SPI master component, for host tests.
+ *
+ * This file contains the simulated SPI master component (SPI_MPU9250_Master),
+ * its clock and the simulated SPI_MPU9250_CS pin, connected to the MPU9250
+ * of MPU9250_Fake.c. Bytes written to the TX FIFO are shifted out one
+ * after the other, each taking 16 periods of the component clock; the
+ * byte shifted in by the device is then put in the RX FIFO, and lost if
+ * the RX FIFO is full.
+ *
+ * While the chip select line is low, the first byte holds the register
+ * address, with the MSB set for a read; the next bytes are read from or
+ * written to the registers, from that address on.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "SPI_MPU9250_Master.h"
+#include "SPI_MPU9250_Master_IntClock.h"
+#include "SPI_MPU9250_CS.h"
+#include "cyfitter.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define MPU9250_FAKE_SPI_FIFO_SIZE 4   // Depth of the TX and RX FIFOs
+#define MPU9250_FAKE_SPI_READ_BIT  0x80
+
+/* ========= VARIABLES ========= */
+uint8 SPI_MPU9250_Master_initVar = 0;
+
+static uint8_t enabled = 0;                           // Component started
+static uint8_t tx_fifo[MPU9250_FAKE_SPI_FIFO_SIZE];   // Bytes to be shifted out
+static uint8_t tx_head = 0;
+static uint8_t tx_count = 0;
+static uint8_t rx_fifo[MPU9250_FAKE_SPI_FIFO_SIZE];   // Bytes shifted in
+static uint8_t rx_head = 0;
+static uint8_t rx_count = 0;
+static uint8_t shifting = 0;                          // Byte being shifted
+static uint8_t shift_byte = 0;                        // Value of the byte being shifted
+static uint64_t shift_end_ns = 0;                     // End of the byte being shifted
+static uint16_t divider = 1;                          // Divider of the component clock
+static uint8_t cs = 1;                                // Chip select line
+static uint8_t header = 0;                            // Header received in this transaction
+static uint8_t read = 0;                              // Transaction is a read
+static uint8_t stalled = 0;                           // Clock stopped
+static MPU9250_Fake_SPI_Counters counters;            // Bus activity
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint64_t MPU9250_Fake_SPI_ByteNs(void) {
+    // The component clock runs at twice the SPI clock
+    return (uint64_t) 16 * divider * 1000000000u / BCLK__BUS_CLK__HZ;
+}
+
+static uint8_t MPU9250_Fake_SPI_Exchange(uint8_t mosi) {
+    // Byte seen by the MPU9250, if selected, and its answer
+    if (cs)
+        return 0xFF;
+    counters.bytes++;
+    if (!header) {
+        header = 1;
+        read = (mosi & MPU9250_FAKE_SPI_READ_BIT) != 0;
+        MPU9250_Fake_Address(MPU9250_I2C_ADDRESS, 0);
+        MPU9250_Fake_WriteByte(MPU9250_I2C_ADDRESS, mosi & ~MPU9250_FAKE_SPI_READ_BIT);
+        return 0xFF;
+    }
+    if (read)
+        return MPU9250_Fake_ReadByte(MPU9250_I2C_ADDRESS);
+    MPU9250_Fake_WriteByte(MPU9250_I2C_ADDRESS, mosi);
+    return 0xFF;
+}
+
+static void MPU9250_Fake_SPI_Shift(uint64_t start_ns) {
+    // Start shifting the next byte of the TX FIFO, if any
+    if (shifting || stalled || tx_count == 0)
+        return;
+    shift_byte = tx_fifo[tx_head];
+    tx_head = (tx_head + 1) % MPU9250_FAKE_SPI_FIFO_SIZE;
+    tx_count--;
+    shifting = 1;
+    shift_end_ns = start_ns + MPU9250_Fake_SPI_ByteNs();
+}
+
+/* ========= FUNCTIONS ========= */
+void SPI_MPU9250_Master_Start(void) {
+    SPI_MPU9250_Master_initVar = 1;
+    enabled = 1;
+}
+
+void SPI_MPU9250_Master_ClearFIFO(void) {
+    tx_count = 0;
+    rx_count = 0;
+}
+
+void SPI_MPU9250_Master_WriteTxData(uint8 txData) {
+    // The component waits for room in the TX FIFO
+    while (tx_count == MPU9250_FAKE_SPI_FIFO_SIZE && !stalled) {
+        MPU9250_Fake_Advance(1);
+    }
+    if (!enabled || tx_count == MPU9250_FAKE_SPI_FIFO_SIZE)
+        return;
+    tx_fifo[(tx_head + tx_count) % MPU9250_FAKE_SPI_FIFO_SIZE] = txData;
+    tx_count++;
+    MPU9250_Fake_SPI_Shift(MPU9250_Fake_GetTimeNs());
+}
+
+uint8 SPI_MPU9250_Master_GetRxBufferSize(void) {
+    return rx_count;
+}
+
+uint8 SPI_MPU9250_Master_ReadRxData(void) {
+    if (rx_count == 0)
+        return 0;
+    uint8_t byte = rx_fifo[rx_head];
+    rx_head = (rx_head + 1) % MPU9250_FAKE_SPI_FIFO_SIZE;
+    rx_count--;
+    return byte;
+}
+
+void SPI_MPU9250_Master_IntClock_SetDividerValue(uint16 clkDivider) {
+    divider = clkDivider;
+}
+
+void SPI_MPU9250_CS_Write(uint8 value) {
+    value = value ? 1 : 0;
+    if (!cs && value) {
+        // End of the transaction
+        counters.transactions++;
+    } else if (cs && !value) {
+        header = 0;
+    }
+    cs = value;
+}
+
+uint8 SPI_MPU9250_CS_Read(void) {
+    return cs;
+}
+
+void MPU9250_Fake_SPI_Reset(void) {
+    SPI_MPU9250_Master_initVar = 0;
+    enabled = 0;
+    tx_count = 0;
+    rx_count = 0;
+    shifting = 0;
+    divider = 1;
+    cs = 1;
+    stalled = 0;
+    memset(&counters, 0, sizeof(counters));
+}
+
+void MPU9250_Fake_SPI_Run(void) {
+    // Complete the bytes shifted by now, back-to-back
+    while (shifting && !stalled && MPU9250_Fake_GetTimeNs() >= shift_end_ns) {
+        uint8_t miso = MPU9250_Fake_SPI_Exchange(shift_byte);
+        if (rx_count < MPU9250_FAKE_SPI_FIFO_SIZE) {
+            rx_fifo[(rx_head + rx_count) % MPU9250_FAKE_SPI_FIFO_SIZE] = miso;
+            rx_count++;
+        } else {
+            counters.overflows++;
+        }
+        shifting = 0;
+        MPU9250_Fake_SPI_Shift(shift_end_ns);
+    }
+}
+
+void MPU9250_Fake_SPI_Stall(uint8_t stall) {
+    stalled = stall;
+    MPU9250_Fake_SPI_Shift(MPU9250_Fake_GetTimeNs());
+}
+
+void MPU9250_Fake_SPI_GetCounters(MPU9250_Fake_SPI_Counters* fake_counters) {
+    *fake_counters = counters;
+}
+/* [] END OF FILE */
@@ -0,0 +1,429 @@
+/** @file MPU9250_Motion.h
+ * @brief Header file for the synthetic motion of the AHRS host programs.
+ *
+ * A rigid body rotates with a known rate: its orientation is integrated
+ * in double precision and sampled as the raw accelerometer (2 g), gyroscope
+ * (250 dps) and AK8963 (16 bit) values that the driver would read, with
+ * uniform noise and an optional gyroscope bias. The accelerometer sees
+ * gravity only.
+ *
+ * The double precision filters of the reference take the same raw values,
+ * converted with the same scales and axes of MPU9250_Ahrs.c, and the gains
+ * of MPU9250_Ahrs.h, so that the fixed point filter can be compared with
+ * them sample by sample. #MPU9250_Reference_Update runs the filter
+ * selected by #MPU9250_AHRS_ENGINE.
+ *
+ * Quaternions are (w, x, y, z) and rotate vectors from the body frame to
+ * the earth frame (z up, x towards the magnetic north), as in MPU9250_Ahrs.h.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_MOTION_H_
+
+    #define __MPU9250_MOTION_H_
+
+    // Include required libraries
+
+    #include <math.h>
+    #include <stddef.h>
+    #include <stdint.h>
+    #include "MPU9250_Ahrs.h"
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Gyroscope LSB per rad/s, at 250 dps.
+    */
+    #define MPU9250_MOTION_GYRO_LSB (32768.0 / (250.0 * M_PI / 180.0))
+
+    /**
+    * @brief Accelerometer LSB per g, at 2 g.
+    */
+    #define MPU9250_MOTION_ACC_LSB 16384.0
+
+    /**
+    * @brief Magnitude of the magnetic field, in AK8963 LSB (about 50 uT).
+    */
+    #define MPU9250_MOTION_MAG_LSB 330.0
+
+    /**
+    * @brief Inclination of the magnetic field below the horizon, in rad.
+    */
+    #define MPU9250_MOTION_MAG_DIP (60.0 * M_PI / 180.0)
+
+    /**
+    * @brief Integration steps of the true orientation in a sample period.
+    */
+    #define MPU9250_MOTION_SUBSTEPS 8
+
+    /* ========= TYPE DEFS ========= */
+
+    /**
+    * @brief Synthetic motion.
+    */
+    typedef struct {
+        /** True orientation **/
+        double q[4];
+        /** Time, in s **/
+        double t;
+        /** Amplitude of the rotation rate (1 for the default motion, 0 at rest) **/
+        double spin;
+        /** Gyroscope bias, in LSB **/
+        double bias[3];
+        /** Noise amplitude of the accelerometer, gyroscope and magnetometer, in LSB **/
+        double noise[3];
+        /** State of the noise generator **/
+        uint32_t seed;
+    } MPU9250_Motion;
+
+    /**
+    * @brief Double precision filter of the reference.
+    */
+    typedef struct {
+        /** Orientation **/
+        double q[4];
+        /** Sample period, in s **/
+        double dt;
+        /** Gain of the gradient descent step (Madgwick), in rad/s **/
+        double beta;
+        /** Proportional gain (Mahony), in 1/s **/
+        double kp;
+        /** Integral gain (Mahony), in 1/s^2 **/
+        double ki;
+        /** Estimated gyroscope bias (Mahony), to be added to the measured rate, in rad/s **/
+        double bias[3];
+    } MPU9250_Reference;
+
+    /* ========= FUNCTIONS ========= */
+
+    /**
+    * @brief Rotate a vector from the body frame to the earth frame (inverse 0)
+    *        or back (inverse 1).
+    */
+    static inline void MPU9250_Motion_Rotate(const double* q, const double* v, double* r, int inverse) {
+        double w = q[0], x = inverse ? -q[1] : q[1], y = inverse ? -q[2] : q[2], z = inverse ? -q[3] : q[3];
+        double tx = 2 * (y * v[2] - z * v[1]);
+        double ty = 2 * (z * v[0] - x * v[2]);
+        double tz = 2 * (x * v[1] - y * v[0]);
+        r[0] = v[0] + w * tx + y * tz - z * ty;
+        r[1] = v[1] + w * ty + z * tx - x * tz;
+        r[2] = v[2] + w * tz + x * ty - y * tx;
+    }
+
+    /**
+    * @brief Normalize a vector of n elements, if not null.
+    */
+    static inline int MPU9250_Motion_Normalize(double* v, int n) {
+        double s = 0;
+        for (int i = 0; i < n; i++)
+            s += v[i] * v[i];
+        if (s == 0)
+            return 0;
+        s = 1 / sqrt(s);
+        for (int i = 0; i < n; i++)
+            v[i] *= s;
+        return 1;
+    }
+
+    /**
+    * @brief Angle between two orientations, in degrees.
+    */
+    static inline double MPU9250_Motion_Angle(const double* a, const double* b) {
+        double dot = fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+        return 2 * acos(dot > 1 ? 1 : dot) * 180 / M_PI;
+    }
+
+    /**
+    * @brief Angle between the vertical of two orientations (tilt), in degrees.
+    */
+    static inline double MPU9250_Motion_Tilt(const double* a, const double* b) {
+        const double up[3] = {0, 0, 1};
+        double va[3], vb[3];
+        MPU9250_Motion_Rotate(a, up, va, 1);
+        MPU9250_Motion_Rotate(b, up, vb, 1);
+        double dot = va[0] * vb[0] + va[1] * vb[1] + va[2] * vb[2];
+        return acos(dot > 1 ? 1 : dot) * 180 / M_PI;
+    }
+
+    /**
+    * @brief Quaternion of a Q2.30 quaternion.
+    */
+    static inline void MPU9250_Motion_FromQ30(const int32_t* q, double* r) {
+        for (int i = 0; i < 4; i++)
+            r[i] = q[i] / 1073741824.0;
+    }
+
+    /**
+    * @brief Start a motion at rest, from an orientation given as yaw, pitch
+    *        and roll (z, y, x), in degrees, without bias and noise.
+    */
+    static inline void MPU9250_Motion_Init(MPU9250_Motion* motion, double yaw, double pitch, double roll) {
+        double cy = cos(yaw * M_PI / 360), sy = sin(yaw * M_PI / 360);
+        double cp = cos(pitch * M_PI / 360), sp = sin(pitch * M_PI / 360);
+        double cr = cos(roll * M_PI / 360), sr = sin(roll * M_PI / 360);
+        motion->q[0] = cy * cp * cr + sy * sp * sr;
+        motion->q[1] = cy * cp * sr - sy * sp * cr;
+        motion->q[2] = cy * sp * cr + sy * cp * sr;
+        motion->q[3] = sy * cp * cr - cy * sp * sr;
+        motion->t = 0;
+        motion->spin = 0;
+        for (int i = 0; i < 3; i++) {
+            motion->bias[i] = 0;
+            motion->noise[i] = 0;
+        }
+        motion->seed = 1;
+    }
+
+    /**
+    * @brief Rotation rate of the body at a time, in rad/s.
+    */
+    static inline void MPU9250_Motion_Rate(const MPU9250_Motion* motion, double t, double* w) {
+        w[0] = motion->spin * 1.5 * sin(0.7 * t);
+        w[1] = motion->spin * 1.2 * sin(0.5 * t + 1);
+        w[2] = motion->spin * 1.8 * sin(0.3 * t + 2);
+    }
+
+    /**
+    * @brief Uniform noise in [-amplitude, amplitude].
+    */
+    static inline double MPU9250_Motion_Noise(MPU9250_Motion* motion, double amplitude) {
+        motion->seed = motion->seed * 1664525u + 1013904223u;
+        return amplitude * ((motion->seed >> 8) / 8388608.0 - 1);
+    }
+
+    /**
+    * @brief Raw value of a measurement.
+    */
+    static inline int16_t MPU9250_Motion_Raw(MPU9250_Motion* motion, double value, double noise) {
+        value = floor(value + MPU9250_Motion_Noise(motion, noise) + 0.5);
+        return (int16_t) (value > 32767 ? 32767 : value < -32768 ? -32768 : value);
+    }
+
+    /**
+    * @brief Move the body for a sample period, and sample it.
+    *
+    * The gyroscope gives the rate at the middle of the period, the
+    * accelerometer and the magnetometer the orientation at its end.
+    * @param[in,out] motion: motion.
+    * @param[in] dt: sample period, in s.
+    * @param[out] acc: raw accelerometer values, body axes.
+    * @param[out] gyro: raw gyroscope values, body axes.
+    * @param[out] mag: raw magnetometer values, AK8963 axes.
+    */
+    static inline void MPU9250_Motion_Step(MPU9250_Motion* motion, double dt,
+                                           int16_t* acc, int16_t* gyro, int16_t* mag) {
+        double w[3];
+
+        MPU9250_Motion_Rate(motion, motion->t + dt / 2, w);
+        for (int i = 0; i < 3; i++) {
+            gyro[i] = MPU9250_Motion_Raw(motion, w[i] * MPU9250_MOTION_GYRO_LSB + motion->bias[i], motion->noise[1]);
+        }
+
+        // True orientation: exact rotation over each substep
+        for (int k = 0; k < MPU9250_MOTION_SUBSTEPS; k++) {
+            double h = dt / MPU9250_MOTION_SUBSTEPS;
+            MPU9250_Motion_Rate(motion, motion->t + (k + 0.5) * h, w);
+            double angle = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]) * h;
+            if (angle > 0) {
+                double s = sin(angle / 2) / (angle / h);
+                double r[4] = {cos(angle / 2), w[0] * s, w[1] * s, w[2] * s};
+                double* q = motion->q;
+                double p[4] = {
+                    q[0] * r[0] - q[1] * r[1] - q[2] * r[2] - q[3] * r[3],
+                    q[0] * r[1] + q[1] * r[0] + q[2] * r[3] - q[3] * r[2],
+                    q[0] * r[2] - q[1] * r[3] + q[2] * r[0] + q[3] * r[1],
+                    q[0] * r[3] + q[1] * r[2] - q[2] * r[1] + q[3] * r[0]
+                };
+                for (int i = 0; i < 4; i++)
+                    q[i] = p[i];
+                MPU9250_Motion_Normalize(q, 4);
+            }
+        }
+        motion->t += dt;
+
+        // Gravity and magnetic field in the body frame
+        const double up[3] = {0, 0, 1};
+        const double field[3] = {cos(MPU9250_MOTION_MAG_DIP), 0, -sin(MPU9250_MOTION_MAG_DIP)};
+        double a[3], m[3];
+        MPU9250_Motion_Rotate(motion->q, up, a, 1);
+        MPU9250_Motion_Rotate(motion->q, field, m, 1);
+        for (int i = 0; i < 3; i++) {
+            acc[i] = MPU9250_Motion_Raw(motion, a[i] * MPU9250_MOTION_ACC_LSB, motion->noise[0]);
+        }
+        // AK8963 x and y are the body y and x, z is opposite
+        mag[0] = MPU9250_Motion_Raw(motion, m[1] * MPU9250_MOTION_MAG_LSB, motion->noise[2]);
+        mag[1] = MPU9250_Motion_Raw(motion, m[0] * MPU9250_MOTION_MAG_LSB, motion->noise[2]);
+        mag[2] = MPU9250_Motion_Raw(motion, -m[2] * MPU9250_MOTION_MAG_LSB, motion->noise[2]);
+    }
+
+    /**
+    * @brief Start a reference filter from the identity, with the gains of
+    *        MPU9250_Ahrs.h.
+    */
+    static inline void MPU9250_Reference_Init(MPU9250_Reference* ref, double dt) {
+        ref->q[0] = 1;
+        ref->q[1] = ref->q[2] = ref->q[3] = 0;
+        ref->dt = dt;
+        ref->beta = MPU9250_AHRS_BETA;
+        ref->kp = MPU9250_AHRS_KP;
+        ref->ki = MPU9250_AHRS_KI;
+        ref->bias[0] = ref->bias[1] = ref->bias[2] = 0;
+    }
+
+    /**
+    * @brief Magnetic field of raw values in the body frame, normalized,
+    *        aligned as in MPU9250_Ahrs.c.
+    * @return 0 if there is no magnetometer vector.
+    */
+    static inline int MPU9250_Reference_Mag(const int16_t* mag, double* m) {
+        if (mag == NULL)
+            return 0;
+        m[0] = mag[1];
+        m[1] = mag[0];
+        m[2] = -mag[2];
+        return MPU9250_Motion_Normalize(m, 3);
+    }
+
+    /**
+    * @brief Integrate a rotation rate, in rad/s, and a step (or NULL) in a sample period.
+    */
+    static inline void MPU9250_Reference_Integrate(MPU9250_Reference* ref, const double* g, const double* step) {
+        double* q = ref->q;
+        double dq[4] = {
+            0.5 * (-q[1] * g[0] - q[2] * g[1] - q[3] * g[2]),
+            0.5 * ( q[0] * g[0] + q[2] * g[2] - q[3] * g[1]),
+            0.5 * ( q[0] * g[1] - q[1] * g[2] + q[3] * g[0]),
+            0.5 * ( q[0] * g[2] + q[1] * g[1] - q[2] * g[0])
+        };
+        for (int i = 0; i < 4; i++)
+            q[i] += (dq[i] - (step != NULL ? step[i] : 0)) * ref->dt;
+        MPU9250_Motion_Normalize(q, 4);
+    }
+
+    /**
+    * @brief Update the reference Madgwick filter with raw values.
+    *
+    * The gradient is J^T f of the Madgwick report, for gravity and, if mag
+    * is not NULL, for the magnetic field.
+    */
+    static inline void MPU9250_Reference_Madgwick(MPU9250_Reference* ref, const int16_t* acc,
+                                                  const int16_t* gyro, const int16_t* mag) {
+        const double* q = ref->q;
+        double g[3], a[3] = {acc[0], acc[1], acc[2]};
+        double m[3];
+        double s[4] = {0, 0, 0, 0};
+        int i;
+
+        for (i = 0; i < 3; i++)
+            g[i] = gyro[i] / MPU9250_MOTION_GYRO_LSB;
+        if (!MPU9250_Motion_Normalize(a, 3)) {
+            MPU9250_Reference_Integrate(ref, g, NULL);
+            return;
+        }
+
+        // Gravity
+        double f[3] = {
+            2 * (q[1] * q[3] - q[0] * q[2]) - a[0],
+            2 * (q[0] * q[1] + q[2] * q[3]) - a[1],
+            1 - 2 * (q[1] * q[1] + q[2] * q[2]) - a[2]
+        };
+        s[0] = -2 * q[2] * f[0] + 2 * q[1] * f[1];
+        s[1] =  2 * q[3] * f[0] + 2 * q[0] * f[1] - 4 * q[1] * f[2];
+        s[2] = -2 * q[0] * f[0] + 2 * q[3] * f[1] - 4 * q[2] * f[2];
+        s[3] =  2 * q[1] * f[0] + 2 * q[2] * f[1];
+
+        // Magnetic field
+        if (MPU9250_Reference_Mag(mag, m)) {
+            double h[3];
+            MPU9250_Motion_Rotate(q, m, h, 0);
+            double bx = sqrt(h[0] * h[0] + h[1] * h[1]);
+            double bz = h[2];
+            double e[3] = {
+                bx * (1 - 2 * (q[2] * q[2] + q[3] * q[3])) + 2 * bz * (q[1] * q[3] - q[0] * q[2]) - m[0],
+                2 * bx * (q[1] * q[2] - q[0] * q[3]) + 2 * bz * (q[0] * q[1] + q[2] * q[3]) - m[1],
+                2 * bx * (q[0] * q[2] + q[1] * q[3]) + bz * (1 - 2 * (q[1] * q[1] + q[2] * q[2])) - m[2]
+            };
+            s[0] += -2 * bz * q[2] * e[0] + (-2 * bx * q[3] + 2 * bz * q[1]) * e[1] + 2 * bx * q[2] * e[2];
+            s[1] +=  2 * bz * q[3] * e[0] + ( 2 * bx * q[2] + 2 * bz * q[0]) * e[1] +
+                    (2 * bx * q[3] - 4 * bz * q[1]) * e[2];
+            s[2] += (-4 * bx * q[2] - 2 * bz * q[0]) * e[0] + (2 * bx * q[1] + 2 * bz * q[3]) * e[1] +
+                    (2 * bx * q[0] - 4 * bz * q[2]) * e[2];
+            s[3] += (-4 * bx * q[3] + 2 * bz * q[1]) * e[0] + (-2 * bx * q[0] + 2 * bz * q[2]) * e[1] +
+                     2 * bx * q[1] * e[2];
+        }
+
+        if (MPU9250_Motion_Normalize(s, 4)) {
+            for (i = 0; i < 4; i++)
+                s[i] *= ref->beta;
+            MPU9250_Reference_Integrate(ref, g, s);
+        } else {
+            MPU9250_Reference_Integrate(ref, g, NULL);
+        }
+    }
+
+    /**
+    * @brief Update the reference Mahony filter with raw values.
+    *
+    * The error is the cross product of the measured and the estimated
+    * directions of gravity and, if mag is not NULL, of the magnetic field.
+    * As in MPU9250_Ahrs.c, the rate is corrected with the bias estimated
+    * up to the previous sample.
+    */
+    static inline void MPU9250_Reference_Mahony(MPU9250_Reference* ref, const int16_t* acc,
+                                                const int16_t* gyro, const int16_t* mag) {
+        const double* q = ref->q;
+        double g[3], a[3] = {acc[0], acc[1], acc[2]};
+        double m[3];
+        int i;
+
+        for (i = 0; i < 3; i++)
+            g[i] = gyro[i] / MPU9250_MOTION_GYRO_LSB + ref->bias[i];
+        if (!MPU9250_Motion_Normalize(a, 3)) {
+            MPU9250_Reference_Integrate(ref, g, NULL);
+            return;
+        }
+
+        // Half of the error: a x v + m x w, with v and w half of the estimated directions
+        double v[3] = {
+            q[1] * q[3] - q[0] * q[2],
+            q[0] * q[1] + q[2] * q[3],
+            q[0] * q[0] - 0.5 + q[3] * q[3]
+        };
+        double e[3] = {
+            a[1] * v[2] - a[2] * v[1],
+            a[2] * v[0] - a[0] * v[2],
+            a[0] * v[1] - a[1] * v[0]
+        };
+        if (MPU9250_Reference_Mag(mag, m)) {
+            double h[3], w[3];
+            MPU9250_Motion_Rotate(q, m, h, 0);
+            double b[3] = {0.5 * sqrt(h[0] * h[0] + h[1] * h[1]), 0, 0.5 * h[2]};
+            MPU9250_Motion_Rotate(q, b, w, 1);
+            e[0] += m[1] * w[2] - m[2] * w[1];
+            e[1] += m[2] * w[0] - m[0] * w[2];
+            e[2] += m[0] * w[1] - m[1] * w[0];
+        }
+
+        for (i = 0; i < 3; i++) {
+            ref->bias[i] += 2 * ref->ki * e[i] * ref->dt;
+            g[i] += 2 * ref->kp * e[i];
+        }
+        MPU9250_Reference_Integrate(ref, g, NULL);
+    }
+
+    /**
+    * @brief Update the reference filter selected by #MPU9250_AHRS_ENGINE.
+    */
+    static inline void MPU9250_Reference_Update(MPU9250_Reference* ref, const int16_t* acc,
+                                                const int16_t* gyro, const int16_t* mag) {
+    #if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+        MPU9250_Reference_Mahony(ref, acc, gyro, mag);
+    #else
+        MPU9250_Reference_Madgwick(ref, acc, gyro, mag);
+    #endif
+    }
+
+#endif
+/* [] END OF FILE */
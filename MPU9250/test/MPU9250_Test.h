@@ -0,0 +1,46 @@
+/** @file MPU9250_Test.h
+ * @brief Header file for the checks of the host tests.
+ *
+ * Each test program is a single translation unit: it checks its cases
+ * with #MPU9250_TEST_CHECK and returns #MPU9250_TEST_RESULT from main,
+ * so that make stops at the first failing program.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_TEST_H_
+
+    #define __MPU9250_TEST_H_
+
+    // Include required libraries
+
+    #include <stdio.h>
+
+    /* ========= VARIABLES ========= */
+    static unsigned int mpu9250_test_checks = 0;    // Checks done
+    static unsigned int mpu9250_test_failures = 0;  // Checks failed
+
+    /* ========= MACROS ========= */
+
+    /**
+    * @brief Check a condition, and report it if false.
+    */
+    #define MPU9250_TEST_CHECK(cond)                                              \
+        do {                                                                      \
+            mpu9250_test_checks++;                                                \
+            if (!(cond)) {                                                        \
+                mpu9250_test_failures++;                                          \
+                printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);  \
+            }                                                                     \
+        } while (0)
+
+    /**
+    * @brief Print the summary and give the exit status of the program.
+    */
+    #define MPU9250_TEST_RESULT()                                                 \
+        (printf("%s: %u checks, %u failed\n", __FILE__,                          \
+            mpu9250_test_checks, mpu9250_test_failures), mpu9250_test_failures != 0)
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,149 @@
+/*
+ * @brief Host benchmark of the AHRS.
+ *
+ * The fixed point filter of MPU9250_Ahrs.c and the double precision
+ * filter of the reference (MPU9250_Motion.h) are fed with the same raw
+ * samples of a synthetic motion, at 200 Hz for 60 s, with and without
+ * the magnetometer. The time per update of both is printed, with the
+ * largest angle between their orientations and their error from the
+ * true orientation (tilt only without the magnetometer), also with a
+ * gyroscope bias. The filter is the one of MPU9250_AHRS_ENGINE:
+ * make compare builds this benchmark for both. On the host
+ * the double filter runs on the FPU: on the PSoC 5LP it is emulated in
+ * software.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Bench.h"
+#include "MPU9250_Motion.h"
+#include "MPU9250.h"
+#include "MPU9250_Ahrs.h"
+
+/* ========= MACROS ========= */
+#define PERIOD_US 5000  // Sample period
+#define SAMPLES 12000   // Samples of the motion, 60 s
+#define REPEAT 50       // Runs over the samples of each timed loop
+#define BIAS_LSB 30     // Gyroscope bias of the last motion, in LSB
+#define MAX_DIFF 0.2    // Largest angle accepted from the reference, in degrees
+
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    #define ENGINE "Mahony"
+#else
+    #define ENGINE "Madgwick"
+#endif
+
+/* ========= VARIABLES ========= */
+static int16_t acc[SAMPLES][3];   // Raw accelerometer values
+static int16_t gyro[SAMPLES][3];  // Raw gyroscope values
+static int16_t mag[SAMPLES][3];   // Raw magnetometer values
+static double truth[SAMPLES][4];  // True orientation after each sample
+
+/* ========= STATIC FUNCTIONS ========= */
+static void Record(double bias) {
+    MPU9250_Motion motion;
+
+    // Moving body, with the noise of the sensors at rest
+    MPU9250_Motion_Init(&motion, 0, 0, 0);
+    motion.spin = 1;
+    motion.noise[0] = 40;
+    motion.noise[1] = 4;
+    motion.noise[2] = 3;
+    for (uint8_t i = 0; i < 3; i++)
+        motion.bias[i] = bias;
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        MPU9250_Motion_Step(&motion, PERIOD_US * 1e-6, acc[i], gyro[i], mag[i]);
+        for (uint8_t k = 0; k < 4; k++)
+            truth[i][k] = motion.q[k];
+    }
+}
+
+static void Time(int marg) {
+    MPU9250_Ahrs ahrs;
+    MPU9250_Reference ref;
+
+    MPU9250_Bench bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US);
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            MPU9250_Ahrs_Update(&ahrs, acc[i], gyro[i], marg ? mag[i] : NULL);
+        mpu9250_bench_sink += ahrs.q[r % 4];
+    }
+    double fixed_ns = MPU9250_Bench_End(bench, "MPU9250_Ahrs_Update", REPEAT * SAMPLES);
+
+    bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        MPU9250_Reference_Init(&ref, PERIOD_US * 1e-6);
+        for (uint32_t i = 0; i < SAMPLES; i++)
+            MPU9250_Reference_Update(&ref, acc[i], gyro[i], marg ? mag[i] : NULL);
+        mpu9250_bench_sink += (int32_t) (ref.q[r % 4] * 1000);
+    }
+    double ref_ns = MPU9250_Bench_End(bench, "double precision reference", REPEAT * SAMPLES);
+    printf("    double / fixed point %.2fx\n", ref_ns / fixed_ns);
+}
+
+static int Compare(const char* name, int marg) {
+    MPU9250_Ahrs ahrs;
+    MPU9250_Reference ref;
+    double q[4];
+
+    // Error from the truth over the second half, after the bias estimate, if any, settles
+    double diff = 0;
+    double fixed_err = 0;
+    double ref_err = 0;
+    MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US);
+    MPU9250_Reference_Init(&ref, PERIOD_US * 1e-6);
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        MPU9250_Ahrs_Update(&ahrs, acc[i], gyro[i], marg ? mag[i] : NULL);
+        MPU9250_Reference_Update(&ref, acc[i], gyro[i], marg ? mag[i] : NULL);
+        MPU9250_Motion_FromQ30(ahrs.q, q);
+        diff = fmax(diff, MPU9250_Motion_Angle(q, ref.q));
+        if (i < SAMPLES / 2) {
+            continue;
+        } else if (marg) {
+            fixed_err = fmax(fixed_err, MPU9250_Motion_Angle(q, truth[i]));
+            ref_err = fmax(ref_err, MPU9250_Motion_Angle(ref.q, truth[i]));
+        } else {
+            fixed_err = fmax(fixed_err, MPU9250_Motion_Tilt(q, truth[i]));
+            ref_err = fmax(ref_err, MPU9250_Motion_Tilt(ref.q, truth[i]));
+        }
+    }
+    printf("    largest angle from the reference       %.3f deg\n", diff);
+    printf("    largest %s error, fixed point        %.3f deg\n", marg ? "angle" : "tilt ", fixed_err);
+    printf("    largest %s error, reference          %.3f deg\n", marg ? "angle" : "tilt ", ref_err);
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    printf("    bias estimate, fixed point             %.1f %.1f %.1f LSB\n",
+        ahrs.bias[0] / 65536.0, ahrs.bias[1] / 65536.0, ahrs.bias[2] / 65536.0);
+    printf("    bias estimate, reference               %.1f %.1f %.1f LSB\n",
+        ref.bias[0] * MPU9250_MOTION_GYRO_LSB, ref.bias[1] * MPU9250_MOTION_GYRO_LSB,
+        ref.bias[2] * MPU9250_MOTION_GYRO_LSB);
+#endif
+    if (diff > MAX_DIFF) {
+        printf("%s: %s more than %.1f deg from the reference\n", __FILE__, name, MAX_DIFF);
+        return 1;
+    }
+    return 0;
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    int err = 0;
+
+    printf("%s: " ENGINE ", %u byte state, %u Hz for %u s, error over the last %u s\n", __FILE__,
+        (unsigned) sizeof(MPU9250_Ahrs), 1000000 / PERIOD_US, SAMPLES * PERIOD_US / 1000000,
+        SAMPLES * PERIOD_US / 2000000);
+    Record(0);
+    printf("  IMU update, accelerometer and gyroscope\n");
+    Time(0);
+    err |= Compare("IMU update", 0);
+    printf("  MARG update, with the magnetometer\n");
+    Time(1);
+    err |= Compare("MARG update", 1);
+
+    Record(BIAS_LSB);
+    printf("  MARG update, %d LSB of gyroscope bias\n", BIAS_LSB);
+    err |= Compare("MARG update with bias", 1);
+    return err;
+}
+/* [] END OF FILE */
@@ -0,0 +1,71 @@
+/*
+ * @brief Host benchmark of the FIFO frame decoder.
+ *
+ * Frames of accelerometer, temperature and gyroscope are decoded into
+ * per-axis arrays by MPU9250_Fifo_Decode, and by the per-sample
+ * (data[0] << 8) | data[1] pattern of MPU9250_ReadAcc. Both must give
+ * the same samples.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Bench.h"
+#include "MPU9250.h"
+#include "MPU9250_Fifo.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define FRAMES 256    // Frames of a batch, as drained from a full FIFO
+#define REPEAT 20000  // Batches decoded by each timed loop
+#define WORDS 7       // Accelerometer, temperature and gyroscope
+
+/* ========= VARIABLES ========= */
+static uint8_t data[FRAMES * WORDS * 2];  // Big-endian frames
+static int16_t batch[WORDS][FRAMES];      // Decoded by MPU9250_Fifo_Decode
+static int16_t sample[WORDS][FRAMES];     // Decoded one sample at a time
+
+/* ========= STATIC FUNCTIONS ========= */
+static void DecodeSamples(const uint8_t* frame, uint16_t frames) {
+    // Per-sample pattern of the register reads
+    for (uint16_t f = 0; f < frames; f++, frame += WORDS * 2) {
+        for (uint8_t w = 0; w < WORDS; w++) {
+            sample[w][f] = (int16_t) ((frame[2 * w] << 8) | frame[2 * w + 1]);
+        }
+    }
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    MPU9250_Fifo_Layout layout = {MPU9250_FIFO_ACCEL | MPU9250_FIFO_TEMP | MPU9250_FIFO_GYRO,
+                                  WORDS * 2, WORDS, 0};
+    MPU9250_Fifo_Samples samples = {{batch[0], batch[1], batch[2]}, batch[3],
+                                    {batch[4], batch[5], batch[6]}, NULL};
+
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 37 + 11);
+    }
+
+    printf("%s: %u frames of %u bytes\n", __FILE__, FRAMES, WORDS * 2);
+    MPU9250_Bench bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        MPU9250_Fifo_Decode(&layout, data, FRAMES, &samples);
+        mpu9250_bench_sink += batch[r % WORDS][r % FRAMES];
+    }
+    double decode_ns = MPU9250_Bench_End(bench, "MPU9250_Fifo_Decode, per frame", REPEAT * FRAMES);
+
+    bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        DecodeSamples(data, FRAMES);
+        mpu9250_bench_sink += sample[r % WORDS][r % FRAMES];
+    }
+    double sample_ns = MPU9250_Bench_End(bench, "per-sample shifts, per frame", REPEAT * FRAMES);
+    printf("  speedup %.2fx\n", sample_ns / decode_ns);
+
+    if (memcmp(batch, sample, sizeof(batch)) != 0) {
+        printf("%s: decoded samples differ\n", __FILE__);
+        return 1;
+    }
+    return 0;
+}
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*
+ * @brief Host benchmark of the unit conversion.
+ *
+ * Accelerometer values are converted to m/s^2 in Q16.16 by
+ * MPU9250_Units_AccBatch and MPU9250_Units_AccValue, and to float with
+ * a scale computed with pow() at each full scale change, as
+ * MPU9250_SetAccFS used to do (its scale, never applied, was 4 times too
+ * small: the one of 2^15 LSB is used here). Both are compared with a
+ * double precision conversion. On the host the float path runs on the
+ * FPU: on the PSoC 5LP it is emulated in software.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Bench.h"
+#include "MPU9250.h"
+#include "MPU9250_Units.h"
+#include <math.h>
+
+/* ========= MACROS ========= */
+#define COUNT 4096    // Values of a batch
+#define REPEAT 20000  // Batches converted by each timed loop
+#define G 9.80665     // Standard gravity, m/s^2
+
+/* ========= VARIABLES ========= */
+static int16_t raw[COUNT];      // Raw values, over the whole range
+static int32_t fixed[COUNT];    // Q16.16 values
+static float floating[COUNT];   // Float values
+static volatile int exponent = 15;  // Exponent of the pow() call
+
+/* ========= MAIN ========= */
+int main(void) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+        raw[i] = (int16_t) (i * 16 - 32768);
+    }
+
+    printf("%s: %u accelerometer values, 8 g, to m/s^2\n", __FILE__, COUNT);
+    MPU9250_Bench bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        MPU9250_Units_AccBatch(MPU9250_Acc_Unit_ms2, MPU9250_Acc_FS_8g, raw, fixed, COUNT);
+        mpu9250_bench_sink += fixed[r % COUNT];
+    }
+    double batch_ns = MPU9250_Bench_End(bench, "MPU9250_Units_AccBatch, per value", REPEAT * COUNT);
+
+    bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            fixed[i] = MPU9250_Units_AccValue(MPU9250_Acc_Unit_ms2, MPU9250_Acc_FS_8g, raw[i]);
+        }
+        mpu9250_bench_sink += fixed[r % COUNT];
+    }
+    MPU9250_Bench_End(bench, "MPU9250_Units_AccValue, per value", REPEAT * COUNT);
+
+    bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        float scale = (float) (G * 8.0f / pow(2, 15));
+        for (uint32_t i = 0; i < COUNT; i++) {
+            floating[i] = raw[i] * scale;
+        }
+        mpu9250_bench_sink += (int32_t) floating[r % COUNT];
+    }
+    double float_ns = MPU9250_Bench_End(bench, "float scale, per value", REPEAT * COUNT);
+    printf("  float / fixed point %.2fx\n", float_ns / batch_ns);
+
+    bench = MPU9250_Bench_Begin();
+    for (uint32_t r = 0; r < REPEAT; r++) {
+        mpu9250_bench_sink += (int32_t) (1e9 * (G * 8.0f / pow(2, exponent)));
+    }
+    MPU9250_Bench_End(bench, "pow() scale of the full scale change", REPEAT);
+
+    // Error against double precision, in m/s^2
+    double fixed_err = 0;
+    double float_err = 0;
+    for (uint32_t i = 0; i < COUNT; i++) {
+        double exact = raw[i] * 8.0 * G / 32768;
+        fixed_err = fmax(fixed_err, fabs(fixed[i] / 65536.0 - exact));
+        float_err = fmax(float_err, fabs(floating[i] - exact));
+    }
+    printf("  max error: Q16.16 %.2e m/s^2, float %.2e m/s^2\n", fixed_err, float_err);
+    if (fixed_err > 1.0 / 65536) {
+        printf("%s: Q16.16 error above 1 LSB\n", __FILE__);
+        return 1;
+    }
+    return 0;
+}
+/* [] END OF FILE */
@@ -0,0 +1,60 @@
+/** @file CyLib.h
+ * @brief Host replacement of the PSoC Creator system functions.
+ *
+ * This header file is used in place of the one of PSoC Creator when the
+ * library is built on a host for the tests. Delays do not wait: they
+ * advance the simulated time of the fake device (see MPU9250_Fake.h), and
+ * critical sections are empty, since the tests run in a single thread.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_CYLIB_H_
+
+    #define __MPU9250_HOST_CYLIB_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    /**
+    * @brief Advance the simulated time by some milliseconds.
+    */
+    void CyDelay(uint32_t milliseconds);
+
+    /**
+    * @brief Advance the simulated time by some microseconds.
+    */
+    void CyDelayUs(uint16_t microseconds);
+
+    /**
+    * @brief Enter a critical section (nothing to do on the host).
+    */
+    static inline uint8_t CyEnterCriticalSection(void) {
+        return 0;
+    }
+
+    /**
+    * @brief Exit a critical section (nothing to do on the host).
+    */
+    static inline void CyExitCriticalSection(uint8_t savedIntrStatus) {
+        (void) savedIntrStatus;
+    }
+
+    /**
+    * @brief Count the leading zeros of a word (32 for 0, as on the target).
+    */
+    static inline uint8_t __CLZ(uint32_t value) {
+        return (value == 0) ? 32 : (uint8_t) __builtin_clz(value);
+    }
+
+    /**
+    * @brief Swap the bytes of each half word.
+    */
+    #define __REV16(value) ((((value) & 0xFF00FF00UL) >> 8) | (((value) & 0x00FF00FFUL) << 8))
+
+#endif
+/* [] END OF FILE */
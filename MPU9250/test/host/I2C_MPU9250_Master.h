@@ -0,0 +1,85 @@
+/** @file I2C_MPU9250_Master.h
+ * @brief Host replacement of the I2C master component header.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. It declares the API
+ * of the I2C master component used by the library and by the tests, with
+ * the values of the component (v3.50), implemented by the simulated
+ * component of MPU9250_Fake_I2C.c.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_I2C_MPU9250_MASTER_H_
+
+    #define __MPU9250_HOST_I2C_MPU9250_MASTER_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+    #include "CyLib.h"
+
+    /* ========= MACROS ========= */
+
+    // Transfer direction of MasterSendStart and MasterSendRestart
+    #define I2C_MPU9250_Master_WRITE_XFER_MODE        0x00u
+    #define I2C_MPU9250_Master_READ_XFER_MODE         0x01u
+
+    // Acknowledge of MasterReadByte
+    #define I2C_MPU9250_Master_ACK_DATA               0x01u
+    #define I2C_MPU9250_Master_NAK_DATA               0x00u
+
+    // Modes of MasterWriteBuf and MasterReadBuf
+    #define I2C_MPU9250_Master_MODE_COMPLETE_XFER     0x00u
+    #define I2C_MPU9250_Master_MODE_REPEAT_START      0x01u
+    #define I2C_MPU9250_Master_MODE_NO_STOP           0x02u
+
+    // Bits of MasterStatus
+    #define I2C_MPU9250_Master_MSTAT_RD_CMPLT         0x01u
+    #define I2C_MPU9250_Master_MSTAT_WR_CMPLT         0x02u
+    #define I2C_MPU9250_Master_MSTAT_XFER_INP         0x04u
+    #define I2C_MPU9250_Master_MSTAT_XFER_HALT        0x08u
+    #define I2C_MPU9250_Master_MSTAT_ERR_SHORT_XFER   0x10u
+    #define I2C_MPU9250_Master_MSTAT_ERR_ADDR_NAK     0x20u
+    #define I2C_MPU9250_Master_MSTAT_ERR_ARB_LOST     0x40u
+    #define I2C_MPU9250_Master_MSTAT_ERR_XFER         0x80u
+
+    // Return values of the master functions
+    #define I2C_MPU9250_Master_MSTR_NO_ERROR          0x00u
+    #define I2C_MPU9250_Master_MSTR_BUS_BUSY          0x01u
+    #define I2C_MPU9250_Master_MSTR_NOT_READY         0x02u
+    #define I2C_MPU9250_Master_MSTR_ERR_LB_NAK        0x03u
+    #define I2C_MPU9250_Master_MSTR_ERR_ARB_LOST      0x04u
+
+    /* ========= VARIABLES ========= */
+
+    /**
+    * @brief Set once the component has been started.
+    */
+    extern uint8 I2C_MPU9250_Master_initVar;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    void I2C_MPU9250_Master_Start(void);
+    void I2C_MPU9250_Master_Stop(void);
+
+    uint8 I2C_MPU9250_Master_MasterStatus(void);
+    uint8 I2C_MPU9250_Master_MasterClearStatus(void);
+
+    uint8 I2C_MPU9250_Master_MasterWriteBuf(uint8 slaveAddress, uint8* wrData, uint8 cnt, uint8 mode);
+    uint8 I2C_MPU9250_Master_MasterReadBuf(uint8 slaveAddress, uint8* rdData, uint8 cnt, uint8 mode);
+
+    uint8 I2C_MPU9250_Master_MasterSendStart(uint8 slaveAddress, uint8 R_nW);
+    uint8 I2C_MPU9250_Master_MasterSendRestart(uint8 slaveAddress, uint8 R_nW);
+    uint8 I2C_MPU9250_Master_MasterSendStop(void);
+    uint8 I2C_MPU9250_Master_MasterWriteByte(uint8 theByte);
+    uint8 I2C_MPU9250_Master_MasterReadByte(uint8 acknNak);
+
+    /**
+    * @brief Exit callback of the component interrupt (see cyapicallbacks.h).
+    */
+    void I2C_MPU9250_Master_ISR_ExitCallback(void);
+
+#endif
+/* [] END OF FILE */
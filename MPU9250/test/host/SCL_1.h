@@ -0,0 +1,39 @@
+/** @file SCL_1.h
+ * @brief Host replacement of the SCL_1 pin component header.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. The pin is simulated
+ * by MPU9250_Fake_I2C.c, with the bypass register that gives it to the
+ * I2C master component (bit set) or to the firmware (bit cleared).
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_SCL_1_H_
+
+    #define __MPU9250_HOST_SCL_1_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= MACROS ========= */
+
+    // Bit of the pin in its port registers
+    #define SCL_1_MASK 0x01u
+
+    /* ========= VARIABLES ========= */
+
+    /**
+    * @brief Bypass register of the port.
+    */
+    extern uint8 SCL_1_BYP;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    void SCL_1_Write(uint8 value);
+    uint8 SCL_1_Read(void);
+
+#endif
+/* [] END OF FILE */
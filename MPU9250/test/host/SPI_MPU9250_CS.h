@@ -0,0 +1,26 @@
+/** @file SPI_MPU9250_CS.h
+ * @brief Host replacement of the SPI_MPU9250_CS pin component header.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. The chip select line
+ * is simulated by MPU9250_Fake_SPI.c.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_SPI_MPU9250_CS_H_
+
+    #define __MPU9250_HOST_SPI_MPU9250_CS_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    void SPI_MPU9250_CS_Write(uint8 value);
+    uint8 SPI_MPU9250_CS_Read(void);
+
+#endif
+/* [] END OF FILE */
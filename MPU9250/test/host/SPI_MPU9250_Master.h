@@ -0,0 +1,37 @@
+/** @file SPI_MPU9250_Master.h
+ * @brief Host replacement of the SPI master component header.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. It declares the API
+ * of the SPI master component used by the library, implemented by the
+ * simulated component of MPU9250_Fake_SPI.c.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_SPI_MPU9250_MASTER_H_
+
+    #define __MPU9250_HOST_SPI_MPU9250_MASTER_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= VARIABLES ========= */
+
+    /**
+    * @brief Set once the component has been started.
+    */
+    extern uint8 SPI_MPU9250_Master_initVar;
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    void SPI_MPU9250_Master_Start(void);
+    void SPI_MPU9250_Master_ClearFIFO(void);
+    void SPI_MPU9250_Master_WriteTxData(uint8 txData);
+    uint8 SPI_MPU9250_Master_GetRxBufferSize(void);
+    uint8 SPI_MPU9250_Master_ReadRxData(void);
+
+#endif
+/* [] END OF FILE */
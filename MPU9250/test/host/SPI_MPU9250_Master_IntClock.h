@@ -0,0 +1,25 @@
+/** @file SPI_MPU9250_Master_IntClock.h
+ * @brief Host replacement of the SPI master clock component header.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. The divider of the
+ * clock sets the byte time of the simulated component of MPU9250_Fake_SPI.c.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_SPI_MPU9250_MASTER_INTCLOCK_H_
+
+    #define __MPU9250_HOST_SPI_MPU9250_MASTER_INTCLOCK_H_
+
+    // Include required libraries
+
+    #include "cytypes.h"
+
+    /* ========= FUNCTIONS DECLARATIONS ========= */
+
+    void SPI_MPU9250_Master_IntClock_SetDividerValue(uint16 clkDivider);
+
+#endif
+/* [] END OF FILE */
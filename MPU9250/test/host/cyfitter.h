@@ -0,0 +1,22 @@
+/** @file cyfitter.h
+ * @brief Host replacement of the clock and placement definitions.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. Only the bus clock,
+ * that the SPI clock is derived from, is defined.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_CYFITTER_H_
+
+    #define __MPU9250_HOST_CYFITTER_H_
+
+    /* ========= MACROS ========= */
+
+    // Bus clock of the project, in Hz
+    #define BCLK__BUS_CLK__HZ 24000000u
+
+#endif
+/* [] END OF FILE */
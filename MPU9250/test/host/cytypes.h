@@ -0,0 +1,29 @@
+/** @file cytypes.h
+ * @brief Host replacement of the PSoC Creator type definitions.
+ *
+ * This header file is used in place of the one generated by PSoC Creator
+ * when the library is built on a host for the tests. It only provides
+ * what the host-buildable sources of the library use.
+ *
+ * @author Davide Marzorati
+ * @date 16 October, 2026
+*/
+
+#ifndef __MPU9250_HOST_CYTYPES_H_
+
+    #define __MPU9250_HOST_CYTYPES_H_
+
+    // Include required libraries
+
+    #include <stddef.h>
+    #include <stdint.h>
+
+    typedef uint8_t  uint8;
+    typedef uint16_t uint16;
+    typedef uint32_t uint32;
+    typedef int8_t   int8;
+    typedef int16_t  int16;
+    typedef int32_t  int32;
+
+#endif
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/*
+ * @brief Host tests of the double-buffered acquisition.
+ *
+ * Frames are moved into the halves by the interrupt of the simulated
+ * I2C master component, as the component would do on the device, and
+ * the halves are handed over and given back as the application would.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_Acq.h"
+#include "MPU9250_I2C.h"
+#include "MPU9250_I2C_Async.h"
+#include "MPU9250_RegMap.h"
+
+/* ========= MACROS ========= */
+#define FRAMES 4         // Frames of each half
+#define PERIOD_US 1000   // Data ready period
+
+/* ========= VARIABLES ========= */
+static uint8_t buffer[2 * FRAMES * MPU9250_ACQ_FRAME_SIZE];  // Both halves
+static uint8_t* halves[4];                                  // Halves handed over
+static uint8_t statuses[4];                                 // Their status
+static uint8_t handovers = 0;                               // Halves handed over
+
+/* ========= STATIC FUNCTIONS ========= */
+static void Full(uint8_t* half, uint16_t frames, uint8_t status, void* context) {
+    (void) context;
+    MPU9250_TEST_CHECK(frames == FRAMES);
+    if (handovers < 4) {
+        halves[handovers] = half;
+        statuses[handovers] = status;
+    }
+    handovers++;
+}
+
+static void Init(void) {
+    MPU9250_Fake_PowerOn();
+    MPU9250_I2C_Start();
+    handovers = 0;
+    MPU9250_TEST_CHECK(MPU9250_Acq_Start(buffer, FRAMES, Full, NULL) == MPU9250_OK);
+}
+
+static void Wait(void) {
+    // Let the component interrupts run until the next data ready
+    for (uint16_t i = 0; i < PERIOD_US; i++) {
+        MPU9250_Fake_Advance(1);
+    }
+}
+
+static uint8_t Sample(uint8_t value) {
+    // New sample in the sensor registers, then the data ready interrupt
+    MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS)[MPU9250_ACQ_FIRST_REG] = value;
+    uint8_t err = MPU9250_Acq_Trigger();
+    Wait();
+    return err;
+}
+
+static void TestHandover(void) {
+    Init();
+
+    // Each half is handed over once full, frames in order
+    for (uint8_t i = 0; i < FRAMES; i++) {
+        MPU9250_TEST_CHECK(Sample(i + 1) == MPU9250_OK);
+    }
+    MPU9250_TEST_CHECK(handovers == 1);
+    MPU9250_TEST_CHECK(halves[0] == buffer && statuses[0] == MPU9250_OK);
+    for (uint8_t i = 0; i < FRAMES; i++) {
+        MPU9250_TEST_CHECK(buffer[i * MPU9250_ACQ_FRAME_SIZE] == i + 1);
+    }
+
+    // Frames go to the other half meanwhile
+    for (uint8_t i = 0; i < FRAMES; i++) {
+        MPU9250_TEST_CHECK(Sample(0x10 + i) == MPU9250_OK);
+    }
+    MPU9250_TEST_CHECK(handovers == 2);
+    MPU9250_TEST_CHECK(halves[1] == buffer + FRAMES * MPU9250_ACQ_FRAME_SIZE && statuses[1] == MPU9250_OK);
+    MPU9250_TEST_CHECK(handovers == 2 && halves[1][(FRAMES - 1) * MPU9250_ACQ_FRAME_SIZE] == 0x10 + FRAMES - 1);
+    MPU9250_TEST_CHECK(MPU9250_Acq_GetOverruns() == 0 && MPU9250_Acq_GetErrors() == 0);
+    MPU9250_Acq_Stop();
+}
+
+static void TestOverrun(void) {
+    Init();
+    for (uint8_t i = 0; i < 2 * FRAMES; i++) {
+        Sample(i);
+    }
+    MPU9250_TEST_CHECK(handovers == 2);
+
+    // Both halves still owned by the application: frames are dropped,
+    // and the halves are left untouched
+    uint8_t first = buffer[0];
+    MPU9250_TEST_CHECK(Sample(0xAA) == MPU9250_BUSY_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_GetOverruns() == 1);
+    MPU9250_TEST_CHECK(buffer[0] == first);
+
+    // Only the two halves can be given back
+    MPU9250_TEST_CHECK(MPU9250_Acq_Release(buffer + 1) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_Release(NULL) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(Sample(0xAA) == MPU9250_BUSY_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_Release(halves[0]) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Sample(0xAA) == MPU9250_OK);
+    MPU9250_TEST_CHECK(buffer[0] == 0xAA);
+    MPU9250_Acq_Stop();
+}
+
+static void TestFailedFrame(void) {
+    Init();
+
+    // A failed read is reported with its half
+    MPU9250_Fake_Fail(2, 1, MPU9250_FAKE_FAULT_ARB_LOST);
+    for (uint8_t i = 0; i < FRAMES; i++) {
+        Sample(i + 1);
+    }
+    MPU9250_TEST_CHECK(handovers == 1 && statuses[0] == MPU9250_I2C_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_GetErrors() == 1);
+
+    // A frame that cannot be queued is dropped, and reported with its half
+    uint8_t value;
+    for (uint8_t i = 0; i < MPU9250_I2C_ASYNC_QUEUE_SIZE; i++) {
+        MPU9250_TEST_CHECK(MPU9250_I2C_Async_Submit(&(MPU9250_I2C_Request) {MPU9250_I2C_ADDRESS,
+            MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, 1, &value, NULL, NULL}) == MPU9250_OK);
+    }
+    MPU9250_TEST_CHECK(MPU9250_Acq_Trigger() == MPU9250_BUSY_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_GetOverruns() == 1);
+    Wait();
+    for (uint8_t i = 1; i < FRAMES; i++) {
+        Sample(i + 1);
+    }
+    MPU9250_TEST_CHECK(handovers == 2 && statuses[1] == MPU9250_BUSY_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Acq_GetErrors() == 2);
+
+    // The next halves are clean again
+    MPU9250_TEST_CHECK(MPU9250_Acq_Release(halves[0]) == MPU9250_OK);
+    for (uint8_t i = 0; i < FRAMES; i++) {
+        Sample(i + 1);
+    }
+    MPU9250_TEST_CHECK(handovers == 3 && statuses[2] == MPU9250_OK);
+    MPU9250_Acq_Stop();
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestHandover();
+    TestOverrun();
+    TestFailedFrame();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
@@ -0,0 +1,179 @@
+/*
+ * @brief Host tests of the AHRS.
+ *
+ * The filter selected by MPU9250_AHRS_ENGINE (test_ahrs_mahony is built
+ * with the Mahony filter) runs on synthetic motions: convergence from
+ * the identity to a tilted and turned body at rest, tracking of a moving
+ * body, a gyroscope bias, and agreement with the double precision filter
+ * of the reference sample by sample.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Motion.h"
+#include "MPU9250.h"
+#include "MPU9250_Ahrs.h"
+
+/* ========= MACROS ========= */
+#define PERIOD_US 5000  // Sample period
+#define RATE_HZ (1000000 / PERIOD_US)
+#define MAX_DIFF 0.2    // Largest angle accepted from the reference, in degrees
+
+/* ========= TYPE DEFS ========= */
+
+// Largest errors of a run
+typedef struct {
+    double diff;   // Angle from the reference (tilt for the IMU update), over the whole run
+    double error;  // Error from the truth (tilt for the IMU update), over the settled part
+} Run_Errors;
+
+/* ========= STATIC FUNCTIONS ========= */
+static Run_Errors Run(MPU9250_Motion* motion, MPU9250_Ahrs* ahrs, uint32_t seconds, uint32_t settle, int marg) {
+    MPU9250_Reference ref;
+    Run_Errors errors = {0, 0};
+    int16_t acc[3], gyro[3], mag[3];
+    double q[4];
+
+    MPU9250_Reference_Init(&ref, PERIOD_US * 1e-6);
+    for (uint32_t i = 0; i < seconds * RATE_HZ; i++) {
+        MPU9250_Motion_Step(motion, PERIOD_US * 1e-6, acc, gyro, mag);
+        MPU9250_Ahrs_Update(ahrs, acc, gyro, marg ? mag : NULL);
+        MPU9250_Reference_Update(&ref, acc, gyro, marg ? mag : NULL);
+        MPU9250_Motion_FromQ30(ahrs->q, q);
+        // Without the magnetometer the heading is not observed: the two drift apart
+        double diff = marg ? MPU9250_Motion_Angle(q, ref.q) : MPU9250_Motion_Tilt(q, ref.q);
+        errors.diff = fmax(errors.diff, diff);
+        if (i >= settle * RATE_HZ) {
+            double error = marg ? MPU9250_Motion_Angle(q, motion->q) : MPU9250_Motion_Tilt(q, motion->q);
+            errors.error = fmax(errors.error, error);
+        }
+    }
+    return errors;
+}
+
+static void TestInit(void) {
+    MPU9250_Ahrs ahrs;
+
+    MPU9250_TEST_CHECK(MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, 0) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_2000,
+        MPU9250_AHRS_MAX_PERIOD_US / 8 + 1) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, MPU9250_AHRS_MAX_PERIOD_US) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US) == MPU9250_OK);
+    MPU9250_TEST_CHECK(ahrs.q[0] == MPU9250_AHRS_ONE && ahrs.q[1] == 0 && ahrs.q[2] == 0 && ahrs.q[3] == 0);
+}
+
+static void TestConvergence(void) {
+    MPU9250_Motion motion;
+    MPU9250_Ahrs ahrs;
+    Run_Errors errors;
+
+    // From the identity to a body at rest, tilted and turned. The integral
+    // term of the Mahony filter winds up on the initial error, and takes
+    // about two minutes to unwind
+    for (int marg = 0; marg <= 1; marg++) {
+        MPU9250_Motion_Init(&motion, 40, -20, 30);
+        motion.noise[0] = 40;
+        motion.noise[1] = 4;
+        motion.noise[2] = 3;
+        MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US);
+        errors = Run(&motion, &ahrs, 150, 120, marg);
+        MPU9250_TEST_CHECK(errors.error < 1);
+        MPU9250_TEST_CHECK(errors.diff < MAX_DIFF);
+    }
+}
+
+static void TestRotation(void) {
+    MPU9250_Motion motion;
+    MPU9250_Ahrs ahrs;
+    Run_Errors errors;
+
+    // Moving body, from the true orientation
+    for (int marg = 0; marg <= 1; marg++) {
+        MPU9250_Motion_Init(&motion, 0, 0, 0);
+        motion.spin = 1;
+        motion.noise[0] = 40;
+        motion.noise[1] = 4;
+        motion.noise[2] = 3;
+        MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US);
+        errors = Run(&motion, &ahrs, 60, 0, marg);
+        MPU9250_TEST_CHECK(errors.error < 1.5);
+        MPU9250_TEST_CHECK(errors.diff < MAX_DIFF);
+    }
+}
+
+static void TestBias(void) {
+    MPU9250_Motion motion;
+    MPU9250_Ahrs ahrs;
+    Run_Errors errors;
+
+    // Body at rest, tilted and turned, with a gyroscope bias on each axis
+    MPU9250_Motion_Init(&motion, 40, -20, 30);
+    motion.bias[0] = 30;
+    motion.bias[1] = -30;
+    motion.bias[2] = 30;
+    MPU9250_Ahrs_Init(&ahrs, MPU9250_Gyro_FS_250, PERIOD_US);
+    errors = Run(&motion, &ahrs, 300, 240, 1);
+    MPU9250_TEST_CHECK(errors.diff < MAX_DIFF);
+#if MPU9250_AHRS_ENGINE == MPU9250_AHRS_MAHONY
+    // Estimated and removed
+    MPU9250_TEST_CHECK(errors.error < 0.2);
+    MPU9250_TEST_CHECK(fabs(ahrs.bias[0] / 65536.0 + 30) < 2);
+    MPU9250_TEST_CHECK(fabs(ahrs.bias[1] / 65536.0 - 30) < 2);
+    MPU9250_TEST_CHECK(fabs(ahrs.bias[2] / 65536.0 + 30) < 2);
+
+    // Reset with the orientation
+    MPU9250_Ahrs_Reset(&ahrs);
+    MPU9250_TEST_CHECK(ahrs.bias[0] == 0 && ahrs.bias[1] == 0 && ahrs.bias[2] == 0);
+#else
+    // Balanced by the gradient step
+    MPU9250_TEST_CHECK(errors.error < 1);
+    MPU9250_Ahrs_Reset(&ahrs);
+#endif
+    MPU9250_TEST_CHECK(ahrs.q[0] == MPU9250_AHRS_ONE && ahrs.q[1] == 0 && ahrs.q[2] == 0 && ahrs.q[3] == 0);
+}
+
+static void TestUpdateFifo(void) {
+    MPU9250_Motion motion;
+    MPU9250_Ahrs single, batch;
+    int16_t acc[3][32], gyro[3][32], mag[3];
+    const MPU9250_Fifo_Samples samples = {
+        {acc[0], acc[1], acc[2]}, NULL, {gyro[0], gyro[1], gyro[2]}, NULL
+    };
+
+    // A batch of frames, with the same magnetometer values, updates the
+    // orientation as the frames one by one
+    MPU9250_Motion_Init(&motion, 0, 0, 0);
+    motion.spin = 1;
+    for (uint8_t f = 0; f < 32; f++) {
+        int16_t a[3], g[3];
+        MPU9250_Motion_Step(&motion, PERIOD_US * 1e-6, a, g, mag);
+        for (uint8_t i = 0; i < 3; i++) {
+            acc[i][f] = a[i];
+            gyro[i][f] = g[i];
+        }
+    }
+    MPU9250_Ahrs_Init(&single, MPU9250_Gyro_FS_250, PERIOD_US);
+    MPU9250_Ahrs_Init(&batch, MPU9250_Gyro_FS_250, PERIOD_US);
+    for (uint8_t f = 0; f < 32; f++) {
+        int16_t a[3] = {acc[0][f], acc[1][f], acc[2][f]};
+        int16_t g[3] = {gyro[0][f], gyro[1][f], gyro[2][f]};
+        MPU9250_Ahrs_Update(&single, a, g, mag);
+    }
+    MPU9250_Ahrs_UpdateFifo(&batch, &samples, 32, mag);
+    MPU9250_TEST_CHECK(single.q[0] == batch.q[0] && single.q[1] == batch.q[1] &&
+                       single.q[2] == batch.q[2] && single.q[3] == batch.q[3]);
+    MPU9250_TEST_CHECK(single.q[0] != MPU9250_AHRS_ONE);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestInit();
+    TestConvergence();
+    TestRotation();
+    TestBias();
+    TestUpdateFifo();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
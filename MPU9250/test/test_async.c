@@ -0,0 +1,167 @@
+/*
+ * @brief Host tests of the non-blocking I2C communication.
+ *
+ * Order, bus occupation and deadline of the queued requests, on the
+ * simulated I2C master component.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_I2C.h"
+#include "MPU9250_I2C_Async.h"
+#include "MPU9250_RegMap.h"
+
+/* ========= MACROS ========= */
+#define REQUESTS 4  // Requests queued by the tests
+
+/* ========= VARIABLES ========= */
+static uint8_t order[MPU9250_I2C_ASYNC_QUEUE_SIZE];   // Requests, in order of completion
+static uint8_t status[MPU9250_I2C_ASYNC_QUEUE_SIZE];  // Status of each request
+static uint8_t completed = 0;                         // Requests completed
+
+/* ========= STATIC FUNCTIONS ========= */
+static void Done(uint8_t err, void* context) {
+    uint8_t index = (uint8_t) (uintptr_t) context;
+    status[index] = err;
+    order[completed++] = index;
+}
+
+static MPU9250_Fake_Counters Counters(void) {
+    MPU9250_Fake_Counters counters;
+    MPU9250_Fake_GetCounters(&counters);
+    return counters;
+}
+
+static void Init(void) {
+    MPU9250_Fake_PowerOn();
+    MPU9250_I2C_Start();
+    completed = 0;
+}
+
+static uint8_t Submit(uint8_t index, uint8_t reg, uint8_t direction, uint8_t* data, uint8_t count) {
+    MPU9250_I2C_Request request = {MPU9250_I2C_ADDRESS, reg, direction, count, data, Done,
+        (void*) (uintptr_t) index};
+    return MPU9250_I2C_Async_Submit(&request);
+}
+
+static void RunUntilIdle(uint16_t tick_us) {
+    // Let the time run as the main loop would, counting it for the deadlines
+    for (uint32_t i = 0; (i < 100000) && !MPU9250_I2C_Async_IsIdle(); i++) {
+        MPU9250_Fake_Advance(tick_us);
+        MPU9250_I2C_Async_Tick(tick_us);
+    }
+}
+
+static void TestOrder(void) {
+    uint8_t data[REQUESTS][2];
+    uint8_t value = 0x5A;
+
+    Init();
+    uint8_t* regs = MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS);
+    for (uint8_t i = 0; i < 8; i++) {
+        regs[MPU9250_ACCEL_XOUT_H_REG + i] = i;
+    }
+
+    // Reads and a write, completed in the order they were submitted
+    MPU9250_TEST_CHECK(Submit(0, MPU9250_ACCEL_XOUT_H_REG, MPU9250_I2C_ASYNC_READ, data[0], 2) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Submit(1, MPU9250_SMPLRT_DIV_REG, MPU9250_I2C_ASYNC_WRITE, &value, 1) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Submit(2, MPU9250_ACCEL_XOUT_H_REG + 4, MPU9250_I2C_ASYNC_READ, data[2], 2) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Submit(3, MPU9250_SMPLRT_DIV_REG, MPU9250_I2C_ASYNC_READ, data[3], 1) == MPU9250_OK);
+    RunUntilIdle(1);
+
+    MPU9250_TEST_CHECK(completed == REQUESTS);
+    for (uint8_t i = 0; i < REQUESTS; i++) {
+        MPU9250_TEST_CHECK(order[i] == i && status[i] == MPU9250_OK);
+    }
+    MPU9250_TEST_CHECK(data[0][0] == 0 && data[0][1] == 1);
+    MPU9250_TEST_CHECK(data[2][0] == 4 && data[2][1] == 5);
+    MPU9250_TEST_CHECK(data[3][0] == 0x5A);
+}
+
+static void TestBackToBack(void) {
+    uint8_t data[REQUESTS][14];
+
+    Init();
+
+    // Submitting does not wait for the bus
+    MPU9250_Fake_Counters before = Counters();
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    for (uint8_t i = 0; i < REQUESTS; i++) {
+        MPU9250_TEST_CHECK(Submit(i, MPU9250_ACCEL_XOUT_H_REG, MPU9250_I2C_ASYNC_READ, data[i], 14) == MPU9250_OK);
+    }
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetTimeUs() == time_us);
+    MPU9250_TEST_CHECK(MPU9250_I2C_Async_GetPending() == REQUESTS);
+
+    // Each transfer is started by the interrupt of the previous one: the
+    // bus is busy all along, but for the 1 us granularity of the test
+    RunUntilIdle(1);
+    MPU9250_TEST_CHECK(completed == REQUESTS);
+    uint32_t bus_ns = 0;
+    for (uint32_t i = before.transactions; i < Counters().transactions; i++) {
+        bus_ns += MPU9250_Fake_GetTransaction(i)->ns;
+    }
+    MPU9250_TEST_CHECK(Counters().transactions == before.transactions + REQUESTS);
+    MPU9250_TEST_CHECK((MPU9250_Fake_GetTimeUs() - time_us) * 1000 <= bus_ns + 2 * REQUESTS * 1000);
+}
+
+static void TestDeadline(void) {
+    uint8_t data[2];
+    uint8_t value;
+
+    Init();
+
+    // Slave holding SDA: the request times out and the bus is recovered,
+    // the next request is carried out
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_HANG);
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    MPU9250_TEST_CHECK(Submit(0, MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, &data[0], 1) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Submit(1, MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, &data[1], 1) == MPU9250_OK);
+    RunUntilIdle(100);
+    MPU9250_TEST_CHECK(completed == 2);
+    MPU9250_TEST_CHECK(status[0] == MPU9250_TIMEOUT_ERR);
+    MPU9250_TEST_CHECK(status[1] == MPU9250_OK && data[1] == MPU9250_WHO_AM_I);
+    MPU9250_TEST_CHECK(Counters().recoveries == 1);
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetTimeUs() - time_us <= MPU9250_I2C_TIMEOUT_US + 1000);
+
+    // A blocking transfer behind a hung request counts its deadline while
+    // waiting for the bus, instead of waiting forever
+    completed = 0;
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_HANG);
+    MPU9250_TEST_CHECK(Submit(0, MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, &data[0], 1) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == MPU9250_WHO_AM_I);
+    MPU9250_TEST_CHECK(completed == 1 && status[0] == MPU9250_TIMEOUT_ERR);
+    MPU9250_TEST_CHECK(Counters().recoveries == 2);
+}
+
+static void TestReadRefused(void) {
+    uint8_t data[2];
+
+    Init();
+
+    // Read refused after the register address: the bus gets its STOP,
+    // and the next request is carried out
+    MPU9250_Fake_Counters before = Counters();
+    MPU9250_Fake_Fail(1, 1, MPU9250_FAKE_FAULT_REFUSE);
+    MPU9250_TEST_CHECK(Submit(0, MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, &data[0], 1) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Submit(1, MPU9250_WHO_AM_I_REG, MPU9250_I2C_ASYNC_READ, &data[1], 1) == MPU9250_OK);
+    RunUntilIdle(1);
+    MPU9250_TEST_CHECK(completed == 2);
+    MPU9250_TEST_CHECK(status[0] == MPU9250_I2C_ERR);
+    MPU9250_TEST_CHECK(status[1] == MPU9250_OK && data[1] == MPU9250_WHO_AM_I);
+    MPU9250_TEST_CHECK(Counters().stops == before.stops + 2);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestOrder();
+    TestBackToBack();
+    TestDeadline();
+    TestReadRefused();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
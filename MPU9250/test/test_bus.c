@@ -0,0 +1,149 @@
+/*
+ * @brief Host tests of the register access backends.
+ *
+ * The same sequence is run through the I2C and the SPI backend, on the
+ * simulated components, and must give the same results and leave the
+ * device in the same state. The SPI transaction deadline is also checked.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_Bus.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Fifo.h"
+#include "MPU9250_SPI.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define FRAME_SIZE 12  // Accelerometer and gyroscope
+#define FRAMES 30      // Frames drained from the FIFO
+
+/* ========= TYPE DEFS ========= */
+typedef struct {
+    uint8_t start;                    // Status of MPU9250_Start
+    uint8_t read;                     // Status of the sensor read
+    int16_t acc[3];                   // Accelerometer
+    int16_t temp;                     // Temperature
+    int16_t gyro[3];                  // Gyroscope
+    uint32_t read_us;                 // Time of the sensor read
+    uint8_t config;                   // Status of the configuration
+    uint8_t drain;                    // Status of the FIFO drain
+    uint16_t frames;                  // Frames drained
+    uint8_t fifo[FRAMES * FRAME_SIZE];  // Bytes drained
+    uint8_t regs[128];                // Registers of the MPU9250 at the end
+} Result;
+
+/* ========= VARIABLES ========= */
+// ACCEL_XOUT_H to GYRO_ZOUT_L, big-endian
+static const uint8_t imu[14] = {
+    0x01, 0x02, 0xFF, 0xFE, 0x40, 0x00,
+    0x0B, 0xB8,
+    0x80, 0x00, 0x00, 0x10, 0x7F, 0xFF
+};
+
+/* ========= STATIC FUNCTIONS ========= */
+static void Run(const MPU9250_Bus* backend, Result* result) {
+    uint8_t frame[FRAME_SIZE];
+
+    memset(result, 0, sizeof(*result));
+    MPU9250_Fake_PowerOn();
+    MPU9250_Bus_SetBackend(backend);
+    result->start = MPU9250_Start();
+
+    // Sensor registers
+    memcpy(&MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS)[MPU9250_ACCEL_XOUT_H_REG], imu, sizeof(imu));
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    result->read = MPU9250_ReadAccTempGyro(result->acc, &result->temp, result->gyro);
+    result->read_us = MPU9250_Fake_GetTimeUs() - time_us;
+
+    // Configuration
+    MPU9250_Config config;
+    MPU9250_GetDefaultConfig(&config);
+    config.acc_fs = MPU9250_Acc_FS_8g;
+    config.gyro_fs = MPU9250_Gyro_FS_1000;
+    config.sample_rate_divider = 9;
+    result->config = MPU9250_ApplyConfig(&config, NULL);
+
+    // FIFO, drained with bursts longer than the FIFOs of the components
+    result->config |= MPU9250_Fifo_Enable(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO);
+    for (uint16_t f = 0; f < FRAMES; f++) {
+        for (uint8_t i = 0; i < FRAME_SIZE; i++) {
+            frame[i] = (uint8_t) (f * FRAME_SIZE + i);
+        }
+        MPU9250_Fake_PushFifo(frame, FRAME_SIZE);
+    }
+    result->drain = MPU9250_Fifo_Drain(result->fifo, FRAMES, &result->frames);
+
+    memcpy(result->regs, MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS), sizeof(result->regs));
+}
+
+static void TestCrossBackend(void) {
+    static Result i2c;
+    static Result spi;
+
+    Run(&MPU9250_Bus_I2C, &i2c);
+    Run(&MPU9250_Bus_SPI, &spi);
+
+    // Both complete, with the same data
+    MPU9250_TEST_CHECK(i2c.start == MPU9250_OK && spi.start == MPU9250_OK);
+    MPU9250_TEST_CHECK(i2c.read == MPU9250_OK && spi.read == MPU9250_OK);
+    MPU9250_TEST_CHECK(i2c.acc[0] == 258 && i2c.temp == 3000 && i2c.gyro[2] == 32767);
+    MPU9250_TEST_CHECK(memcmp(i2c.acc, spi.acc, sizeof(i2c.acc)) == 0);
+    MPU9250_TEST_CHECK(memcmp(i2c.gyro, spi.gyro, sizeof(i2c.gyro)) == 0);
+    MPU9250_TEST_CHECK(i2c.temp == spi.temp);
+    MPU9250_TEST_CHECK(i2c.config == MPU9250_OK && spi.config == MPU9250_OK);
+    MPU9250_TEST_CHECK(i2c.drain == MPU9250_OK && spi.drain == MPU9250_OK);
+    MPU9250_TEST_CHECK(i2c.frames == FRAMES && spi.frames == FRAMES);
+    MPU9250_TEST_CHECK(i2c.fifo[FRAMES * FRAME_SIZE - 1] == (uint8_t) (FRAMES * FRAME_SIZE - 1));
+    MPU9250_TEST_CHECK(memcmp(i2c.fifo, spi.fifo, sizeof(i2c.fifo)) == 0);
+
+    // Same registers, but for the bit that disables the I2C interface
+    MPU9250_TEST_CHECK((spi.regs[MPU9250_USER_CTRL_REG] ^ i2c.regs[MPU9250_USER_CTRL_REG]) == MPU9250_SPI_I2C_IF_DIS);
+    spi.regs[MPU9250_USER_CTRL_REG] = i2c.regs[MPU9250_USER_CTRL_REG];
+    MPU9250_TEST_CHECK(memcmp(i2c.regs, spi.regs, sizeof(i2c.regs)) == 0);
+
+    // Sensor registers are read at the fast SPI clock
+    MPU9250_TEST_CHECK(spi.read_us < i2c.read_us);
+}
+
+static void TestSpiTimeout(void) {
+    uint8_t data[4];
+    MPU9250_Fake_SPI_Counters before;
+    MPU9250_Fake_SPI_Counters after;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_Bus_SetBackend(&MPU9250_Bus_SPI);
+    MPU9250_Bus_Start();
+
+    // Clock stopped: the transaction is aborted and the chip select released
+    MPU9250_Fake_SPI_Stall(1);
+    MPU9250_Fake_SPI_GetCounters(&before);
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    MPU9250_TEST_CHECK(MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, data, 4) == MPU9250_TIMEOUT_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetTimeUs() - time_us <= MPU9250_SPI_TIMEOUT_US + 10);
+    MPU9250_Fake_SPI_GetCounters(&after);
+    MPU9250_TEST_CHECK(after.transactions == before.transactions + 1);
+    MPU9250_TEST_CHECK(after.bytes == before.bytes);
+
+    // Clock back: the byte left in the shift register goes out with the
+    // chip select high, the next transaction starts afresh
+    MPU9250_Fake_SPI_Stall(0);
+    MPU9250_Fake_Advance(10);
+    MPU9250_TEST_CHECK(MPU9250_Bus_ReadBurst(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, data, 1) == MPU9250_OK);
+    MPU9250_TEST_CHECK(data[0] == MPU9250_WHO_AM_I);
+
+    // The AK8963 is not on the SPI bus
+    MPU9250_TEST_CHECK(MPU9250_Bus_ReadBurst(AK8963_I2C_ADDRESS, 0x00, data, 1) == MPU9250_DEV_NOT_FOUND_ERR);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestCrossBackend();
+    TestSpiTimeout();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
@@ -0,0 +1,153 @@
+/*
+ * @brief Host tests of the bus timing cost model.
+ *
+ * The expected times are computed by hand from the timings of the I2C
+ * specification used by MPU9250_Cost.c. The strategies are then checked
+ * against the transactions the library emits on the simulated bus: the
+ * model must price the same segments, and can only be slower than the
+ * bits alone.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_Cost.h"
+#include "MPU9250_Fifo.h"
+#include "MPU9250_RegMap.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+// Fast mode: 9 bits at 400 kHz plus the gap between bytes
+#define BYTE_NS (9 * 2500 + MPU9250_COST_BYTE_GAP_NS)
+
+// Fast mode: START hold, STOP setup and bus free time
+#define FRAME_NS (600 + 600 + 1300)
+
+// Fast mode: repeated START setup and hold time
+#define RESTART_NS (600 + 600)
+
+#define FRAME_SIZE 12  // Accelerometer and gyroscope
+#define BATCH 40       // Frames per FIFO drain
+
+/* ========= VARIABLES ========= */
+static uint32_t first;     // First transaction of the operation
+static uint32_t model_ns;  // Bus time of its transactions, priced by the model
+static uint32_t bits_ns;   // Bus time of its transactions, bits only
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint32_t ReadNs(uint16_t count) {
+    // Address and register bytes, repeated START, address and data bytes
+    return FRAME_NS + 2 * BYTE_NS + RESTART_NS + (1 + count) * BYTE_NS;
+}
+
+static void TestTransfer(void) {
+    uint8_t reg = 0;
+    MPU9250_I2C_Segment write = {MPU9250_I2C_SEGMENT_WRITE, &reg, 1};
+
+    MPU9250_TEST_CHECK(MPU9250_Cost_TransferNs(400000, &write, 1) == FRAME_NS + 2 * BYTE_NS);
+    MPU9250_TEST_CHECK(MPU9250_Cost_ReadMultiNs(400000, 6) == ReadNs(6));
+}
+
+static void TestStrategies(void) {
+    MPU9250_TEST_CHECK(MPU9250_Cost_SampleNs(400000, MPU9250_COST_ACC_THEN_GYRO, 0, 0) == 2 * ReadNs(6));
+    MPU9250_TEST_CHECK(MPU9250_Cost_SampleNs(400000, MPU9250_COST_ACC_GYRO, 0, 0) == ReadNs(14));
+
+    // Interrupt status and FIFO count reads, then a single burst
+    MPU9250_TEST_CHECK(MPU9250_Cost_SampleNs(400000, MPU9250_COST_FIFO, 12, 1) ==
+        ReadNs(1) + ReadNs(2) + ReadNs(12));
+
+    // 21 frames of 12 bytes per burst: 40 frames take two bursts
+    MPU9250_TEST_CHECK(MPU9250_Cost_SampleNs(400000, MPU9250_COST_FIFO, 12, 40) ==
+        (ReadNs(1) + ReadNs(2) + ReadNs(21 * 12) + ReadNs(19 * 12)) / 40);
+
+    // Batching amortizes the fixed costs
+    MPU9250_TEST_CHECK(MPU9250_Cost_MaxOdr(400000, MPU9250_COST_FIFO, 12, 20) >
+        MPU9250_Cost_MaxOdr(400000, MPU9250_COST_ACC_GYRO, 0, 0));
+    MPU9250_TEST_CHECK(MPU9250_Cost_SampleNs(400000, MPU9250_COST_FIFO, 0, 1) == 0);
+}
+
+static void Begin(void) {
+    MPU9250_Fake_Counters counters;
+    MPU9250_Fake_GetCounters(&counters);
+    first = counters.transactions;
+}
+
+static void End(void) {
+    // Price the transactions recorded since Begin
+    MPU9250_Fake_Counters counters;
+    MPU9250_Fake_GetCounters(&counters);
+    model_ns = 0;
+    bits_ns = 0;
+    for (uint32_t i = first; i < counters.transactions; i++) {
+        const MPU9250_Fake_Transaction* t = MPU9250_Fake_GetTransaction(i);
+        model_ns += MPU9250_Cost_TransferNs(400000, t->segments, t->n);
+        bits_ns += t->ns;
+    }
+}
+
+static void TestTraffic(void) {
+    int16_t acc[3];
+    int16_t gyro[3];
+    int16_t mag[3];
+    int16_t temp;
+    uint8_t mag_status;
+    uint8_t data[BATCH * FRAME_SIZE];
+    uint16_t frames;
+    uint16_t count;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+
+    Begin();
+    MPU9250_TEST_CHECK(MPU9250_ReadAcc(acc) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_ReadGyro(gyro) == MPU9250_OK);
+    End();
+    MPU9250_TEST_CHECK(model_ns == MPU9250_Cost_SampleNs(400000, MPU9250_COST_ACC_THEN_GYRO, 0, 0));
+    MPU9250_TEST_CHECK(bits_ns <= model_ns);
+
+    Begin();
+    MPU9250_TEST_CHECK(MPU9250_ReadAccTempGyro(acc, &temp, gyro) == MPU9250_OK);
+    End();
+    MPU9250_TEST_CHECK(model_ns == MPU9250_Cost_SampleNs(400000, MPU9250_COST_ACC_GYRO, 0, 0));
+    MPU9250_TEST_CHECK(bits_ns <= model_ns);
+
+    Begin();
+    MPU9250_TEST_CHECK(MPU9250_ReadAll(acc, &temp, gyro, mag, &mag_status) == MPU9250_OK);
+    End();
+    MPU9250_TEST_CHECK(model_ns == MPU9250_Cost_SampleNs(400000, MPU9250_COST_READ_ALL, 0, 0));
+    MPU9250_TEST_CHECK(bits_ns <= model_ns);
+
+    // Magnetometer sample ready, read through the bypass
+    MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_ST1] = 0x01;
+    Begin();
+    MPU9250_TEST_CHECK(MPU9250_ReadMag(mag) == MPU9250_OK);
+    End();
+    MPU9250_TEST_CHECK(model_ns == MPU9250_Cost_SampleNs(400000, MPU9250_COST_MAG, 0, 0));
+    MPU9250_TEST_CHECK(bits_ns <= model_ns);
+
+    // FIFO drain of a batch, longer than a burst
+    uint8_t frame[FRAME_SIZE];
+    memset(frame, 0x55, sizeof(frame));
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Enable(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO) == MPU9250_OK);
+    for (uint16_t f = 0; f < BATCH; f++) {
+        MPU9250_Fake_PushFifo(frame, FRAME_SIZE);
+    }
+    Begin();
+    MPU9250_TEST_CHECK(MPU9250_Fifo_DrainCount(data, BATCH, &frames, &count) == MPU9250_OK);
+    End();
+    MPU9250_TEST_CHECK(frames == BATCH);
+    MPU9250_TEST_CHECK(model_ns / BATCH == MPU9250_Cost_SampleNs(400000, MPU9250_COST_FIFO, FRAME_SIZE, BATCH));
+    MPU9250_TEST_CHECK(bits_ns <= model_ns);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestTransfer();
+    TestStrategies();
+    TestTraffic();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
@@ -0,0 +1,161 @@
+/*
+ * @brief Host tests of FIFO streaming.
+ *
+ * Frame layout, drains, overflow recovery, drain scheduling and frame
+ * timestamps on the fake device.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Fifo.h"
+#include <string.h>
+
+/* ========= MACROS ========= */
+#define FRAME_SIZE 12  // Accelerometer and gyroscope
+
+/* ========= STATIC FUNCTIONS ========= */
+static void PushFrames(uint16_t frames, uint8_t first) {
+    uint8_t frame[FRAME_SIZE];
+    for (uint16_t f = 0; f < frames; f++) {
+        memset(frame, (uint8_t) (first + f), FRAME_SIZE);
+        MPU9250_Fake_PushFifo(frame, FRAME_SIZE);
+    }
+}
+
+static void TestLayout(void) {
+    uint16_t size;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Enable(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_GetFrameSize(&size) == MPU9250_OK);
+    MPU9250_TEST_CHECK(size == FRAME_SIZE);
+
+    // The magnetometer mirror adds ST1 to ST2 at the end of the frame
+    MPU9250_TEST_CHECK(MPU9250_Fifo_EnableMag(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_GetFrameSize(&size) == MPU9250_OK);
+    MPU9250_TEST_CHECK(size == FRAME_SIZE + MPU9250_FIFO_MAG_SIZE);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_DisableMag() == MPU9250_OK);
+}
+
+static void TestDrain(void) {
+    uint8_t data[8 * FRAME_SIZE];
+    uint16_t frames;
+    uint16_t count;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Enable(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO) == MPU9250_OK);
+
+    // Only whole frames are read, the partial one is left in the FIFO
+    PushFrames(3, 1);
+    MPU9250_Fake_PushFifo(data, FRAME_SIZE / 2);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_DrainCount(data, 8, &frames, &count) == MPU9250_OK);
+    MPU9250_TEST_CHECK(frames == 3);
+    MPU9250_TEST_CHECK(count == 3 * FRAME_SIZE + FRAME_SIZE / 2);
+    MPU9250_TEST_CHECK(data[0] == 1 && data[FRAME_SIZE] == 2 && data[3 * FRAME_SIZE - 1] == 3);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_GetCount(&count) == MPU9250_OK);
+    MPU9250_TEST_CHECK(count == FRAME_SIZE / 2);
+
+    // At most max_frames frames are read
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Reset() == MPU9250_OK);
+    PushFrames(5, 1);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Drain(data, 2, &frames) == MPU9250_OK);
+    MPU9250_TEST_CHECK(frames == 2);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Drain(data, 8, &frames) == MPU9250_OK);
+    MPU9250_TEST_CHECK(frames == 3);
+    MPU9250_TEST_CHECK(data[0] == 3);
+}
+
+static void TestOverflow(void) {
+    uint8_t data[8 * FRAME_SIZE];
+    uint16_t frames;
+    uint16_t count;
+    MPU9250_Fifo_Loss loss;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Enable(MPU9250_FIFO_ACCEL | MPU9250_FIFO_GYRO) == MPU9250_OK);
+    MPU9250_Fifo_ResetLoss();
+
+    // The frames left in the FIFO are discarded, and the FIFO restarts empty
+    PushFrames(50, 0);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Drain(data, 8, &frames) == MPU9250_FIFO_OVERFLOW_ERR);
+    MPU9250_TEST_CHECK(frames == 0);
+    MPU9250_Fifo_GetLoss(&loss);
+    MPU9250_TEST_CHECK(loss.overflows == 1);
+    MPU9250_TEST_CHECK(loss.discarded_frames == (MPU9250_FIFO_SIZE + FRAME_SIZE - 1) / FRAME_SIZE);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_GetCount(&count) == MPU9250_OK);
+    MPU9250_TEST_CHECK(count == 0);
+
+    // Streaming goes on with whole frames
+    PushFrames(2, 7);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_Drain(data, 8, &frames) == MPU9250_OK);
+    MPU9250_TEST_CHECK(frames == 2);
+    MPU9250_TEST_CHECK(data[0] == 7);
+}
+
+static void TestSchedule(void) {
+    MPU9250_Fifo_Sched sched;
+    uint32_t period_q8;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+
+    // Slowest rate: 1 kHz / 256, 256 ms per frame
+    MPU9250_TEST_CHECK(MPU9250_SetSampleRateDivider(255) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fifo_GetFramePeriod(&period_q8) == MPU9250_OK);
+    MPU9250_TEST_CHECK(period_q8 == 256000UL << 8);
+
+    // Accelerometer only: 85 frames fit, the wait does not wrap around
+    MPU9250_Fifo_SchedInit(&sched, 6, period_q8, 255);
+    MPU9250_TEST_CHECK(sched.target == MPU9250_FIFO_SIZE / 6 - MPU9250_FIFO_SCHED_MARGIN);
+    MPU9250_TEST_CHECK(sched.wait_us == sched.target * 256000UL);
+
+    // Half of the frames drained: wait for the missing ones
+    uint32_t wait_us = MPU9250_Fifo_SchedUpdate(&sched, sched.target * 6, sched.target / 2, sched.wait_us);
+    MPU9250_TEST_CHECK(wait_us == (sched.target / 2) * 256000UL);
+}
+
+static void TestClock(void) {
+    MPU9250_Fifo_Clock clock;
+    uint32_t timestamps[40];
+
+    // 1 kHz: the oldest of 10 frames was written 9.5 periods before the drain
+    MPU9250_Fifo_ClockInit(&clock, FRAME_SIZE, 1000UL << 8);
+    MPU9250_Fifo_ClockUpdate(&clock, 100000, 10 * FRAME_SIZE, 10, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 90500 && timestamps[9] == 99500);
+    MPU9250_Fifo_ClockUpdate(&clock, 110000, 10 * FRAME_SIZE, 10, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 100500 && timestamps[9] == 109500);
+
+    // Slowest rate, 1 kHz / 256: 40 frames span more than 8 s, the drains
+    // are more than 8 s apart
+    MPU9250_Fifo_ClockInit(&clock, FRAME_SIZE, 256000UL << 8);
+    MPU9250_Fifo_ClockUpdate(&clock, 50000000, 40 * FRAME_SIZE, 40, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 39888000 && timestamps[39] == 49872000);
+    MPU9250_Fifo_ClockUpdate(&clock, 60240000, 40 * FRAME_SIZE, 40, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 50128000 && timestamps[39] == 60112000);
+    MPU9250_TEST_CHECK(clock.period_q8 == 256000UL << 8);
+
+    // Drain 30 s late, with frames lost: the frames are measured again
+    MPU9250_Fifo_ClockUpdate(&clock, 90240000, 40 * FRAME_SIZE, 40, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 80128000 && timestamps[39] == 90112000);
+    MPU9250_Fifo_ClockUpdate(&clock, 100480000, 40 * FRAME_SIZE, 40, timestamps);
+    MPU9250_TEST_CHECK(timestamps[0] == 90368000);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestLayout();
+    TestDrain();
+    TestOverflow();
+    TestSchedule();
+    TestClock();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
@@ -0,0 +1,170 @@
+/*
+ * @brief Host tests of the I2C communication.
+ *
+ * Conditions, bytes and bus time of the blocking transfers, seen by the
+ * simulated I2C master component, and their behaviour on bus faults.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_I2C.h"
+#include "MPU9250_RegMap.h"
+#include "I2C_MPU9250_Master.h"
+
+/* ========= MACROS ========= */
+#define BIT_NS 2500  // Bit period at 400 kHz
+
+/* ========= STATIC FUNCTIONS ========= */
+static MPU9250_Fake_Counters Counters(void) {
+    MPU9250_Fake_Counters counters;
+    MPU9250_Fake_GetCounters(&counters);
+    return counters;
+}
+
+static const MPU9250_Fake_Transaction* Last(void) {
+    return MPU9250_Fake_GetTransaction(Counters().transactions - 1);
+}
+
+static void Init(void) {
+    MPU9250_Fake_PowerOn();
+    MPU9250_I2C_Start();
+}
+
+static void TestReadMulti(void) {
+    uint8_t data[3];
+
+    Init();
+    uint8_t* regs = MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS);
+    regs[MPU9250_SMPLRT_DIV_REG] = 0x11;
+    regs[MPU9250_SMPLRT_DIV_REG + 1] = 0x22;
+    regs[MPU9250_SMPLRT_DIV_REG + 2] = 0x33;
+
+    // START, register address, repeated START, data, STOP
+    MPU9250_Fake_Counters before = Counters();
+    MPU9250_TEST_CHECK(MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, data, 3) == MPU9250_OK);
+    MPU9250_TEST_CHECK(data[0] == 0x11 && data[1] == 0x22 && data[2] == 0x33);
+    MPU9250_Fake_Counters after = Counters();
+    MPU9250_TEST_CHECK(after.starts == before.starts + 1);
+    MPU9250_TEST_CHECK(after.restarts == before.restarts + 1);
+    MPU9250_TEST_CHECK(after.stops == before.stops + 1);
+    MPU9250_TEST_CHECK(after.addresses == before.addresses + 2);
+    MPU9250_TEST_CHECK(after.bytes_written == before.bytes_written + 1);
+    MPU9250_TEST_CHECK(after.bytes_read == before.bytes_read + 3);
+
+    const MPU9250_Fake_Transaction* t = Last();
+    MPU9250_TEST_CHECK(t != NULL && t->address == MPU9250_I2C_ADDRESS && t->n == 2);
+    MPU9250_TEST_CHECK(t->segments[0].direction == MPU9250_I2C_SEGMENT_WRITE && t->segments[0].count == 1);
+    MPU9250_TEST_CHECK(t->segments[1].direction == MPU9250_I2C_SEGMENT_READ && t->segments[1].count == 3);
+    MPU9250_TEST_CHECK(t->ns == (1 + 9 * 2 + 1 + 9 * 4 + 1) * BIT_NS);
+}
+
+static void TestWriteMulti(void) {
+    uint8_t data[3] = {4, 5, 6};
+
+    Init();
+
+    // A single segment: START, register address and data, STOP
+    MPU9250_Fake_Counters before = Counters();
+    MPU9250_TEST_CHECK(MPU9250_I2C_WriteMulti(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, data, 3) == MPU9250_OK);
+    MPU9250_Fake_Counters after = Counters();
+    MPU9250_TEST_CHECK(after.starts == before.starts + 1);
+    MPU9250_TEST_CHECK(after.restarts == before.restarts);
+    MPU9250_TEST_CHECK(after.stops == before.stops + 1);
+    MPU9250_TEST_CHECK(after.writes == before.writes + 1);
+    MPU9250_TEST_CHECK(after.bytes_written == before.bytes_written + 4);
+
+    const MPU9250_Fake_Transaction* t = Last();
+    MPU9250_TEST_CHECK(t != NULL && t->n == 1 && t->segments[0].count == 4);
+    uint8_t* regs = MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS);
+    MPU9250_TEST_CHECK(regs[MPU9250_SMPLRT_DIV_REG] == 4 && regs[MPU9250_SMPLRT_DIV_REG + 2] == 6);
+
+    // Too many bytes: nothing is sent
+    uint8_t big[MPU9250_I2C_MAX_WRITE + 1] = {0};
+    uint8_t read[256];
+    MPU9250_TEST_CHECK(MPU9250_I2C_WriteMulti(MPU9250_I2C_ADDRESS, 0, big, sizeof(big)) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(MPU9250_I2C_ReadMulti(MPU9250_I2C_ADDRESS, 0, read, 256) == MPU9250_UNKNOWN_ERR);
+    MPU9250_TEST_CHECK(Counters().transactions == after.transactions);
+}
+
+static void TestProbe(void) {
+    Init();
+
+    // Address only, with the write bit
+    MPU9250_TEST_CHECK(MPU9250_I2C_IsDeviceConnected(MPU9250_I2C_ADDRESS) == MPU9250_OK);
+    const MPU9250_Fake_Transaction* t = Last();
+    MPU9250_TEST_CHECK(t != NULL && t->n == 1 && t->segments[0].count == 0);
+    MPU9250_TEST_CHECK(t->ns == (1 + 9 + 1) * BIT_NS);
+
+    // Address not acknowledged: STOP, device not found
+    MPU9250_Fake_Counters before = Counters();
+    MPU9250_TEST_CHECK(MPU9250_I2C_IsDeviceConnected(0x1E) == MPU9250_DEV_NOT_FOUND_ERR);
+    MPU9250_Fake_Counters after = Counters();
+    MPU9250_TEST_CHECK(after.nacks == before.nacks + 1);
+    MPU9250_TEST_CHECK(after.stops == before.stops + 1);
+}
+
+static void TestFaults(void) {
+    uint8_t value;
+
+    Init();
+
+    // Arbitration lost on the address: no STOP
+    MPU9250_Fake_Counters before = Counters();
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_ARB_LOST);
+    MPU9250_TEST_CHECK(MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, &value) == MPU9250_I2C_ERR);
+    MPU9250_TEST_CHECK(Counters().stops == before.stops);
+
+    // Read refused after the register address: the halted bus gets its STOP
+    before = Counters();
+    MPU9250_Fake_Fail(1, 1, MPU9250_FAKE_FAULT_REFUSE);
+    MPU9250_TEST_CHECK(MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, &value) == MPU9250_I2C_ERR);
+    MPU9250_TEST_CHECK(Counters().stops == before.stops + 1);
+    MPU9250_TEST_CHECK(Counters().restarts == before.restarts);
+
+    // Slave holding SDA: timeout, bus recovery, then the bus works again
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_HANG);
+    MPU9250_TEST_CHECK(MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, &value) == MPU9250_TIMEOUT_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetTimeUs() - time_us <= MPU9250_I2C_TIMEOUT_US + 1000);
+    MPU9250_TEST_CHECK(Counters().recoveries == 1);
+    value = 0;
+    MPU9250_TEST_CHECK(MPU9250_I2C_Read(MPU9250_I2C_ADDRESS, MPU9250_WHO_AM_I_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == MPU9250_WHO_AM_I);
+}
+
+static void TestByteApi(void) {
+    Init();
+
+    // Register read with the byte functions of the component
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendStop() == I2C_MPU9250_Master_MSTR_NOT_READY);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendStart(MPU9250_I2C_ADDRESS,
+        I2C_MPU9250_Master_WRITE_XFER_MODE) == I2C_MPU9250_Master_MSTR_NO_ERROR);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterWriteByte(MPU9250_WHO_AM_I_REG) == I2C_MPU9250_Master_MSTR_NO_ERROR);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendRestart(MPU9250_I2C_ADDRESS,
+        I2C_MPU9250_Master_READ_XFER_MODE) == I2C_MPU9250_Master_MSTR_NO_ERROR);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterReadByte(I2C_MPU9250_Master_NAK_DATA) == MPU9250_WHO_AM_I);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendStop() == I2C_MPU9250_Master_MSTR_NO_ERROR);
+
+    const MPU9250_Fake_Transaction* t = Last();
+    MPU9250_TEST_CHECK(t != NULL && t->n == 2 && t->segments[1].count == 1);
+
+    // Missing slave: the address is not acknowledged, the bus is kept
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendStart(0x1E,
+        I2C_MPU9250_Master_WRITE_XFER_MODE) == I2C_MPU9250_Master_MSTR_ERR_LB_NAK);
+    MPU9250_TEST_CHECK(I2C_MPU9250_Master_MasterSendStop() == I2C_MPU9250_Master_MSTR_NO_ERROR);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestReadMulti();
+    TestWriteMulti();
+    TestProbe();
+    TestFaults();
+    TestByteApi();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
@@ -0,0 +1,95 @@
+/*
+ * @brief Host tests of the sensor reads.
+ *
+ * Decoding of the sensor registers and status of the magnetometer sample,
+ * on the fake device.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Bus.h"
+#include <string.h>
+
+/* ========= VARIABLES ========= */
+// ACCEL_XOUT_H to GYRO_ZOUT_L, big-endian
+static const uint8_t imu[14] = {
+    0x01, 0x02, 0xFF, 0xFE, 0x40, 0x00,  // Accelerometer: 258, -2, 16384
+    0x0B, 0xB8,                          // Temperature: 3000
+    0x80, 0x00, 0x00, 0x10, 0x7F, 0xFF   // Gyroscope: -32768, 16, 32767
+};
+
+// EXT_SENS_DATA_00 to EXT_SENS_DATA_07: ST1, HXL to HZH (little-endian), ST2
+static const uint8_t mag[8] = {0x01, 0x64, 0x00, 0x9C, 0xFF, 0x00, 0x01, 0x10};
+
+/* ========= STATIC FUNCTIONS ========= */
+static void SetData(uint8_t st1, uint8_t st2) {
+    uint8_t* regs = MPU9250_Fake_Regs(MPU9250_I2C_ADDRESS);
+    memcpy(&regs[MPU9250_ACCEL_XOUT_H_REG], imu, sizeof(imu));
+    memcpy(&regs[MPU9250_EXT_SENS_DATA_00_REG], mag, sizeof(mag));
+    regs[MPU9250_EXT_SENS_DATA_00_REG] = st1;
+    regs[MPU9250_EXT_SENS_DATA_00_REG + 7] = st2;
+}
+
+static void TestAccGyro(void) {
+    int16_t acc[3];
+    int16_t gyro[3];
+    int16_t temp;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_Bus_Start();
+    SetData(0x01, 0x10);
+    MPU9250_TEST_CHECK(MPU9250_ReadAccTempGyro(acc, &temp, gyro) == MPU9250_OK);
+    MPU9250_TEST_CHECK(acc[0] == 258 && acc[1] == -2 && acc[2] == 16384);
+    MPU9250_TEST_CHECK(temp == 3000);
+    MPU9250_TEST_CHECK(gyro[0] == -32768 && gyro[1] == 16 && gyro[2] == 32767);
+}
+
+static void TestReadAll(void) {
+    int16_t acc[3];
+    int16_t gyro[3];
+    int16_t mag_out[3] = {1, 2, 3};
+    int16_t temp;
+    uint8_t mag_status;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_Bus_Start();
+
+    // New sample: all the sensors are decoded
+    SetData(0x01, 0x10);
+    MPU9250_TEST_CHECK(MPU9250_ReadAll(acc, &temp, gyro, mag_out, &mag_status) == MPU9250_OK);
+    MPU9250_TEST_CHECK(mag_status == MPU9250_OK);
+    MPU9250_TEST_CHECK(acc[2] == 16384 && temp == 3000 && gyro[1] == 16);
+    MPU9250_TEST_CHECK(mag_out[0] == 100 && mag_out[1] == -100 && mag_out[2] == 256);
+
+    // Magnetometer not ready: the other sensors are still valid
+    mag_out[0] = 0;
+    SetData(0x00, 0x10);
+    memset(acc, 0, sizeof(acc));
+    MPU9250_TEST_CHECK(MPU9250_ReadAll(acc, &temp, gyro, mag_out, &mag_status) == MPU9250_OK);
+    MPU9250_TEST_CHECK(mag_status == MPU9250_MAG_NOT_READY_ERR);
+    MPU9250_TEST_CHECK(acc[0] == 258);
+    MPU9250_TEST_CHECK(mag_out[0] == 0);
+
+    // Magnetometer overflow
+    SetData(0x01, 0x18);
+    MPU9250_TEST_CHECK(MPU9250_ReadAll(acc, &temp, gyro, mag_out, &mag_status) == MPU9250_OK);
+    MPU9250_TEST_CHECK(mag_status == MPU9250_MAG_OVERFLOW_ERR);
+    MPU9250_TEST_CHECK(mag_out[0] == 0);
+
+    // Bus errors are still reported as such
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_ARB_LOST);
+    MPU9250_TEST_CHECK(MPU9250_ReadAll(acc, &temp, gyro, mag_out, &mag_status) == MPU9250_I2C_ERR);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestAccGyro();
+    TestReadAll();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
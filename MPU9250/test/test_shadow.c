@@ -0,0 +1,161 @@
+/*
+ * @brief Host tests of the shadow register cache.
+ *
+ * Start-up, configuration, auxiliary bus writes and magnetometer mode
+ * changes on the fake device, counting the bus accesses that the shadow
+ * copy saves.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250_Fake.h"
+#include "MPU9250.h"
+#include "MPU9250_RegMap.h"
+#include "MPU9250_Shadow.h"
+#include "MPU9250_Aux.h"
+#include "MPU9250_Bus.h"
+
+/* ========= STATIC FUNCTIONS ========= */
+static uint32_t Reads(void) {
+    MPU9250_Fake_Counters counters;
+    MPU9250_Fake_GetCounters(&counters);
+    return counters.reads;
+}
+
+static void TestStart(void) {
+    uint16_t adj[3];
+    uint8_t who_am_i;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_ReadWhoAmI(&who_am_i) == MPU9250_OK);
+    MPU9250_TEST_CHECK(who_am_i == MPU9250_WHO_AM_I);
+
+    // Sensitivity adjustment of 1.0 (ASA = 128), in Q15
+    MPU9250_Mag_GetAdjustment(adj);
+    MPU9250_TEST_CHECK(adj[0] == 32768 && adj[1] == 32768 && adj[2] == 32768);
+
+    // The magnetometer is left powered down
+    MPU9250_TEST_CHECK((MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] & 0x0F) == 0);
+}
+
+static void TestCachedConfig(void) {
+    MPU9250_Config config;
+    MPU9250_Acc_FS fs;
+    uint8_t transactions;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+
+    // Getters of written registers do not access the bus
+    uint32_t reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_GetAccFS(&fs) == MPU9250_OK);
+    MPU9250_TEST_CHECK(fs == MPU9250_Acc_FS_2g);
+    MPU9250_TEST_CHECK(Reads() == reads);
+
+    // The configuration applied by MPU9250_Start is not written again
+    MPU9250_GetDefaultConfig(&config);
+    MPU9250_TEST_CHECK(MPU9250_ApplyConfig(&config, &transactions) == MPU9250_OK);
+    MPU9250_TEST_CHECK(transactions == 0);
+
+    // A changed block is written with a single burst
+    config.acc_fs = MPU9250_Acc_FS_8g;
+    MPU9250_TEST_CHECK(MPU9250_ApplyConfig(&config, &transactions) == MPU9250_OK);
+    MPU9250_TEST_CHECK(transactions == 1);
+    MPU9250_TEST_CHECK(MPU9250_GetAccFS(&fs) == MPU9250_OK);
+    MPU9250_TEST_CHECK(fs == MPU9250_Acc_FS_8g);
+
+    // A reset invalidates the shadow copy
+    MPU9250_TEST_CHECK(MPU9250_Reset() == MPU9250_OK);
+    reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_GetAccFS(&fs) == MPU9250_OK);
+    MPU9250_TEST_CHECK(fs == MPU9250_Acc_FS_2g);
+    MPU9250_TEST_CHECK(Reads() == reads + 1);
+}
+
+static void TestUncached(void) {
+    uint8_t value;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_Bus_Start();
+
+    // I2C_SLV4_CTRL changes on its own: always read from the bus
+    uint32_t reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_CTRL_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_I2C_SLV4_CTRL_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(Reads() == reads + 2);
+
+    // A failed write forgets the register
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, 9) == MPU9250_OK);
+    MPU9250_Fake_Fail(0, 1, MPU9250_FAKE_FAULT_ARB_LOST);
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Write(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, 19) == MPU9250_I2C_ERR);
+    reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(MPU9250_I2C_ADDRESS, MPU9250_SMPLRT_DIV_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == 9);
+    MPU9250_TEST_CHECK(Reads() == reads + 1);
+}
+
+static void TestSlave4(void) {
+    uint8_t value;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Aux_Start() == MPU9250_OK);
+
+    // A write through slave 4 updates the shadow copy of the AK8963
+    MPU9250_TEST_CHECK(MPU9250_Aux_WriteByte(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, 0x16) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] == 0x16);
+    uint32_t reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == 0x16);
+    MPU9250_TEST_CHECK(Reads() == reads);
+
+    // Read back through slave 4
+    MPU9250_TEST_CHECK(MPU9250_Aux_ReadByte(AK8963_I2C_ADDRESS, 0x00, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == 0x48);
+
+    // A missing device is reported, without waiting for the timeout
+    uint32_t time_us = MPU9250_Fake_GetTimeUs();
+    MPU9250_TEST_CHECK(MPU9250_Aux_WriteByte(0x1E, 0x00, 0x00) == MPU9250_DEV_NOT_FOUND_ERR);
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetTimeUs() - time_us <= 2000);
+}
+
+static void TestMirrorMode(void) {
+    uint8_t value;
+
+    MPU9250_Fake_PowerOn();
+    MPU9250_TEST_CHECK(MPU9250_Start() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Mag_SetMode(MPU9250_Mag_Mode_Cont_8Hz) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] == 0x12);
+
+    // Slave 4 changes the mode through power down mode, as the bus does
+    MPU9250_TEST_CHECK(MPU9250_Mag_StartMirror() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] == 0x16);
+    uint32_t reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == 0x16 && Reads() == reads);
+
+    // Power down, then continuous mode again, from the bus
+    MPU9250_TEST_CHECK(MPU9250_Mag_StopMirror() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] == 0x00);
+    reads = Reads();
+    MPU9250_TEST_CHECK(MPU9250_Shadow_Read(AK8963_I2C_ADDRESS, MPU9250_MAG_CNTL1_REG, &value) == MPU9250_OK);
+    MPU9250_TEST_CHECK(value == 0x00 && Reads() == reads);
+    MPU9250_TEST_CHECK(MPU9250_EnableI2CBypass() == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Mag_SetMode(MPU9250_Mag_Mode_Cont_100Hz) == MPU9250_OK);
+    MPU9250_TEST_CHECK(MPU9250_Fake_Regs(AK8963_I2C_ADDRESS)[MPU9250_MAG_CNTL1_REG] == 0x16);
+    MPU9250_TEST_CHECK(MPU9250_Fake_GetMagModeErrors() == 0);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestStart();
+    TestCachedConfig();
+    TestUncached();
+    TestSlave4();
+    TestMirrorMode();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */
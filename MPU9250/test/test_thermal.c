@@ -0,0 +1,74 @@
+/*
+ * @brief Host tests of thermal bias compensation.
+ *
+ * Interpolation of the bias table, including the steepest segments that
+ * the 16-bit raw values allow.
+ *
+ * @date October 16, 2026
+ * @author Davide Marzorati
+ */
+
+#include "MPU9250_Test.h"
+#include "MPU9250.h"
+#include "MPU9250_Thermal.h"
+
+/* ========= STATIC FUNCTIONS ========= */
+static void TestInterpolation(void) {
+    const MPU9250_Thermal_Point table[2] = {
+        {-1000, {0, 10, -10}, {100, 0, 0}},
+        { 1000, {200, 10, 10}, {-100, 0, 0}}
+    };
+    int16_t acc[3];
+    int16_t gyro[3];
+
+    MPU9250_TEST_CHECK(MPU9250_Thermal_SetTable(table, 2) == MPU9250_OK);
+    MPU9250_Thermal_GetBias(0, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == 100 && acc[1] == 10 && acc[2] == 0);
+    MPU9250_TEST_CHECK(gyro[0] == 0);
+
+    // Clamped to the first and last point
+    MPU9250_Thermal_GetBias(-5000, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == 0 && gyro[0] == 100);
+    MPU9250_Thermal_GetBias(5000, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == 200 && gyro[0] == -100);
+}
+
+static void TestSteepSegments(void) {
+    // Full range bias change over one and two LSB of temperature
+    const MPU9250_Thermal_Point table[4] = {
+        {0, {INT16_MIN, INT16_MAX, 0}, {0, 0, 0}},
+        {1, {INT16_MAX, INT16_MIN, 0}, {0, 0, 0}},
+        {3, {INT16_MIN, INT16_MAX, 0}, {0, 0, 0}},
+        {4, {0, 0, 0}, {0, 0, 0}}
+    };
+    int16_t acc[3];
+    int16_t gyro[3];
+
+    MPU9250_TEST_CHECK(MPU9250_Thermal_SetTable(table, 4) == MPU9250_OK);
+    MPU9250_Thermal_GetBias(0, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == INT16_MIN && acc[1] == INT16_MAX);
+    MPU9250_Thermal_GetBias(1, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == INT16_MAX && acc[1] == INT16_MIN);
+    MPU9250_Thermal_GetBias(2, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == 0 && acc[1] == 0);
+    MPU9250_Thermal_GetBias(3, acc, gyro);
+    MPU9250_TEST_CHECK(acc[0] == INT16_MIN && acc[1] == INT16_MAX);
+}
+
+static void TestInvalidTable(void) {
+    const MPU9250_Thermal_Point table[2] = {
+        {1000, {0, 0, 0}, {0, 0, 0}},
+        {1000, {0, 0, 0}, {0, 0, 0}}
+    };
+
+    MPU9250_TEST_CHECK(MPU9250_Thermal_SetTable(table, 2) == MPU9250_UNKNOWN_ERR);
+}
+
+/* ========= MAIN ========= */
+int main(void) {
+    TestInterpolation();
+    TestSteepSegments();
+    TestInvalidTable();
+    return MPU9250_TEST_RESULT();
+}
+/* [] END OF FILE */